@@ -0,0 +1,37 @@
+#!/usr/bin/cmake -P
+
+# CompareStateHash.cmake
+#
+# Plays a demo back twice, once as is and once with extra options, and
+# fails if the game states at the end of the demo differ, as printed by
+# -statehash. Run as:
+#
+#   cmake -DPROGRAM=<executable> -DDEMO=<demo> -DOPTIONS=<options>
+#         -P CompareStateHash.cmake
+
+function(play_demo OUTPUT)
+    execute_process(
+        COMMAND "${PROGRAM}" -timedemo "${DEMO}" -nogui -nosound -statehash ${ARGN}
+        OUTPUT_VARIABLE Output
+        ERROR_VARIABLE Output
+    )
+    # "state hash 0123abcd at gametic 1234", or the same in Russian.
+    string(REGEX MATCH "[0-9a-f]+ [^ ]+ gametic [0-9]+" Hash "${Output}")
+    if(NOT Hash)
+        string(REPLACE ";" " " Args "${ARGN}")
+        message(FATAL_ERROR "No state hash printed with '${Args}':\n${Output}")
+    endif()
+    set(${OUTPUT} "${Hash}" PARENT_SCOPE)
+endfunction()
+
+separate_arguments(Options UNIX_COMMAND "${OPTIONS}")
+
+play_demo(Reference)
+play_demo(Compared ${Options})
+
+message("Reference: ${Reference}")
+message("With ${OPTIONS}: ${Compared}")
+
+if(NOT Reference STREQUAL Compared)
+    message(FATAL_ERROR "State hashes differ.")
+endif()
@@ -23,6 +23,7 @@
 #include "i_system.h"
 #include "st_bar.h"
 #include "p_local.h"
+#include "m_bbox.h"
 #include "m_misc.h"
 #include "v_video.h"
 #include "doomstat.h"
@@ -255,6 +256,34 @@ static void AM_rotatePoint (mpoint_t *pt);
 static mpoint_t mapcenter;
 static angle_t mapangle;
 
+// [JN] Angle used by AM_rotatePoint(). Keep the map static in
+// overlay mode if not following the player.
+static inline angle_t AM_rotateAngle (void)
+{
+    return (!(!automap_follow && automap_overlay)) ? ANG90 - viewangle : mapangle;
+}
+
+// [JN] Automap line grid. Linedefs are bucketed into blockmap-sized
+// cells once per level, so that AM_drawWalls() only visits the lines
+// near the visible window instead of every line of the map.
+static int      *am_gridcells;   // bmapwidth*bmapheight+1 offsets
+static int      *am_gridlines;   // line numbers, grouped by cell
+static uint32_t *am_linemask;    // one bit per line while gathering
+static int      *am_drawlines;   // visible lines, in line number order
+static int       am_numdrawlines;
+
+// [JN] Block range covered by the visible window, computed once per frame.
+static int     am_visblocks[4];
+static boolean am_allvisible;
+
+// [JN] Rotated vertices, reused while the rotation center and angle
+// stay the same and shared by all lines touching the vertex.
+static mpoint_t *am_rotverts;
+static int      *am_rotstamp;
+static int       am_rotframe;
+static mpoint_t  am_rotcenter;
+static angle_t   am_rotangle;
+
 // -----------------------------------------------------------------------------
 // AM_activateNewScale
 // Changes the map scale after zooming or translating.
@@ -1538,6 +1567,232 @@ static void AM_drawGrid (const int color)
     }
 }
 
+// -----------------------------------------------------------------------------
+// AM_gridColumn, AM_gridRow
+// [JN] Blockmap cell of a fixed point coordinate, clamped to the blockmap,
+// so that lines and sectors outside of it land in the border cells.
+// -----------------------------------------------------------------------------
+
+static int AM_gridColumn (const int64_t x)
+{
+    const int64_t col = (x - bmaporgx) >> MAPBLOCKSHIFT;
+
+    return col < 0 ? 0 : col >= bmapwidth ? bmapwidth - 1 : (int) col;
+}
+
+static int AM_gridRow (const int64_t y)
+{
+    const int64_t row = (y - bmaporgy) >> MAPBLOCKSHIFT;
+
+    return row < 0 ? 0 : row >= bmapheight ? bmapheight - 1 : (int) row;
+}
+
+// -----------------------------------------------------------------------------
+// AM_initLineGrid
+// [JN] Buckets every linedef into the cells touched by its bounding box.
+// Allocated as PU_LEVEL, so the grid is rebuilt after each level change.
+// -----------------------------------------------------------------------------
+
+static void AM_initLineGrid (void)
+{
+    const int numcells = bmapwidth * bmapheight;
+    int i, x, y;
+
+    am_gridcells = Z_Malloc((numcells + 1) * sizeof(*am_gridcells),
+                            PU_LEVEL, (void **) &am_gridcells);
+    memset(am_gridcells, 0, (numcells + 1) * sizeof(*am_gridcells));
+
+    // Count the lines of each cell, one slot ahead...
+    for (i = 0 ; i < numlines ; i++)
+    {
+        const int xl = AM_gridColumn(lines[i].bbox[BOXLEFT]);
+        const int xh = AM_gridColumn(lines[i].bbox[BOXRIGHT]);
+        const int yl = AM_gridRow(lines[i].bbox[BOXBOTTOM]);
+        const int yh = AM_gridRow(lines[i].bbox[BOXTOP]);
+
+        for (y = yl ; y <= yh ; y++)
+        {
+            for (x = xl ; x <= xh ; x++)
+            {
+                am_gridcells[y * bmapwidth + x + 1]++;
+            }
+        }
+    }
+
+    // ...turn the counts into start offsets...
+    for (i = 0 ; i < numcells ; i++)
+    {
+        am_gridcells[i + 1] += am_gridcells[i];
+    }
+
+    am_gridlines = Z_Malloc((am_gridcells[numcells] + 1) * sizeof(*am_gridlines),
+                            PU_LEVEL, (void **) &am_gridlines);
+
+    // ...and fill the cells in line number order. Filling advances
+    // each offset to the start of the next cell, so shift them back.
+    for (i = 0 ; i < numlines ; i++)
+    {
+        const int xl = AM_gridColumn(lines[i].bbox[BOXLEFT]);
+        const int xh = AM_gridColumn(lines[i].bbox[BOXRIGHT]);
+        const int yl = AM_gridRow(lines[i].bbox[BOXBOTTOM]);
+        const int yh = AM_gridRow(lines[i].bbox[BOXTOP]);
+
+        for (y = yl ; y <= yh ; y++)
+        {
+            for (x = xl ; x <= xh ; x++)
+            {
+                am_gridlines[am_gridcells[y * bmapwidth + x]++] = i;
+            }
+        }
+    }
+
+    for (i = numcells ; i > 0 ; i--)
+    {
+        am_gridcells[i] = am_gridcells[i - 1];
+    }
+    am_gridcells[0] = 0;
+
+    am_linemask = Z_Malloc(((numlines + 31) / 32) * sizeof(*am_linemask),
+                           PU_LEVEL, (void **) &am_linemask);
+    memset(am_linemask, 0, ((numlines + 31) / 32) * sizeof(*am_linemask));
+
+    am_drawlines = Z_Malloc((numlines + 1) * sizeof(*am_drawlines),
+                            PU_LEVEL, (void **) &am_drawlines);
+
+    am_rotverts = Z_Malloc((numvertexes + 1) * sizeof(*am_rotverts),
+                           PU_LEVEL, (void **) &am_rotverts);
+    am_rotstamp = Z_Malloc((numvertexes + 1) * sizeof(*am_rotstamp),
+                           PU_LEVEL, (void **) &am_rotstamp);
+    memset(am_rotstamp, 0, (numvertexes + 1) * sizeof(*am_rotstamp));
+    am_rotframe = 0;
+}
+
+// -----------------------------------------------------------------------------
+// AM_setVisibleBlocks
+// [JN] Finds the blockmap cells under the visible window. In rotate mode,
+// the window is turned back around the map center and its bounding box
+// is used. Must be called after mapcenter and mapangle are updated.
+// -----------------------------------------------------------------------------
+
+#define AM_GRIDMARGIN 8 // [JN] Map units, covers rounding in rotation.
+
+static void AM_setVisibleBlocks (void)
+{
+    const int64_t cx = m_x + m_w / 2;
+    const int64_t cy = m_y + m_h / 2;
+    int64_t hw = m_w / 2;
+    int64_t hh = m_h / 2;
+
+    if (automap_rotate)
+    {
+        const angle_t a = AM_rotateAngle() >> ANGLETOFINESHIFT;
+        const int64_t c = abs(finecosine[a]);
+        const int64_t s = abs(finesine[a]);
+        const int64_t rw = (hw * c + hh * s) >> FRACBITS;
+        const int64_t rh = (hw * s + hh * c) >> FRACBITS;
+
+        hw = rw;
+        hh = rh;
+    }
+
+    hw += AM_GRIDMARGIN;
+    hh += AM_GRIDMARGIN;
+
+    am_visblocks[BOXLEFT]   = AM_gridColumn((cx - hw) * (1 << FRACTOMAPBITS));
+    am_visblocks[BOXRIGHT]  = AM_gridColumn((cx + hw) * (1 << FRACTOMAPBITS));
+    am_visblocks[BOXBOTTOM] = AM_gridRow((cy - hh) * (1 << FRACTOMAPBITS));
+    am_visblocks[BOXTOP]    = AM_gridRow((cy + hh) * (1 << FRACTOMAPBITS));
+
+    am_allvisible = am_visblocks[BOXLEFT] == 0
+                 && am_visblocks[BOXBOTTOM] == 0
+                 && am_visblocks[BOXRIGHT] == bmapwidth - 1
+                 && am_visblocks[BOXTOP] == bmapheight - 1;
+}
+
+// -----------------------------------------------------------------------------
+// AM_gatherLines
+// [JN] Collects the lines of the visible cells into am_drawlines.
+// Lines are marked in a bit mask, then read back in line number order,
+// so they are drawn in the same order as walking all the lines would.
+// -----------------------------------------------------------------------------
+
+static void AM_gatherLines (void)
+{
+    int x, y, i, w;
+    int minword = INT_MAX;
+    int maxword = -1;
+
+    am_numdrawlines = 0;
+
+    if (am_allvisible)
+    {
+        for (i = 0 ; i < numlines ; i++)
+        {
+            am_drawlines[am_numdrawlines++] = i;
+        }
+        return;
+    }
+
+    for (y = am_visblocks[BOXBOTTOM] ; y <= am_visblocks[BOXTOP] ; y++)
+    {
+        for (x = am_visblocks[BOXLEFT] ; x <= am_visblocks[BOXRIGHT] ; x++)
+        {
+            const int cell = y * bmapwidth + x;
+
+            for (i = am_gridcells[cell] ; i < am_gridcells[cell + 1] ; i++)
+            {
+                const int line = am_gridlines[i];
+
+                w = line >> 5;
+                am_linemask[w] |= 1u << (line & 31);
+                minword = MIN(minword, w);
+                maxword = MAX(maxword, w);
+            }
+        }
+    }
+
+    for (w = minword ; w <= maxword ; w++)
+    {
+        uint32_t bits = am_linemask[w];
+
+        if (!bits)
+        {
+            continue;
+        }
+
+        am_linemask[w] = 0;
+
+        for (i = w << 5 ; bits ; i++, bits >>= 1)
+        {
+            if (bits & 1)
+            {
+                am_drawlines[am_numdrawlines++] = i;
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// AM_rotateVertex
+// [JN] Returns the rotated map point of a vertex, rotating it only once
+// for as long as the rotation center and angle don't change.
+// -----------------------------------------------------------------------------
+
+static void AM_rotateVertex (const vertex_t *v, mpoint_t *pt)
+{
+    const int n = v - vertexes;
+
+    if (am_rotstamp[n] != am_rotframe)
+    {
+        am_rotstamp[n] = am_rotframe;
+        am_rotverts[n].x = v->x >> FRACTOMAPBITS;
+        am_rotverts[n].y = v->y >> FRACTOMAPBITS;
+        AM_rotatePoint(&am_rotverts[n]);
+    }
+
+    *pt = am_rotverts[n];
+}
+
 // -----------------------------------------------------------------------------
 // AM_drawWalls
 // Determines visible lines, draws them. 
@@ -1546,20 +1801,40 @@ static void AM_drawGrid (const int color)
 
 static void AM_drawWalls (const int automap_color_set)
 {
-    int    i;
+    int    i, n;
     static mline_t l;
 
-    for (i = 0 ; i < numlines ; i++)
+    if (automap_rotate)
+    {
+        const angle_t angle = AM_rotateAngle();
+
+        // [JN] Invalidate rotated vertices once the view has changed.
+        if (am_rotframe == 0 || angle != am_rotangle
+        ||  mapcenter.x != am_rotcenter.x || mapcenter.y != am_rotcenter.y)
+        {
+            am_rotframe++;
+            am_rotangle = angle;
+            am_rotcenter = mapcenter;
+        }
+    }
+
+    AM_gatherLines();
+
+    for (n = 0 ; n < am_numdrawlines ; n++)
     {
-        l.a.x = lines[i].v1->x >> FRACTOMAPBITS;
-        l.a.y = lines[i].v1->y >> FRACTOMAPBITS;
-        l.b.x = lines[i].v2->x >> FRACTOMAPBITS;
-        l.b.y = lines[i].v2->y >> FRACTOMAPBITS;
+        i = am_drawlines[n];
 
         if (automap_rotate)
         {
-            AM_rotatePoint(&l.a);
-            AM_rotatePoint(&l.b);
+            AM_rotateVertex(lines[i].v1, &l.a);
+            AM_rotateVertex(lines[i].v2, &l.b);
+        }
+        else
+        {
+            l.a.x = lines[i].v1->x >> FRACTOMAPBITS;
+            l.a.y = lines[i].v1->y >> FRACTOMAPBITS;
+            l.b.x = lines[i].v2->x >> FRACTOMAPBITS;
+            l.b.y = lines[i].v2->y >> FRACTOMAPBITS;
         }
 
         switch (automap_color_set)
@@ -2095,8 +2370,7 @@ static void AM_rotate (int64_t *x, int64_t *y, angle_t a)
 static void AM_rotatePoint (mpoint_t *pt)
 {
     int64_t tmpx;
-    const angle_t actualangle = ((!(!automap_follow && automap_overlay)) ?
-                                 ANG90 - viewangle : mapangle) >> ANGLETOFINESHIFT;
+    const angle_t actualangle = AM_rotateAngle() >> ANGLETOFINESHIFT;
 
     pt->x -= mapcenter.x;
     pt->y -= mapcenter.y;
@@ -2292,6 +2566,17 @@ static void AM_drawThings (const int colors, const int colorrange)
 
     for (i = 0 ; i < numsectors ; i++)
     {
+        // [JN] Skip sectors away from the visible window. The sector
+        // block box already has MAXRADIUS margin, extra blocks cover
+        // thing radius and interpolated movement.
+        if (sectors[i].blockbox[BOXLEFT]   > am_visblocks[BOXRIGHT] + 2
+        ||  sectors[i].blockbox[BOXRIGHT]  < am_visblocks[BOXLEFT] - 2
+        ||  sectors[i].blockbox[BOXBOTTOM] > am_visblocks[BOXTOP] + 2
+        ||  sectors[i].blockbox[BOXTOP]    < am_visblocks[BOXBOTTOM] - 2)
+        {
+            continue;
+        }
+
         t = sectors[i].thinglist;
         while (t)
         {
@@ -2501,6 +2786,13 @@ void AM_Drawer (void)
         }
     }
 
+    // [JN] Build the line grid for a new level, find visible cells.
+    if (am_gridcells == NULL)
+    {
+        AM_initLineGrid();
+    }
+    AM_setVisibleBlocks();
+
     if (!automap_overlay)
     {
         AM_clearFB(BACKGROUND);
@@ -593,6 +593,49 @@ static void DrawTimeAndFPS (void)
                 sprintf (digit, "%9d", rendered_vissprites);
                 RD_M_DrawTextC("SPRITES", 286 + (wide_4_3 ? wide_delta : wide_delta*2), 68);
                 RD_M_DrawTextC(digit, 278 + (wide_4_3 ? wide_delta : wide_delta*2), 75);
+
+                // [JN] BSP subtrees skipped by the PVS.
+                if (pvs_active)
+                {
+                    sprintf (digit, "%9d", rendered_pvsculled);
+                    RD_M_DrawTextC("PVS CULLED", 274 + (wide_4_3 ? wide_delta : wide_delta*2), 84);
+                    RD_M_DrawTextC(digit, 278 + (wide_4_3 ? wide_delta : wide_delta*2), 91);
+                }
+            }
+
+            // [JN] Draw all renderer counters and stage timings.
+            if (show_fps == 3 && gamestate == GS_LEVEL)
+            {
+                const int x = 4 + (wide_4_3 ? wide_delta : 0);
+                int y = 27;
+
+                sprintf (digit, "SEGS %d", rendered_segs);
+                RD_M_DrawTextC(digit, x, y += 9);
+                sprintf (digit, "DRAWSEGS %d", rendered_drawsegs);
+                RD_M_DrawTextC(digit, x, y += 9);
+                sprintf (digit, "VISPLANES %d", rendered_visplanes);
+                RD_M_DrawTextC(digit, x, y += 9);
+                sprintf (digit, "SPRITES %d", rendered_vissprites);
+                RD_M_DrawTextC(digit, x, y += 9);
+                if (pvs_active)
+                {
+                    sprintf (digit, "PVS CULLED %d", rendered_pvsculled);
+                    RD_M_DrawTextC(digit, x, y += 9);
+                }
+                sprintf (digit, "WALL PIXELS %d", rendered_colpixels);
+                RD_M_DrawTextC(digit, x, y += 9);
+                sprintf (digit, "FLAT PIXELS %d", rendered_spanpixels);
+                RD_M_DrawTextC(digit, x, y += 9);
+                sprintf (digit, "MASKED PIXELS %d", rendered_maskedpixels);
+                RD_M_DrawTextC(digit, x, y += 9);
+                sprintf (digit, "BSP %.2f MS", rendered_stagetime[RSTAGE_BSP] / 1000.0);
+                RD_M_DrawTextC(digit, x, y += 9);
+                sprintf (digit, "PLANES %.2f MS", rendered_stagetime[RSTAGE_PLANES] / 1000.0);
+                RD_M_DrawTextC(digit, x, y += 9);
+                sprintf (digit, "MASKED %.2f MS", rendered_stagetime[RSTAGE_MASKED] / 1000.0);
+                RD_M_DrawTextC(digit, x, y += 9);
+                sprintf (digit, "TOTAL %.2f MS", rendered_stagetime[RSTAGE_TOTAL] / 1000.0);
+                RD_M_DrawTextC(digit, x, y += 9);
             }
         }
     }
@@ -485,6 +485,7 @@ typedef struct mobj_s
     // Links in blocks (if needed).
     struct mobj_s      *bnext;
     struct mobj_s      *bprev;
+    int                 bcell, bslot;  // [JN] Place in blockthings, see p_maputl.c.
     struct subsector_s *subsector;
 
     // The closest interval over all contacted Sectors.
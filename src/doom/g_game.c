@@ -2932,6 +2932,21 @@ boolean G_CheckDemoStatus (void)
 { 
     int endtime; 
 
+    //!
+    // @category demo
+    //
+    // Print a hash of the game state when a demo ends, to make sure
+    // it plays back the same way with different options.
+    //
+
+    if (demoplayback && M_ParmExists("-statehash"))
+    {
+        printf(english_language ?
+               "G_CheckDemoStatus: %s: state hash %08x at gametic %d.\n" :
+               "G_CheckDemoStatus: %s: хэш состояния %08x на gametic %d.\n",
+               defdemoname, P_StateHash(), gametic);
+    }
+
     if (timingdemo) 
     { 
         float fps;
@@ -1723,7 +1723,8 @@ static void M_RD_Draw_Rendering_1 (void)
 
         // Performance counter
         RD_M_DrawTextSmallENG(show_fps == 1 ? "FPS only" :
-                              show_fps == 2 ? "Full" : "off", 
+                              show_fps == 2 ? "Full" :
+                              show_fps == 3 ? "Renderer" : "off", 
                               192 + wide_delta, 85, CR_NONE);
 
         // Pixel scaling
@@ -1821,7 +1822,8 @@ static void M_RD_Draw_Rendering_1 (void)
 
         // Счетчик производительности
         RD_M_DrawTextSmallRUS(show_fps == 1 ? "" : // Print as US string below
-                              show_fps == 2 ? "gjkysq" : "dsrk",
+                              show_fps == 2 ? "gjkysq" :
+                              show_fps == 3 ? "htylth" : "dsrk",
                               246 + wide_delta, 85, CR_NONE);
         // Print "FPS" separately, RU sting doesn't fit in 4:3 aspect ratio :(
         if (show_fps == 1) RD_M_DrawTextSmallENG("fps", 246 + wide_delta, 85, CR_NONE);
@@ -2058,7 +2060,7 @@ static void M_RD_Change_MaxFPS(Direction_t direction)
 
 static void M_RD_Change_PerfCounter(Direction_t direction)
 {
-    RD_Menu_SpinInt(&show_fps, 0, 2, direction);
+    RD_Menu_SpinInt(&show_fps, 0, 3, direction);
 }
 
 static void M_RD_Change_Smoothing()
@@ -23,6 +23,9 @@
 #include "doomtype.h"
 
 
+// Index of the play simulation in the table.
+extern int prndindex;
+
 // Returns a number from 0 to 255, from a lookup table.
 const int M_Random (void);
 
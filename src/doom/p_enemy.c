@@ -91,75 +91,139 @@ void A_SpawnFly (mobj_t *mo);
 // =============================================================================
 
 // -----------------------------------------------------------------------------
-// Called by P_NoiseAlert.
-// Recursively traverse adjacent sectors, sound blocking lines cut off traversal.
+// P_InitSoundGraph
+// [JN] Sound travels only through two-sided lines, which never change,
+// so every sector's neighbours are gathered once at level load. Only
+// the openings depend on the sector heights and are checked on flood.
+// Must be called again whenever line flags change.
 // -----------------------------------------------------------------------------
 
-static void P_RecursiveSound (sector_t *sec, int soundblocks)
+typedef struct
 {
-    line_t   *check;
     sector_t *other;
+    boolean   block;  // ML_SOUNDBLOCK
+} soundedge_t;
 
-    // wake up all monsters in this sector
-    if (sec->validcount == validcount
-    && sec->soundtraversed <= soundblocks+1)
+static soundedge_t *soundedges;
+static int         *soundedgestart;  // numsectors + 1 offsets.
+static int         *soundqueue;
+
+void P_InitSoundGraph (void)
+{
+    int i, j, n;
+
+    for (i = 0, n = 0 ; i < numsectors ; i++)
     {
-        return;  // already flooded
+        n += sectors[i].linecount;
     }
 
-    sec->validcount = validcount;
-    sec->soundtraversed = soundblocks+1;
-    sec->soundtarget = soundtarget;
+    soundedges = I_Realloc(soundedges, n * sizeof(*soundedges));
+    soundedgestart = I_Realloc(soundedgestart, (numsectors + 1) * sizeof(*soundedgestart));
+    soundqueue = I_Realloc(soundqueue, numsectors * sizeof(*soundqueue));
 
-    for (int i=0 ;i<sec->linecount ; i++)
+    for (i = 0, n = 0 ; i < numsectors ; i++)
     {
-        check = sec->lines[i];
+        const sector_t *sec = &sectors[i];
+
+        soundedgestart[i] = n;
 
-        if (!(check->flags & ML_TWOSIDED))
+        for (j = 0 ; j < sec->linecount ; j++)
         {
-            continue;
-        }
+            const line_t *check = sec->lines[j];
 
-        P_LineOpening (check);
+            // Single sided lines are closed for good.
+            if (!(check->flags & ML_TWOSIDED) || check->sidenum[1] == NO_INDEX)
+            {
+                continue;
+            }
 
-        if (openrange <= 0)
-        {
-            continue;  // closed door
-        }
+            if (sides[check->sidenum[0]].sector == sec)
+            {
+                soundedges[n].other = sides[check->sidenum[1]].sector;
+            }
+            else
+            {
+                soundedges[n].other = sides[check->sidenum[0]].sector;
+            }
 
-        if (sides[check->sidenum[0]].sector == sec)
-        {
-            other = sides[check->sidenum[1]] .sector;
-        }
-        else
-        {
-            other = sides[check->sidenum[0]].sector;
+            soundedges[n].block = (check->flags & ML_SOUNDBLOCK) != 0;
+            n++;
         }
+    }
 
-        if (check->flags & ML_SOUNDBLOCK)
+    soundedgestart[numsectors] = n;
+}
+
+// -----------------------------------------------------------------------------
+// P_FloodSound
+// [JN] Called by P_NoiseAlert. Adds the sectors sound can reach from the
+// queued ones before "end", by the lines which are or aren't sound
+// blocking, and marks them with the given soundtraversed.
+// Returns the new end of the queue.
+// -----------------------------------------------------------------------------
+
+static int P_FloodSound (int head, const int end, int tail,
+                         const boolean block, const int traversed)
+{
+    while (head < tail && head < end)
+    {
+        const sector_t *sec = &sectors[soundqueue[head++]];
+        const soundedge_t *edge = &soundedges[soundedgestart[sec - sectors]];
+        const soundedge_t *edgeend = &soundedges[soundedgestart[sec - sectors + 1]];
+
+        for ( ; edge < edgeend ; edge++)
         {
-            if (!soundblocks)
+            sector_t *other = edge->other;
+
+            if (edge->block != block || other->validcount == validcount)
             {
-                P_RecursiveSound (other, 1);
+                continue;
             }
-        }
-        else
-        {
-            P_RecursiveSound (other, soundblocks);
+
+            // closed door
+            if (MIN(sec->ceilingheight, other->ceilingheight)
+              - MAX(sec->floorheight, other->floorheight) <= 0)
+            {
+                continue;
+            }
+
+            other->validcount = validcount;
+            other->soundtraversed = traversed;
+            other->soundtarget = soundtarget;
+            soundqueue[tail++] = other - sectors;
         }
     }
+
+    return tail;
 }
 
 // -----------------------------------------------------------------------------
 // P_NoiseAlert
 // If a monster yells at a player, it will alert other monsters to the player.
+// [JN] Floods the sectors breadth first instead of recursively. Sectors
+// reached without crossing sound blocking lines get soundtraversed 1,
+// the ones reached only through one of them get 2, as before.
 // -----------------------------------------------------------------------------
 
 void P_NoiseAlert (mobj_t *target, mobj_t *emmiter)
 {
+    sector_t *sec = emmiter->subsector->sector;
+    int       first, tail;
+
     soundtarget = target;
     validcount++;
-    P_RecursiveSound (emmiter->subsector->sector, 0);
+
+    sec->validcount = validcount;
+    sec->soundtraversed = 1;
+    sec->soundtarget = soundtarget;
+    soundqueue[0] = sec - sectors;
+
+    // Sectors sound reaches freely...
+    first = P_FloodSound(0, numsectors, 1, false, 1);
+
+    // ...then the ones behind a single sound blocking line.
+    tail = P_FloodSound(0, first, first, true, 2);
+    P_FloodSound(first, numsectors, tail, false, 2);
 }
 
 // -----------------------------------------------------------------------------
@@ -1231,6 +1295,7 @@ void A_SkelMissile (mobj_t *actor)
 
     mo->x += mo->momx;
     mo->y += mo->momy;
+    P_UpdateBlockThing(mo);  // [JN] moved without relinking
     mo->tracer = actor->target;
 }
 
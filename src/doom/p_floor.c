@@ -46,6 +46,9 @@ const result_e T_MovePlane (sector_t *sector, const fixed_t speed, fixed_t dest,
     sector->oldceilingheight = sector->ceilingheight;
     sector->oldgametic = gametic;
 
+    // [JN] Sight checks through this sector may change.
+    sightstamp++;
+
     switch (floorOrCeiling)
     {
         case 0:
@@ -141,6 +141,7 @@ void T_VerticalDoor (vldoor_t *door);
 // P_ENEMY
 // -----------------------------------------------------------------------------
 
+void P_InitSoundGraph (void);
 void P_NoiseAlert (mobj_t *target, mobj_t *emmiter);
 
 // -----------------------------------------------------------------------------
@@ -330,6 +331,7 @@ extern mobj_t  *linetarget;
 extern fixed_t  attackrange;
 
 boolean P_ChangeSector (sector_t *sector, boolean crunch);
+void P_InitChangeSector (void);
 boolean PIT_ChangeSector (mobj_t *thing);
 boolean PIT_RadiusAttack (mobj_t *thing);
 boolean PTR_NoWayAudible (line_t *line);
@@ -376,6 +378,14 @@ typedef struct
 
 typedef boolean (*traverser_t) (intercept_t *in);
 
+// [JN] A point and a thing whose radius around it is checked
+// by P_BlockThingsNearIterator. Pointers to the globals in use.
+typedef struct
+{
+    const fixed_t *x, *y;
+    mobj_t *const *thing;
+} blocknear_t;
+
 extern intercept_t *intercept_p;
 extern divline_t    trace;
 extern fixed_t      opentop;
@@ -386,6 +396,7 @@ extern fixed_t      lowfloor;
 boolean P_PathTraverse (fixed_t x1, fixed_t y1, fixed_t x2, fixed_t y2, int flags, boolean (*trav)(intercept_t *));
 const boolean P_BlockLinesIterator (const int x, const int y, boolean(*func)(line_t*));
 const boolean P_BlockThingsIterator (const int x, const int y, boolean(*func)(mobj_t*));
+const boolean P_BlockThingsNearIterator (const int x, const int y, boolean(*func)(mobj_t*), const blocknear_t *near);
 const int64_t P_ApproxDistanceZ (int64_t dx, int64_t dy, int64_t dz);
 const fixed_t P_AproxDistance (fixed_t dx, fixed_t dy);
 const fixed_t P_InterceptVector (const divline_t* v2, const divline_t* v1);
@@ -394,8 +405,10 @@ const int P_PointOnDivlineSide (fixed_t x, fixed_t y, const divline_t *line);
 const int P_PointOnLineSide (const fixed_t x, const fixed_t y, const line_t *line);
 void P_LineOpening (const line_t *linedef);
 void P_MakeDivline (line_t* li, divline_t* dl);
+void P_InitBlockThings (void);
 void P_SetThingPosition (mobj_t* thing);
-void P_UnsetThingPosition (const mobj_t* thing);
+void P_UnsetThingPosition (mobj_t* thing);
+void P_UpdateBlockThing (const mobj_t *thing);
 
 // -----------------------------------------------------------------------------
 // P_MOBJ
@@ -478,6 +491,12 @@ void P_AddActivePlat (plat_t *plat);
 void P_RemoveActivePlat (const plat_t *plat);
 void T_PlatRaise(plat_t *plat);
 
+// -----------------------------------------------------------------------------
+// P_PROF
+// -----------------------------------------------------------------------------
+
+void P_InitProfile (void);
+
 // -----------------------------------------------------------------------------
 // P_PSPR
 // -----------------------------------------------------------------------------
@@ -555,7 +574,12 @@ void P_SetupFixes (const int episode, const int map);
 // P_SIGHT
 // -----------------------------------------------------------------------------
 
+extern unsigned int sightstamp;
+
 const boolean P_CheckSight (const mobj_t *t1, const mobj_t *t2);
+void P_InitSightThreads (void);
+void P_PrefetchSight (void);
+void P_ReportSight (void);
 
 // -----------------------------------------------------------------------------
 // P_SPEC
@@ -572,6 +596,7 @@ const fixed_t P_FindLowestFloorSurrounding (const sector_t *sec);
 const fixed_t P_FindNextHighestFloor (const sector_t *sec, const int currentheight);
 const int P_FindMinSurroundingLight (const sector_t *sector, const int max);
 const int P_FindSectorFromLineTag (const line_t *line, const int start);
+void P_InitTagLists (void);
 const int twoSided (const int sector, const int line);
 int EV_DoDonut (line_t *line);
 sector_t *getNextSector (const line_t *line, const sector_t *sec);
@@ -643,6 +668,7 @@ void P_AddThinker (thinker_t *thinker);
 void P_InitThinkers (void);
 void P_RemoveThinker (thinker_t *thinker);
 void P_Ticker (void);
+unsigned int P_StateHash (void);
 
 // -----------------------------------------------------------------------------
 // P_USER
@@ -36,6 +36,10 @@ static mobj_t  *tmthing;
 static int      tmflags;
 static fixed_t	tmx, tmy;
 
+// [JN] PIT_CheckThing and PIT_StompThing skip things out of
+// tmthing's radius around tmx, tmy, so the iterators may too.
+static const blocknear_t tmnear = { &tmx, &tmy, &tmthing };
+
 // [JN] Rand Phares:
 static int pe_x, pe_y;     // Pain Elemental position for Lost Soul checks
 static int ls_x, ls_y;     // Lost Soul position for Lost Soul checks
@@ -153,7 +157,7 @@ const boolean P_TeleportMove (mobj_t *thing, const fixed_t x, const fixed_t y)
     {
         for (by = yl ; by <= yh ; by++)
         {
-            if (!P_BlockThingsIterator(bx, by, PIT_StompThing))
+            if (!P_BlockThingsNearIterator(bx, by, PIT_StompThing, &tmnear))
             {
                 return false;
             }
@@ -630,7 +634,7 @@ const boolean P_CheckPosition (mobj_t *thing, const fixed_t x, const fixed_t y)
     {
         for (by = yl ; by <= yh ; by++)
         {
-            if (!P_BlockThingsIterator(bx, by, PIT_CheckThing))
+            if (!P_BlockThingsNearIterator(bx, by, PIT_CheckThing, &tmnear))
             {
                 return false;
             }
@@ -1781,6 +1785,59 @@ void P_RadiusAttack (mobj_t *spot, mobj_t *source, int damage)
 
 static boolean		crushchange;
 static boolean		nofit;
+static boolean		changetouching;  // [JN] Skip things away from the sector.
+static boolean		changedemos;     // [JN] Even while playing back demos.
+
+// -----------------------------------------------------------------------------
+// P_ThingTouchesSector
+// [JN] True if P_CheckPosition takes the heights of the sector into account
+// for the thing: it is the sector of its center, or a side of a line its
+// box crosses. Things not touching the sector can't change with it.
+// -----------------------------------------------------------------------------
+
+static const boolean P_ThingTouchesSector (const mobj_t *thing, const sector_t *sector)
+{
+    fixed_t box[4];
+    int     i;
+
+    if (thing->subsector->sector == sector)
+    {
+        return true;
+    }
+
+    box[BOXTOP] = thing->y + thing->radius;
+    box[BOXBOTTOM] = thing->y - thing->radius;
+    box[BOXRIGHT] = thing->x + thing->radius;
+    box[BOXLEFT] = thing->x - thing->radius;
+
+    if (box[BOXRIGHT] < sector->bbox[BOXLEFT]
+    ||  box[BOXLEFT] > sector->bbox[BOXRIGHT]
+    ||  box[BOXTOP] < sector->bbox[BOXBOTTOM]
+    ||  box[BOXBOTTOM] > sector->bbox[BOXTOP])
+    {
+        return false;
+    }
+
+    for (i = 0 ; i < sector->linecount ; i++)
+    {
+        const line_t *ld = sector->lines[i];
+
+        if (box[BOXRIGHT] <= ld->bbox[BOXLEFT]
+        ||  box[BOXLEFT] >= ld->bbox[BOXRIGHT]
+        ||  box[BOXTOP] <= ld->bbox[BOXBOTTOM]
+        ||  box[BOXBOTTOM] >= ld->bbox[BOXTOP])
+        {
+            continue;
+        }
+
+        if (P_BoxOnLineSide(box, ld) == -1)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
 
 // -----------------------------------------------------------------------------
 // PIT_ChangeSector
@@ -1788,6 +1845,18 @@ static boolean		nofit;
 
 boolean PIT_ChangeSector (mobj_t *thing)
 {
+    // [JN] Leave alone the things away from the moving sector which fit
+    // in their cached heights, and can't hit or pick up anything while
+    // their position is checked again.
+    if (changetouching
+    && !(thing->flags & (MF_SKULLFLY | MF_MISSILE | MF_PICKUP))
+    &&  thing->ceilingz - thing->floorz >= thing->height
+    &&  thing->z + thing->height <= thing->ceilingz
+    && !P_ThingTouchesSector(thing, movingsector))
+    {
+        return true;
+    }
+
     if (P_ThingHeightClip (thing))
     {
         // keep checking
@@ -1815,6 +1884,7 @@ boolean PIT_ChangeSector (mobj_t *thing)
         }
         thing->height = 0;
         thing->radius = 0;
+        P_UpdateBlockThing(thing);
 
         // [JN] Play extra crushing sound (D*SLOP2):
         if (crushed_corpses_sfx && !vanillaparm)
@@ -1891,6 +1961,22 @@ boolean PIT_ChangeSector (mobj_t *thing)
     return true;	
 }
 
+// -----------------------------------------------------------------------------
+// P_InitChangeSector
+// -----------------------------------------------------------------------------
+
+void P_InitChangeSector (void)
+{
+    //!
+    // @category demo
+    //
+    // Skip things away from a moving sector while playing back demos too,
+    // as in single player. To compare both ways with -statehash.
+    //
+
+    changedemos = M_ParmExists("-crushtouching");
+}
+
 // -----------------------------------------------------------------------------
 // P_ChangeSector
 // -----------------------------------------------------------------------------
@@ -1903,6 +1989,15 @@ boolean P_ChangeSector (sector_t *sector, boolean crunch)
     crushchange = crunch;
     movingsector = sector;
 
+    // [JN] Skip the things away from the sector which can't be changed
+    // by it. Things with stale cached heights are not refreshed then, so
+    // this is kept out of demos and network games, unless -crushtouching
+    // asks for it to compare demo playback. Not with over/under either, as
+    // a thing standing on another one takes its heights from it rather
+    // than from the sectors.
+    changetouching = (singleplayer || (demoplayback && changedemos))
+                  && !strict_mode && !vanillaparm && !over_under;
+
     // re-check heights for all things near the moving sector
     for (x = sector->blockbox[BOXLEFT] ; x <= sector->blockbox[BOXRIGHT] ; x++)
     {
@@ -22,10 +22,12 @@
 //
 
 
+#include <string.h>
 #include "i_system.h"
 #include "m_bbox.h"
 #include "doomstat.h"
 #include "p_local.h"
+#include "z_zone.h"
 #include "jn.h"
 
 
@@ -222,6 +224,167 @@ void P_LineOpening (const line_t *linedef)
 }
 
 
+// =============================================================================
+//
+// BLOCKMAP THING INDEX
+//
+// [JN] Things of every blockmap cell are also kept in arrays, in the
+// order of the chains of blocklinks reversed, so the head of a chain is
+// the last one. Positions and radii are stored next to each other, so
+// the things which can't be touched are skipped in tight loops, without
+// following the links through scattered mobjs. Iterators fall back to
+// the links as soon as a cell changes while they are in it, so things
+// are visited exactly as by the chains alone.
+//
+// =============================================================================
+
+typedef struct
+{
+    mobj_t  **mobjs;
+    fixed_t  *x, *y, *radius;
+    int       count, max;
+    unsigned  stamp;  // Bumped on every change of the cell.
+} blockthings_t;
+
+static blockthings_t *blockthings;
+static fixed_t        blockmaxradius;  // Of the things indexed this level.
+
+// Once a chain is broken by a stale unlink, stale links may reach into
+// any other chain, so only the links can be followed until next level.
+static boolean blockunsynced;
+
+// -----------------------------------------------------------------------------
+// P_InitBlockThings
+// Called with the blocklinks of a new level.
+// -----------------------------------------------------------------------------
+
+void P_InitBlockThings (void)
+{
+    const int count = bmapwidth * bmapheight * sizeof(*blockthings);
+
+    blockthings = Z_Malloc(count, PU_LEVEL, 0);
+    memset(blockthings, 0, count);
+    blockunsynced = false;
+    blockmaxradius = 0;
+}
+
+// -----------------------------------------------------------------------------
+// P_BlockThingLinked
+// Returns the cell a thing is indexed in, or NULL.
+// -----------------------------------------------------------------------------
+
+static blockthings_t *P_BlockThingLinked (const mobj_t *thing)
+{
+    blockthings_t *bt;
+
+    if (thing->bcell < 0 || thing->bcell >= bmapwidth * bmapheight)
+    {
+        return NULL;
+    }
+
+    bt = &blockthings[thing->bcell];
+
+    if (thing->bslot < 0 || thing->bslot >= bt->count || bt->mobjs[thing->bslot] != thing)
+    {
+        return NULL;
+    }
+
+    return bt;
+}
+
+// -----------------------------------------------------------------------------
+// P_AddBlockThing, P_RemoveBlockThing
+// -----------------------------------------------------------------------------
+
+static void P_AddBlockThing (mobj_t *thing, const int cell)
+{
+    blockthings_t *bt = &blockthings[cell];
+    int i;
+
+    if (bt->count == bt->max)
+    {
+        const int max = bt->max ? bt->max * 2 : 8;
+        mobj_t **mobjs = Z_Malloc(max * (sizeof(*mobjs) + 3 * sizeof(fixed_t)), PU_LEVEL, 0);
+        fixed_t *x = (fixed_t *) (mobjs + max);
+
+        memcpy(mobjs, bt->mobjs, bt->count * sizeof(*mobjs));
+        memcpy(x, bt->x, bt->count * sizeof(*x));
+        memcpy(x + max, bt->y, bt->count * sizeof(*x));
+        memcpy(x + 2 * max, bt->radius, bt->count * sizeof(*x));
+
+        if (bt->mobjs)
+        {
+            Z_Free(bt->mobjs);
+        }
+
+        bt->mobjs = mobjs;
+        bt->x = x;
+        bt->y = x + max;
+        bt->radius = x + 2 * max;
+        bt->max = max;
+    }
+
+    i = bt->count++;
+    bt->mobjs[i] = thing;
+    bt->x[i] = thing->x;
+    bt->y[i] = thing->y;
+    bt->radius[i] = thing->radius;
+    bt->stamp++;
+    blockmaxradius = MAX(blockmaxradius, thing->radius);
+
+    thing->bcell = cell;
+    thing->bslot = i;
+}
+
+static void P_RemoveBlockThing (mobj_t *thing)
+{
+    blockthings_t *bt = P_BlockThingLinked(thing);
+    int i;
+
+    if (bt == NULL)
+    {
+        return;
+    }
+
+    // Keep the order of the others.
+    for (i = thing->bslot ; i < bt->count - 1 ; i++)
+    {
+        bt->mobjs[i] = bt->mobjs[i + 1];
+        bt->x[i] = bt->x[i + 1];
+        bt->y[i] = bt->y[i + 1];
+        bt->radius[i] = bt->radius[i + 1];
+        bt->mobjs[i]->bslot = i;
+    }
+
+    bt->count--;
+    bt->stamp++;
+
+    thing->bcell = -1;
+}
+
+// -----------------------------------------------------------------------------
+// P_UpdateBlockThing
+// Must be called whenever position or radius of a thing are changed
+// without unlinking it first. The thing stays in its cell, as it does
+// in the chains.
+// -----------------------------------------------------------------------------
+
+void P_UpdateBlockThing (const mobj_t *thing)
+{
+    blockthings_t *bt = P_BlockThingLinked(thing);
+
+    if (bt == NULL)
+    {
+        return;
+    }
+
+    bt->x[thing->bslot] = thing->x;
+    bt->y[thing->bslot] = thing->y;
+    bt->radius[thing->bslot] = thing->radius;
+    bt->stamp++;
+    blockmaxradius = MAX(blockmaxradius, thing->radius);
+}
+
 // =============================================================================
 //
 // THING POSITION SETTING
@@ -236,7 +399,7 @@ void P_LineOpening (const line_t *linedef)
 // these structures need to be updated.
 // -----------------------------------------------------------------------------
 
-void P_UnsetThingPosition (const mobj_t *thing)
+void P_UnsetThingPosition (mobj_t *thing)
 {
     if (!(thing->flags & MF_NOSECTOR))
     {
@@ -274,13 +437,24 @@ void P_UnsetThingPosition (const mobj_t *thing)
         {
             int blockx = (thing->x - bmaporgx) >> MAPBLOCKSHIFT;
             int blocky = (thing->y - bmaporgy) >> MAPBLOCKSHIFT;
+            int cell = -1;
 
             if (blockx >= 0 && blockx < bmapwidth 
             &&  blocky >= 0 && blocky < bmapheight)
             {
-                blocklinks[blocky*bmapwidth+blockx] = thing->bnext;
+                cell = blocky*bmapwidth+blockx;
+                blocklinks[cell] = thing->bnext;
+            }
+
+            // [JN] A thing moved without relinking unlinks itself from
+            // the wrong cell, leaving chains no array can follow.
+            if (cell != (P_BlockThingLinked(thing) ? thing->bcell : -1))
+            {
+                blockunsynced = true;
             }
         }
+
+        P_RemoveBlockThing(thing);
     }
 }
 
@@ -323,6 +497,12 @@ void P_SetThingPosition (mobj_t *thing)
         const int blockx = (thing->x - bmaporgx) >> MAPBLOCKSHIFT;
         const int blocky = (thing->y - bmaporgy) >> MAPBLOCKSHIFT;
 
+        // [JN] Linked twice, the chain of the old cell still has it.
+        if (P_BlockThingLinked(thing))
+        {
+            blockunsynced = true;
+        }
+
         if (blockx >= 0 && blockx < bmapwidth && blocky >= 0 && blocky < bmapheight)
         {
             mobj_t **link = &blocklinks[blocky*bmapwidth+blockx];
@@ -335,13 +515,20 @@ void P_SetThingPosition (mobj_t *thing)
             }
 
             *link = thing;
+
+            P_AddBlockThing(thing, blocky*bmapwidth+blockx);
         }
         else
         {
             // thing is off the map
             thing->bnext = thing->bprev = NULL;
+            thing->bcell = -1;
         }
     }
+    else
+    {
+        thing->bcell = -1;
+    }
 }
 
 
@@ -397,21 +584,104 @@ const boolean P_BlockLinesIterator (const int x, const int y, boolean(*func)(lin
 }
 
 // -----------------------------------------------------------------------------
-// P_BlockThingsIterator
+// P_BlockThingsCell
+// [JN] Calls func for the things of the cell (x+ox, y+oy), in the order of
+// its chain. For a neighbour cell, only for the things overlapping into
+// the cell (x, y). If "near" is given, things not touching it are skipped
+// too: func must reject them first thing, the way PIT_CheckThing does.
 // -----------------------------------------------------------------------------
 
-const boolean P_BlockThingsIterator (int x, int y, boolean (*func)(mobj_t*))
+static inline boolean P_BlockThingOverlaps (const fixed_t tx, const fixed_t ty, const fixed_t r,
+                                            const int x, const int y, const int ox, const int oy)
 {
-    mobj_t *mobj;
+    return (!ox || ((tx - ox * r - bmaporgx)>>MAPBLOCKSHIFT) == x)
+        && (!oy || ((ty - oy * r - bmaporgy)>>MAPBLOCKSHIFT) == y);
+}
 
-    if (x < 0 || y < 0 || x >= bmapwidth || y >= bmapheight)
+static boolean P_BlockThingsCell (const int x, const int y, const int ox, const int oy,
+                                  boolean (*func)(mobj_t*), const blocknear_t *near)
+{
+    const int      cell = (y+oy)*bmapwidth+(x+ox);
+    blockthings_t *bt = &blockthings[cell];
+    mobj_t        *mobj = blocklinks[cell];
+    int            i;
+
+    if (!blockunsynced)
     {
-        return true;
+        for (i = bt->count - 1 ; i >= 0 ; i--)
+        {
+            unsigned stamp;
+
+            if ((ox || oy) && !P_BlockThingOverlaps(bt->x[i], bt->y[i], bt->radius[i], x, y, ox, oy))
+            {
+                continue;
+            }
+
+            if (near)
+            {
+                const fixed_t blockdist = bt->radius[i] + (*near->thing)->radius;
+
+                if (abs(bt->x[i] - *near->x) >= blockdist || abs(bt->y[i] - *near->y) >= blockdist)
+                {
+                    continue;
+                }
+            }
+
+            mobj = bt->mobjs[i];
+            stamp = bt->stamp;
+
+            if (!func(mobj))
+            {
+                return false;
+            }
+
+            // The cell has changed, go on by the links.
+            if (bt->stamp != stamp || blockunsynced)
+            {
+                break;
+            }
+        }
+
+        if (i < 0)
+        {
+            return true;
+        }
+
+        mobj = mobj->bnext;
     }
 
-    for (mobj = blocklinks[y*bmapwidth+x] ; mobj ; mobj = mobj->bnext)
+    for ( ; mobj ; mobj = mobj->bnext)
+    {
+        if ((ox || oy) && !P_BlockThingOverlaps(mobj->x, mobj->y, mobj->radius, x, y, ox, oy))
+        {
+            continue;
+        }
+
         if (!func(mobj))
+        {
             return false;
+        }
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// P_BlockThingsIterator
+// -----------------------------------------------------------------------------
+
+static const boolean P_BlockThingsIter (const int x, const int y, boolean (*func)(mobj_t*),
+                                        const blocknear_t *near)
+{
+    if (x < 0 || y < 0 || x >= bmapwidth || y >= bmapheight)
+    {
+        return true;
+    }
+
+    if (!P_BlockThingsCell(x, y, 0, 0, func, near))
+    {
+        return false;
+    }
 
     // [JN] Do not apply following BLOCKMAP fix for explosion radius damage.
     // Otherwise, explosion damage will be multiplied on ammount of BLOCKMAP 
@@ -427,97 +697,19 @@ const boolean P_BlockThingsIterator (int x, int y, boolean (*func)(mobj_t*))
     // Fixes: http://doom2.net/doom2/research/things.html
     if (singleplayer && improved_collision && !strict_mode && !vanillaparm)
     {
-        // Unwrapped for least number of bounding box checks
-        // (-1, -1)
-        if (x > 0 && y > 0)
-        {
-            for (mobj = blocklinks[(y-1)*bmapwidth+(x-1)] ; mobj ; mobj = mobj->bnext)
-            {
-                int xx = (mobj->x + mobj->radius - bmaporgx)>>MAPBLOCKSHIFT;
-                int yy = (mobj->y + mobj->radius - bmaporgy)>>MAPBLOCKSHIFT;
-                if (xx == x && yy == y)
-                    if (!func( mobj ))
-                        return false;
-            }
-        }
-        // (0, -1)
-        if (y > 0)
-        {
-            for (mobj = blocklinks[(y-1)*bmapwidth+x] ; mobj ; mobj = mobj->bnext)
-            {
-                int yy = (mobj->y + mobj->radius - bmaporgy)>>MAPBLOCKSHIFT;
-                if (yy == y)
-                    if (!func( mobj ))
-                        return false;
-            }
-        }
-        // (1, -1)
-        if (x < (bmapwidth-1) && y > 0)
-        {
-            for (mobj = blocklinks[(y-1)*bmapwidth+(x+1)] ; mobj ; mobj = mobj->bnext)
-            {
-                int xx = (mobj->x - mobj->radius - bmaporgx)>>MAPBLOCKSHIFT;
-                int yy = (mobj->y + mobj->radius - bmaporgy)>>MAPBLOCKSHIFT;
-                if (xx == x && yy == y)
-                    if (!func( mobj ))
-                        return false;
-            }
-        }
-        // (1, 0)
-        if (x < (bmapwidth-1))
-        {
-            for (mobj = blocklinks[y*bmapwidth+(x+1)] ; mobj ; mobj = mobj->bnext)
-            {
-                int xx = (mobj->x - mobj->radius - bmaporgx)>>MAPBLOCKSHIFT;
-                if (xx == x)
-                    if (!func( mobj ))
-                        return false;
-            }
-        }
-        // (1, 1)
-        if (x < (bmapwidth-1) && y < (bmapheight-1))
-        {
-            for (mobj = blocklinks[(y+1)*bmapwidth+(x+1)] ; mobj ; mobj = mobj->bnext)
-            {
-                int xx = (mobj->x - mobj->radius - bmaporgx)>>MAPBLOCKSHIFT;
-                int yy = (mobj->y - mobj->radius - bmaporgy)>>MAPBLOCKSHIFT;
-                if (xx == x && yy == y)
-                    if (!func( mobj ))
-                        return false;
-            }
-        }
-        // (0, 1)
-        if (y < (bmapheight-1))
-        {
-            for (mobj = blocklinks[(y+1)*bmapwidth+x] ; mobj ; mobj = mobj->bnext)
-            {
-                int yy = (mobj->y - mobj->radius - bmaporgy)>>MAPBLOCKSHIFT;
-                if (yy == y)
-                    if (!func( mobj ))
-                        return false;
-            }
-        }
-        // (-1, 1)
-        if (x > 0 && y < (bmapheight-1))
-        {
-            for (mobj = blocklinks[(y+1)*bmapwidth+(x-1)] ; mobj ; mobj = mobj->bnext)
-            {
-                int xx = (mobj->x + mobj->radius - bmaporgx)>>MAPBLOCKSHIFT;
-                int yy = (mobj->y - mobj->radius - bmaporgy)>>MAPBLOCKSHIFT;
-                if (xx == x && yy == y)
-                    if (!func( mobj ))
-                        return false;
-            }
-        }
-        // (-1, 0)
-        if (x > 0)
+        static const int around[8][2] = {
+            {-1, -1}, {0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}
+        };
+
+        for (int i = 0 ; i < 8 ; i++)
         {
-            for (mobj = blocklinks[y*bmapwidth+(x-1)] ; mobj ; mobj = mobj->bnext)
+            const int ox = around[i][0];
+            const int oy = around[i][1];
+
+            if (x+ox >= 0 && x+ox < bmapwidth && y+oy >= 0 && y+oy < bmapheight
+            && !P_BlockThingsCell(x, y, ox, oy, func, near))
             {
-                int xx = (mobj->x + mobj->radius - bmaporgx)>>MAPBLOCKSHIFT;
-                if (xx == x)
-                    if (!func( mobj ))
-                        return false;
+                return false;
             }
         }
     }
@@ -525,6 +717,24 @@ const boolean P_BlockThingsIterator (int x, int y, boolean (*func)(mobj_t*))
     return true;
 }
 
+const boolean P_BlockThingsIterator (const int x, const int y, boolean (*func)(mobj_t*))
+{
+    return P_BlockThingsIter(x, y, func, NULL);
+}
+
+// -----------------------------------------------------------------------------
+// P_BlockThingsNearIterator
+// [JN] Same as above, but skips things which don't touch the square of
+// the near thing's radius around the near point. Both are read again
+// after every call of func, as func may change them.
+// -----------------------------------------------------------------------------
+
+const boolean P_BlockThingsNearIterator (const int x, const int y, boolean (*func)(mobj_t*),
+                                         const blocknear_t *near)
+{
+    return P_BlockThingsIter(x, y, func, near);
+}
+
 
 // =============================================================================
 //
@@ -537,6 +747,12 @@ intercept_t        *intercept_p;
 divline_t           trace;
 static boolean      earlyout;
 
+// [JN] Intercepts found but not traversed yet, closest on top.
+// Only used by the traversal in order, see P_PathTraverse.
+static int         *interheap;
+static int          numinterheap, maxinterheap;
+static boolean      interinorder;
+
 static void InterceptsOverrun (int num_intercepts, intercept_t *intercept);
 
 // -----------------------------------------------------------------------------
@@ -557,6 +773,59 @@ static void check_intercept (void)
 	}
 }
 
+// -----------------------------------------------------------------------------
+// P_PushIntercept, P_PopIntercept
+// [JN] Binary heap of intercepts, by distance and then by the order of
+// finding, the same order P_TraverseIntercepts goes in.
+// -----------------------------------------------------------------------------
+
+#define INTERCEPT_BEFORE(a, b) (intercepts[a].frac < intercepts[b].frac \
+                            || (intercepts[a].frac == intercepts[b].frac && (a) < (b)))
+
+static void P_PushIntercept (const int index)
+{
+    int i;
+
+    if (numinterheap == maxinterheap)
+    {
+        maxinterheap = maxinterheap ? maxinterheap * 2 : MAXINTERCEPTS_ORIGINAL;
+        interheap = I_Realloc(interheap, maxinterheap * sizeof(*interheap));
+    }
+
+    for (i = numinterheap++ ; i > 0 && INTERCEPT_BEFORE(index, interheap[(i-1)/2]) ; i = (i-1)/2)
+    {
+        interheap[i] = interheap[(i-1)/2];
+    }
+
+    interheap[i] = index;
+}
+
+static int P_PopIntercept (void)
+{
+    const int top = interheap[0];
+    const int last = interheap[--numinterheap];
+    int i, child;
+
+    for (i = 0 ; (child = 2*i+1) < numinterheap ; i = child)
+    {
+        if (child+1 < numinterheap && INTERCEPT_BEFORE(interheap[child+1], interheap[child]))
+        {
+            child++;
+        }
+
+        if (!INTERCEPT_BEFORE(interheap[child], last))
+        {
+            break;
+        }
+
+        interheap[i] = interheap[child];
+    }
+
+    interheap[i] = last;
+
+    return top;
+}
+
 // -----------------------------------------------------------------------------
 // PIT_AddLineIntercepts.
 // Looks for lines in the given block that intercept the given trace to
@@ -610,6 +879,13 @@ static boolean PIT_AddLineIntercepts (line_t *ld)
     intercept_p->frac = frac;
     intercept_p->isaline = true;
     intercept_p->d.line = ld;
+    // [JN] Walked in order, there is no overrun to emulate.
+    if (interinorder)
+    {
+        P_PushIntercept(intercept_p++ - intercepts);
+        return true;
+    }
+
     InterceptsOverrun(intercept_p - intercepts, intercept_p);
     // [crispy] & [JN] Intercepts overflow guard.
     if (intercept_p - intercepts == MAXINTERCEPTS_ORIGINAL + 1)
@@ -686,6 +962,13 @@ static boolean PIT_AddThingIntercepts (mobj_t *thing)
     intercept_p->frac = frac;
     intercept_p->isaline = false;
     intercept_p->d.thing = thing;
+    // [JN] Walked in order, there is no overrun to emulate.
+    if (interinorder)
+    {
+        P_PushIntercept(intercept_p++ - intercepts);
+        return true;
+    }
+
     InterceptsOverrun(intercept_p - intercepts, intercept_p);
     // [crispy] & [JN] Intercepts overflow guard.
     if (intercept_p - intercepts == MAXINTERCEPTS_ORIGINAL + 1)
@@ -741,6 +1024,61 @@ static boolean P_TraverseIntercepts (const traverser_t func, const fixed_t maxfr
     return true;            // everything was traversed
 }
 
+// -----------------------------------------------------------------------------
+// P_TraverseHeap
+// [JN] Calls the traverser function for the intercepts found so far,
+// up to the given distance. Returns false if the function does.
+// -----------------------------------------------------------------------------
+
+static boolean P_TraverseHeap (const traverser_t func, const fixed_t maxfrac)
+{
+    while (numinterheap && intercepts[interheap[0]].frac <= maxfrac)
+    {
+        if (!func(&intercepts[P_PopIntercept()]))
+        {
+            return false;  // don't bother going farther
+        }
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// P_InterceptBound
+// [JN] Returns the closest distance any intercept still to be found can be
+// at, with the walk going on from the block x,y. The blocks only go on in
+// the direction of the trace, so it is where the trace reaches the near
+// sides of the block, pushed back by "reach" for things sticking out
+// of their blocks.
+// -----------------------------------------------------------------------------
+
+static fixed_t P_InterceptBound (const int x, const int y, const fixed_t reach)
+{
+    const int64_t left = ((int64_t) x << MAPBLOCKSHIFT) + bmaporgx;
+    const int64_t bottom = ((int64_t) y << MAPBLOCKSHIFT) + bmaporgy;
+    int64_t bound = INT_MIN;
+
+    if (trace.dx > 0)
+    {
+        bound = MAX(bound, ((left - reach - trace.x) * FRACUNIT) / trace.dx);
+    }
+    else if (trace.dx < 0)
+    {
+        bound = MAX(bound, ((left + MAPBLOCKSIZE + reach - trace.x) * FRACUNIT) / trace.dx);
+    }
+
+    if (trace.dy > 0)
+    {
+        bound = MAX(bound, ((bottom - reach - trace.y) * FRACUNIT) / trace.dy);
+    }
+    else if (trace.dy < 0)
+    {
+        bound = MAX(bound, ((bottom + MAPBLOCKSIZE + reach - trace.y) * FRACUNIT) / trace.dy);
+    }
+
+    return (fixed_t) BETWEEN(INT_MIN, INT_MAX, bound);
+}
+
 extern fixed_t bulletslope;
 
 // Intercepts Overrun emulation, from PrBoom-plus.
@@ -891,9 +1229,27 @@ boolean P_PathTraverse (fixed_t x1, fixed_t y1, fixed_t x2, fixed_t y2,
     int mapxstep;
     int mapystep;
     int count;
+    fixed_t reach;
 
     earlyout = (flags & PT_EARLYOUT) != 0;
 
+    // [JN] Traverse the intercepts in order as the blocks are walked,
+    // so a shot stops at the first thing it hits without gathering
+    // the rest of its way. The same order as P_TraverseIntercepts,
+    // but without the overrun emulation, which needs all of them.
+    interinorder = singleplayer && !strict_mode && !vanillaparm;
+    numinterheap = 0;
+
+    // Things may stick out of their block by the radius, or twice
+    // the radius when found in the neighbour blocks. And a margin
+    // for rounding of the intercept vector.
+    reach = 16*FRACUNIT;
+
+    if (flags & PT_ADDTHINGS)
+    {
+        reach += 2 * blockmaxradius + 16*FRACUNIT;
+    }
+
     validcount++;
     intercept_p = intercepts;
 
@@ -1001,7 +1357,29 @@ boolean P_PathTraverse (fixed_t x1, fixed_t y1, fixed_t x2, fixed_t y2,
             xintercept += xstep;
             mapy += mapystep;
         }
+
+        // [JN] Go through the intercepts no block left can beat.
+        if (interinorder)
+        {
+            const fixed_t bound = P_InterceptBound(mapx, mapy, reach);
+
+            if (!P_TraverseHeap(trav, MIN(bound, FRACUNIT)))
+            {
+                return false;
+            }
+
+            if (bound > FRACUNIT)
+            {
+                return true;  // checked everything in range
+            }
+        }
     }
+
+    if (interinorder)
+    {
+        return P_TraverseHeap(trav, FRACUNIT);
+    }
+
     // go through the sorted list
     return P_TraverseIntercepts (trav, FRACUNIT);
 }
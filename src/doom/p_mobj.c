@@ -22,6 +22,7 @@
 #include "i_system.h"
 #include "z_zone.h"
 #include "m_random.h"
+#include "m_prof.h"
 #include "p_local.h"
 #include "st_bar.h"
 #include "s_sound.h"
@@ -140,7 +141,8 @@ const boolean P_SetMobjState (mobj_t *mobj, statenum_t state)
         if (st->action.acp3)
         {
             // [crispy] let pspr action pointers get called from mobj states
-            st->action.acp3(mobj, NULL, NULL);
+            M_PROFCALL(PROF_ACTION, st->action.acp3, mobj->type,
+                       st->action.acp3(mobj, NULL, NULL));
         }
 
         state = st->nextstate;
@@ -805,6 +807,7 @@ static mobj_t *P_SpawnMobjSafe (const fixed_t x, const fixed_t y, const fixed_t
 
     mobj = Z_Malloc (sizeof(*mobj), PU_LEVEL, NULL);
     memset (mobj, 0, sizeof (*mobj));
+    mobj->bcell = mobj->bslot = -1;  // [JN] Not in blockthings yet.
     info = &mobjinfo[type];
 
     mobj->type = type;
@@ -1365,6 +1368,7 @@ void P_CheckMissileSpawn (mobj_t *th)
     th->x += (th->momx>>1);
     th->y += (th->momy>>1);
     th->z += (th->momz>>1);
+    P_UpdateBlockThing(th);  // [JN] moved without relinking
 
     if (!P_TryMove (th, th->x, th->y))
     {
@@ -0,0 +1,224 @@
+//
+// Copyright(C) 2016-2023 Julian Nechaevsky
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// DESCRIPTION:
+//	Names of action functions and thinkers for profiling, see m_prof.c.
+//
+
+
+#include "m_prof.h"
+#include "p_local.h"
+#include "jn.h"
+
+
+extern void A_Light0();
+extern void A_WeaponReady();
+extern void A_Lower();
+extern void A_Raise();
+extern void A_Punch();
+extern void A_ReFire();
+extern void A_FirePistol();
+extern void A_Light1();
+extern void A_FireShotgun();
+extern void A_Light2();
+extern void A_FireShotgun2();
+extern void A_CheckReload();
+extern void A_OpenShotgun2();
+extern void A_LoadShotgun2();
+extern void A_CloseShotgun2();
+extern void A_FireCGun();
+extern void A_GunFlash();
+extern void A_FireMissile();
+extern void A_Saw();
+extern void A_FirePlasma();
+extern void A_BFGsound();
+extern void A_FireBFG();
+extern void A_BFGSpray();
+extern void A_Explode();
+extern void A_Pain();
+extern void A_PlayerScream();
+extern void A_Fall();
+extern void A_XScream();
+extern void A_Look();
+extern void A_Chase();
+extern void A_FaceTarget();
+extern void A_PosAttack();
+extern void A_Scream();
+extern void A_SPosAttack();
+extern void A_VileChase();
+extern void A_VileStart();
+extern void A_VileTarget();
+extern void A_VileAttack();
+extern void A_StartFire();
+extern void A_Fire();
+extern void A_FireCrackle();
+extern void A_Tracer();
+extern void A_SkelWhoosh();
+extern void A_SkelFist();
+extern void A_SkelMissile();
+extern void A_FatRaise();
+extern void A_FatAttack1();
+extern void A_FatAttack2();
+extern void A_FatAttack3();
+extern void A_BossDeath();
+extern void A_CPosAttack();
+extern void A_CPosRefire();
+extern void A_TroopAttack();
+extern void A_SargAttack();
+extern void A_HeadAttack();
+extern void A_BruisAttack();
+extern void A_SkullAttack();
+extern void A_Metal();
+extern void A_SpidRefire();
+extern void A_BabyMetal();
+extern void A_BspiAttack();
+extern void A_Hoof();
+extern void A_CyberAttack();
+extern void A_PainAttack();
+extern void A_PainDie();
+extern void A_KeenDie();
+extern void A_BrainPain();
+extern void A_BrainScream();
+extern void A_BrainDie();
+extern void A_BrainAwake();
+extern void A_BrainSpit();
+extern void A_SpawnSound();
+extern void A_SpawnFly();
+extern void A_BrainExplode();
+extern void A_Stop();
+extern void A_Die();
+extern void A_FireOldBFG();
+extern void A_Detonate();
+extern void A_Mushroom();
+extern void A_BetaSkullAttack();
+extern void A_Spawn();
+extern void A_Turn();
+extern void A_Face();
+extern void A_Scratch();
+extern void A_PlaySound();
+extern void A_RandomJump();
+extern void A_LineEffect();
+
+#define PROFNAME(f) { (proffunc_t) f, #f }
+
+static const profname_t profnames[] = {
+    // Thinkers.
+    PROFNAME(P_MobjThinker),
+    PROFNAME(T_MoveFloor),
+    PROFNAME(T_MoveCeiling),
+    PROFNAME(T_VerticalDoor),
+    PROFNAME(T_PlatRaise),
+    PROFNAME(T_LightFlash),
+    PROFNAME(T_StrobeFlash),
+    PROFNAME(T_Glow),
+    PROFNAME(T_FireFlicker),
+
+    // Action functions.
+    PROFNAME(A_Light0),
+    PROFNAME(A_WeaponReady),
+    PROFNAME(A_Lower),
+    PROFNAME(A_Raise),
+    PROFNAME(A_Punch),
+    PROFNAME(A_ReFire),
+    PROFNAME(A_FirePistol),
+    PROFNAME(A_Light1),
+    PROFNAME(A_FireShotgun),
+    PROFNAME(A_Light2),
+    PROFNAME(A_FireShotgun2),
+    PROFNAME(A_CheckReload),
+    PROFNAME(A_OpenShotgun2),
+    PROFNAME(A_LoadShotgun2),
+    PROFNAME(A_CloseShotgun2),
+    PROFNAME(A_FireCGun),
+    PROFNAME(A_GunFlash),
+    PROFNAME(A_FireMissile),
+    PROFNAME(A_Saw),
+    PROFNAME(A_FirePlasma),
+    PROFNAME(A_BFGsound),
+    PROFNAME(A_FireBFG),
+    PROFNAME(A_BFGSpray),
+    PROFNAME(A_Explode),
+    PROFNAME(A_Pain),
+    PROFNAME(A_PlayerScream),
+    PROFNAME(A_Fall),
+    PROFNAME(A_XScream),
+    PROFNAME(A_Look),
+    PROFNAME(A_Chase),
+    PROFNAME(A_FaceTarget),
+    PROFNAME(A_PosAttack),
+    PROFNAME(A_Scream),
+    PROFNAME(A_SPosAttack),
+    PROFNAME(A_VileChase),
+    PROFNAME(A_VileStart),
+    PROFNAME(A_VileTarget),
+    PROFNAME(A_VileAttack),
+    PROFNAME(A_StartFire),
+    PROFNAME(A_Fire),
+    PROFNAME(A_FireCrackle),
+    PROFNAME(A_Tracer),
+    PROFNAME(A_SkelWhoosh),
+    PROFNAME(A_SkelFist),
+    PROFNAME(A_SkelMissile),
+    PROFNAME(A_FatRaise),
+    PROFNAME(A_FatAttack1),
+    PROFNAME(A_FatAttack2),
+    PROFNAME(A_FatAttack3),
+    PROFNAME(A_BossDeath),
+    PROFNAME(A_CPosAttack),
+    PROFNAME(A_CPosRefire),
+    PROFNAME(A_TroopAttack),
+    PROFNAME(A_SargAttack),
+    PROFNAME(A_HeadAttack),
+    PROFNAME(A_BruisAttack),
+    PROFNAME(A_SkullAttack),
+    PROFNAME(A_Metal),
+    PROFNAME(A_SpidRefire),
+    PROFNAME(A_BabyMetal),
+    PROFNAME(A_BspiAttack),
+    PROFNAME(A_Hoof),
+    PROFNAME(A_CyberAttack),
+    PROFNAME(A_PainAttack),
+    PROFNAME(A_PainDie),
+    PROFNAME(A_KeenDie),
+    PROFNAME(A_BrainPain),
+    PROFNAME(A_BrainScream),
+    PROFNAME(A_BrainDie),
+    PROFNAME(A_BrainAwake),
+    PROFNAME(A_BrainSpit),
+    PROFNAME(A_SpawnSound),
+    PROFNAME(A_SpawnFly),
+    PROFNAME(A_BrainExplode),
+    PROFNAME(A_Stop),
+    PROFNAME(A_Die),
+    PROFNAME(A_FireOldBFG),
+    PROFNAME(A_Detonate),
+    PROFNAME(A_Mushroom),
+    PROFNAME(A_BetaSkullAttack),
+    PROFNAME(A_Spawn),
+    PROFNAME(A_Turn),
+    PROFNAME(A_Face),
+    PROFNAME(A_Scratch),
+    PROFNAME(A_PlaySound),
+    PROFNAME(A_RandomJump),
+    PROFNAME(A_LineEffect),
+    { NULL, NULL }
+};
+
+// -----------------------------------------------------------------------------
+// P_InitProfile
+// -----------------------------------------------------------------------------
+
+void P_InitProfile (void)
+{
+    M_ProfInit(profnames);
+}
@@ -22,6 +22,7 @@
 #include "d_event.h"
 #include "deh_misc.h"
 #include "m_random.h"
+#include "m_prof.h"
 #include "p_local.h"
 #include "s_sound.h"
 #include "doomstat.h"
@@ -68,7 +69,8 @@ static void P_SetPsprite (player_t *player, const int position, statenum_t stnum
         if (state->action.acp3)
         {
             // [crispy] let mobj action pointers get called from pspr states
-            state->action.acp3(player->mo, player, psp);
+            M_PROFCALL(PROF_WEAPON, state->action.acp3, -1,
+                       state->action.acp3(player->mo, player, psp));
             if (!psp->state)
             {
                 break;
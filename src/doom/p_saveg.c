@@ -335,6 +335,9 @@ static void saveg_read_mobj_t(mobj_t *str)
 {
     int pl;
 
+    // [JN] Not in blockthings yet, see P_BlockThingLinked.
+    str->bcell = str->bslot = -1;
+
     // thinker_t thinker;
     saveg_read_thinker_t(&str->thinker);
 
@@ -1709,6 +1712,10 @@ void P_UnArchiveWorld (void)
     b = saveg_read8();
     c = saveg_read8();
     totalleveltimes = (a<<16) + (b<<8) + c;
+
+    // [JN] sector tags and line flags are restored too
+    P_InitTagLists();
+    P_InitSoundGraph();
 }
 
 
@@ -1791,6 +1798,7 @@ void P_UnArchiveThinkers (void)
 	  case tc_mobj:
 	    saveg_read_pad();
 	    mobj = Z_Malloc (sizeof(*mobj), PU_LEVEL, NULL);
+	    memset (mobj, 0, sizeof (*mobj));
             saveg_read_mobj_t(mobj);
 
 	    P_SetThingPosition (mobj);
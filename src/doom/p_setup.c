@@ -22,6 +22,7 @@
 #include "i_swap.h"
 #include "m_argv.h"
 #include "m_bbox.h"
+#include "m_prof.h"
 #include "g_game.h"
 #include "i_system.h"
 #include "p_local.h"
@@ -1914,6 +1915,8 @@ static void P_GroupLines (void)
                 M_AddToBox (bbox, li->v2->x, li->v2->y);
         }
 
+        memcpy(sector->bbox, bbox, sizeof(bbox));
+
         // set the degenmobj_t to the middle of the bounding box
         sector->soundorg.x = (bbox[BOXRIGHT]+bbox[BOXLEFT])/2;
         sector->soundorg.y = (bbox[BOXTOP]+bbox[BOXBOTTOM])/2;
@@ -2194,6 +2197,9 @@ void P_SetupLevel (const int episode, const int map, const skill_t skill)
 
     lumpnum = W_GetNumForName (lumpname);
 
+    // [JN] Report the actions and thinkers of the previous level.
+    M_ProfLevel (lumpname);
+
     // [JN] Checking for multiple map lump names for allowing map fixes to work.
     // Adaptaken from DOOM Retro, thanks Brad Harding!
     //  Fixes also should not work for: network game, shareware, IWAD versions below 1.9,
@@ -2248,6 +2254,8 @@ void P_SetupLevel (const int episode, const int map, const skill_t skill)
     {
         P_CreateBlockMap();
     }
+    // [JN] index things of every block along with blocklinks
+    P_InitBlockThings();
 
     if (crispy_mapformat & (ZDBSPX | ZDBSPZ))
     {
@@ -2267,7 +2275,15 @@ void P_SetupLevel (const int episode, const int map, const skill_t skill)
     }
 
     P_GroupLines ();
+    // [JN] chain sectors by tag for specials
+    P_InitTagLists ();
+    // [JN] gather sector neighbours for sound propagation
+    P_InitSoundGraph ();
     P_LoadReject (lumpnum+ML_REJECT);
+    // [JN] pack nodes for rendering
+    R_InitBSPNodes ();
+    // [JN] build potentially visible set, if enabled
+    R_InitPVS ();
     
     // [crispy] remove slime trails
     P_RemoveSlimeTrails();
@@ -2330,4 +2346,20 @@ void P_Init (void)
     P_InitSwitchList ();
     P_InitPicAnims ();
     R_InitSprites (sprnames);
+
+    //!
+    // @category game
+    //
+    // Print how many sight checks were rejected, cached and traced
+    // through the BSP tree, at exit.
+    //
+
+    if (M_ParmExists("-sightstats"))
+    {
+        I_AtExit(P_ReportSight, true);
+    }
+
+    P_InitSightThreads ();
+    P_InitChangeSector ();
+    P_InitProfile ();
 }
@@ -18,18 +18,58 @@
 //
 
 
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "SDL.h"
 #include "doomstat.h"
 #include "i_system.h"
+#include "m_argv.h"
 #include "p_local.h"
 #include "jn.h"
 
 
-static fixed_t   sightzstart;            // eye z of looker
-static fixed_t   topslope, bottomslope;  // slopes to top and bottom of target
-static fixed_t   t2x, t2y;
-static divline_t strace;                 // from t1 to t2
+extern void A_Look (mobj_t *actor);
 
-static int sightcounts[2];
+
+// [JN] State of a single sight check, so checks can be run on
+// several threads at once. See P_PrefetchSight.
+typedef struct
+{
+    fixed_t   sightzstart;            // eye z of looker
+    fixed_t   topslope, bottomslope;  // slopes to top and bottom of target
+    fixed_t   t2x, t2y;
+    divline_t strace;                 // from t1 to t2
+    int      *linecount;              // Per line validcount, or NULL to
+    int       count;                  // use the lines' own validcount.
+} sightctx_t;
+
+static sightctx_t sight;  // Checks of the main thread.
+
+static int sightcounts[3];  // [JN] Rejected, traced and cached.
+
+// [JN] Results of recent sight checks. A result depends only on the
+// positions and heights of both things and on the sector heights,
+// so it is kept until any of them changes: entries are only valid
+// with the current sightstamp, which is bumped every tic and by every
+// moving plane. Direct mapped, hashed by the pair of things, and big
+// enough to hold the prefetched checks of a tic of crowded maps.
+#define SIGHTCACHE_SIZE 4096
+
+typedef struct
+{
+    const mobj_t      *t1, *t2;
+    const subsector_t *s1, *s2;
+    fixed_t  x1, y1, z1, h1;
+    fixed_t  x2, y2, z2, h2;
+    unsigned stamp;
+    boolean  result;
+} sightcache_t;
+
+static sightcache_t sightcache[SIGHTCACHE_SIZE];
+
+unsigned int sightstamp = 1;
 
 
 // -----------------------------------------------------------------------------
@@ -55,25 +95,25 @@ static boolean PTR_SightTraverse(intercept_t *in)
 
     if (li->frontsector->floorheight != li->backsector->floorheight)
     {
-        slope = FixedDiv(openbottom - sightzstart , in->frac);
+        slope = FixedDiv(openbottom - sight.sightzstart , in->frac);
 
-        if (slope > bottomslope)
+        if (slope > sight.bottomslope)
         {
-            bottomslope = slope;
+            sight.bottomslope = slope;
         }
     }
 
     if (li->frontsector->ceilingheight != li->backsector->ceilingheight)
     {
-        slope = FixedDiv(opentop - sightzstart, in->frac);
+        slope = FixedDiv(opentop - sight.sightzstart, in->frac);
 
-        if (slope < topslope)
+        if (slope < sight.topslope)
         {
-            topslope = slope;
+            sight.topslope = slope;
         }
     }
 
-    if (topslope <= bottomslope)
+    if (sight.topslope <= sight.bottomslope)
     {
         return false;  // stop
     }
@@ -130,7 +170,7 @@ static const fixed_t P_InterceptVector2 (const divline_t *v2, const divline_t *v
 // Returns true if strace crosses the given subsector successfully.
 // -----------------------------------------------------------------------------
 
-static const boolean P_CrossSubsector (const int num)
+static const boolean P_CrossSubsector (const int num, sightctx_t *ctx)
 {
     seg_t        *seg;
     line_t       *line;
@@ -162,17 +202,31 @@ static const boolean P_CrossSubsector (const int num)
         line = seg->linedef;
 
         // allready checked other side?
-        if (line->validcount == validcount)
+        if (ctx->linecount)
         {
-            continue;
+            int *const count = &ctx->linecount[line - lines];
+
+            if (*count == ctx->count)
+            {
+                continue;
+            }
+
+            *count = ctx->count;
         }
+        else
+        {
+            if (line->validcount == validcount)
+            {
+                continue;
+            }
 
-        line->validcount = validcount;
+            line->validcount = validcount;
+        }
 
         v1 = line->v1;
         v2 = line->v2;
-        s1 = P_DivlineSide (v1->x,v1->y, &strace);
-        s2 = P_DivlineSide (v2->x, v2->y, &strace);
+        s1 = P_DivlineSide (v1->x,v1->y, &ctx->strace);
+        s2 = P_DivlineSide (v2->x, v2->y, &ctx->strace);
 
         // line isn't crossed?
         if (s1 == s2)
@@ -184,8 +238,8 @@ static const boolean P_CrossSubsector (const int num)
         divl.y = v1->y;
         divl.dx = v2->x - v1->x;
         divl.dy = v2->y - v1->y;
-        s1 = P_DivlineSide (strace.x, strace.y, &divl);
-        s2 = P_DivlineSide (t2x, t2y, &divl);
+        s1 = P_DivlineSide (ctx->strace.x, ctx->strace.y, &divl);
+        s2 = P_DivlineSide (ctx->t2x, ctx->t2y, &divl);
 
         // line isn't crossed?
         if (s1 == s2)
@@ -245,27 +299,27 @@ static const boolean P_CrossSubsector (const int num)
             return false;  // stop
         }
 
-        frac = P_InterceptVector2 (&strace, &divl);
+        frac = P_InterceptVector2 (&ctx->strace, &divl);
 
         if (front->floorheight != back->floorheight)
         {
-            slope = FixedDiv (openbottom - sightzstart , frac);
-            if (slope > bottomslope)
+            slope = FixedDiv (openbottom - ctx->sightzstart , frac);
+            if (slope > ctx->bottomslope)
             {
-                bottomslope = slope;
+                ctx->bottomslope = slope;
             }
         }
 
         if (front->ceilingheight != back->ceilingheight)
         {
-            slope = FixedDiv (opentop - sightzstart , frac);
-            if (slope < topslope)
+            slope = FixedDiv (opentop - ctx->sightzstart , frac);
+            if (slope < ctx->topslope)
             {
-                topslope = slope;
+                ctx->topslope = slope;
             }
         }
 
-        if (topslope <= bottomslope)
+        if (ctx->topslope <= ctx->bottomslope)
         {
             return false;  // stop
         }
@@ -277,60 +331,137 @@ static const boolean P_CrossSubsector (const int num)
 
 // -----------------------------------------------------------------------------
 // P_CrossBSPNode
-// Returns true if strace crosses the given node successfully.
+// Returns true if ctx->strace crosses the given node successfully.
 // -----------------------------------------------------------------------------
 
-static const boolean P_CrossBSPNode (const int bspnum)
+static const boolean P_CrossBSPNode (const int bspnum, sightctx_t *ctx)
 {
     node_t *bsp;
     int     side;
 
     if (bspnum & NF_SUBSECTOR)
     {
-        return P_CrossSubsector (bspnum == -1 ? 0 : bspnum&(~NF_SUBSECTOR));
+        return P_CrossSubsector (bspnum == -1 ? 0 : bspnum&(~NF_SUBSECTOR), ctx);
     }
 
     bsp = &nodes[bspnum];
 
     // decide which side the start point is on
-    side = P_DivlineSide (strace.x, strace.y, (divline_t *)bsp);
+    side = P_DivlineSide (ctx->strace.x, ctx->strace.y, (divline_t *)bsp);
     if (side == 2)
     {
         side = 0;  // an "on" should cross both sides
     }
 
     // cross the starting side
-    if (!P_CrossBSPNode(bsp->children[side]))
+    if (!P_CrossBSPNode(bsp->children[side], ctx))
     {
         return false;
     }
 
     // the partition plane is crossed here
-    if (side == P_DivlineSide (t2x, t2y,(divline_t *)bsp))
+    if (side == P_DivlineSide (ctx->t2x, ctx->t2y,(divline_t *)bsp))
     {
         // the line doesn't touch the other side
         return true;
     }
 
     // cross the ending side		
-    return P_CrossBSPNode (bsp->children[side^1]);
+    return P_CrossBSPNode (bsp->children[side^1], ctx);
 }
 
+
 // -----------------------------------------------------------------------------
-// P_CheckSight
-// Returns true if a straight line between t1 and t2 is unobstructed.
-// Uses REJECT.
+// P_SightTrace
+// [JN] Looks from the eyes of t1 to any part of t2 through the BSP tree.
 // -----------------------------------------------------------------------------
 
-const boolean P_CheckSight (const mobj_t *t1, const mobj_t *t2)
+static boolean P_SightTrace (sightctx_t *ctx, const mobj_t *t1, const mobj_t *t2)
+{
+    ctx->sightzstart = t1->z + t1->height - (t1->height>>2);
+    ctx->topslope = (t2->z+t2->height) - ctx->sightzstart;
+    ctx->bottomslope = (t2->z) - ctx->sightzstart;
+
+    ctx->strace.x = t1->x;
+    ctx->strace.y = t1->y;
+    ctx->t2x = t2->x;
+    ctx->t2y = t2->y;
+    ctx->strace.dx = t2->x - t1->x;
+    ctx->strace.dy = t2->y - t1->y;
+
+    // the head node is the last node output
+    return P_CrossBSPNode (numnodes-1, ctx);
+}
+
+// -----------------------------------------------------------------------------
+// P_SightRejected
+// [JN] Check for trivial rejection in REJECT table.
+// -----------------------------------------------------------------------------
+
+static boolean P_SightRejected (const mobj_t *t1, const mobj_t *t2)
 {
     // Determine subsector entries in REJECT table.
     const int s1 = (t1->subsector->sector - sectors);
     const int s2 = (t2->subsector->sector - sectors);
     const int pnum = s1*numsectors + s2;
 
-    // Check for trivial rejection in REJECT table.
-    if (rejectmatrix[pnum>>3] & (1 << (pnum&7)))
+    return (rejectmatrix[pnum>>3] & (1 << (pnum&7))) != 0;
+}
+
+// -----------------------------------------------------------------------------
+// P_SightCacheSlot, P_SightCached, P_SightCacheStore
+// [JN] Same things at the same places since the last change of sectors?
+// -----------------------------------------------------------------------------
+
+static sightcache_t *P_SightCacheSlot (const mobj_t *t1, const mobj_t *t2)
+{
+    return &sightcache[(((uintptr_t) t1 >> 4) * 31 + ((uintptr_t) t2 >> 4))
+                       & (SIGHTCACHE_SIZE - 1)];
+}
+
+static boolean P_SightCached (const sightcache_t *cache,
+                              const mobj_t *t1, const mobj_t *t2)
+{
+    return cache->stamp == sightstamp
+        && cache->t1 == t1 && cache->t2 == t2
+        && cache->s1 == t1->subsector && cache->s2 == t2->subsector
+        && cache->x1 == t1->x && cache->y1 == t1->y
+        && cache->z1 == t1->z && cache->h1 == t1->height
+        && cache->x2 == t2->x && cache->y2 == t2->y
+        && cache->z2 == t2->z && cache->h2 == t2->height;
+}
+
+static void P_SightCacheStore (sightcache_t *cache, const mobj_t *t1,
+                               const mobj_t *t2, const boolean result)
+{
+    cache->t1 = t1;
+    cache->t2 = t2;
+    cache->s1 = t1->subsector;
+    cache->s2 = t2->subsector;
+    cache->x1 = t1->x;
+    cache->y1 = t1->y;
+    cache->z1 = t1->z;
+    cache->h1 = t1->height;
+    cache->x2 = t2->x;
+    cache->y2 = t2->y;
+    cache->z2 = t2->z;
+    cache->h2 = t2->height;
+    cache->stamp = sightstamp;
+    cache->result = result;
+}
+
+// -----------------------------------------------------------------------------
+// P_CheckSight
+// Returns true if a straight line between t1 and t2 is unobstructed.
+// Uses REJECT.
+// -----------------------------------------------------------------------------
+
+const boolean P_CheckSight (const mobj_t *t1, const mobj_t *t2)
+{
+    sightcache_t *cache;
+    boolean result;
+
+    if (P_SightRejected(t1, t2))
     {
         sightcounts[0]++;
 
@@ -338,29 +469,346 @@ const boolean P_CheckSight (const mobj_t *t1, const mobj_t *t2)
         return false;	
     }
 
-    // An unobstructed LOS is possible.
-    // Now look from eyes of t1 to any part of t2.
-    sightcounts[1]++;
+    if (gameversion <= exe_doom_1_2)
+    {
+        // [JN] Not cached, P_PathTraverse leaves the line opening behind.
+        sightcounts[1]++;
+        validcount++;
+
+        // An unobstructed LOS is possible.
+        // Now look from eyes of t1 to any part of t2.
+        sight.sightzstart = t1->z + t1->height - (t1->height>>2);
+        sight.topslope = (t2->z+t2->height) - sight.sightzstart;
+        sight.bottomslope = (t2->z) - sight.sightzstart;
+
+        return P_PathTraverse(t1->x, t1->y, t2->x, t2->y,
+                              PT_EARLYOUT | PT_ADDLINES, PTR_SightTraverse);
+    }
+
+    cache = P_SightCacheSlot(t1, t2);
 
+    if (P_SightCached(cache, t1, t2))
+    {
+        sightcounts[2]++;
+        return cache->result;
+    }
+
+    sightcounts[1]++;
     validcount++;
 
-    sightzstart = t1->z + t1->height - (t1->height>>2);
-    topslope = (t2->z+t2->height) - sightzstart;
-    bottomslope = (t2->z) - sightzstart;
+    result = P_SightTrace(&sight, t1, t2);
+    P_SightCacheStore(cache, t1, t2, result);
 
-    if (gameversion <= exe_doom_1_2)
+    return result;
+}
+
+// =============================================================================
+//
+// [JN] Parallel sight checks.
+//
+// Most monsters of big maps are asleep in A_Look, doing nothing but
+// sight checks. Before the thinkers run, the checks A_Look is going to
+// do this tic are gathered, traced on several threads at once and put
+// into the sight cache in thinker order. The thinkers then run serially
+// as usual and find the results in the cache. A check only reads the
+// map, so the threads never write anything shared, and a cached result
+// is the same as a traced one, so the game goes exactly as without
+// the threads, which -statehash can be used to verify.
+//
+// =============================================================================
+
+#define MAXSIGHTTHREADS 8
+
+typedef struct
+{
+    const mobj_t *t1, *t2;
+    boolean       result;
+} sightjob_t;
+
+typedef struct
+{
+    SDL_Thread *thread;
+    SDL_sem    *start, *done;
+    sightctx_t  ctx;
+    int         first, last;  // jobs first to last-1
+} sightworker_t;
+
+static int           numsightworkers;
+static sightworker_t sightworkers[MAXSIGHTTHREADS + 1];  // The last is ours.
+static boolean       sightworkers_quit;
+static sightjob_t   *sightjobs;
+static int           numsightjobs, maxsightjobs;
+static int           sightlines;  // Size of the linecount arrays.
+
+static int           sightprefetched;  // Checks traced in parallel.
+
+// -----------------------------------------------------------------------------
+// P_RunSightJobs
+// -----------------------------------------------------------------------------
+
+static void P_RunSightJobs (sightworker_t *worker)
+{
+    int i;
+
+    for (i = worker->first ; i < worker->last ; i++)
     {
-        return P_PathTraverse(t1->x, t1->y, t2->x, t2->y,
-                              PT_EARLYOUT | PT_ADDLINES, PTR_SightTraverse);
+        worker->ctx.count++;
+        sightjobs[i].result = P_SightTrace(&worker->ctx,
+                                           sightjobs[i].t1, sightjobs[i].t2);
     }
+}
 
-    strace.x = t1->x;
-    strace.y = t1->y;
-    t2x = t2->x;
-    t2y = t2->y;
-    strace.dx = t2->x - t1->x;
-    strace.dy = t2->y - t1->y;
+// -----------------------------------------------------------------------------
+// P_SightWorker
+// [JN] Thread tracing its part of sight checks every tic.
+// -----------------------------------------------------------------------------
 
-    // the head node is the last node output
-    return P_CrossBSPNode (numnodes-1);	
+static int SDLCALL P_SightWorker (void *data)
+{
+    sightworker_t *const worker = data;
+
+    while (1)
+    {
+        SDL_SemWait(worker->start);
+
+        if (sightworkers_quit)
+        {
+            break;
+        }
+
+        P_RunSightJobs(worker);
+        SDL_SemPost(worker->done);
+    }
+
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+// P_StartSightWorkers, P_StopSightWorkers
+// -----------------------------------------------------------------------------
+
+static void P_StopSightWorkers (void)
+{
+    int i;
+
+    sightworkers_quit = true;
+
+    for (i = 0 ; i < numsightworkers ; i++)
+    {
+        SDL_SemPost(sightworkers[i].start);
+        SDL_WaitThread(sightworkers[i].thread, NULL);
+        SDL_DestroySemaphore(sightworkers[i].start);
+        SDL_DestroySemaphore(sightworkers[i].done);
+    }
+
+    numsightworkers = 0;
+}
+
+static void P_StartSightWorkers (const int count)
+{
+    int i;
+
+    sightworkers_quit = false;
+
+    for (i = 0 ; i < count ; i++)
+    {
+        sightworker_t *const worker = &sightworkers[numsightworkers];
+
+        worker->start = SDL_CreateSemaphore(0);
+        worker->done = SDL_CreateSemaphore(0);
+        worker->thread = worker->start && worker->done ?
+                         SDL_CreateThread(P_SightWorker, "Sight thread", worker) : NULL;
+
+        if (worker->thread == NULL)
+        {
+            // No thread, trace the rest of checks by ourselves.
+            if (worker->start)
+            {
+                SDL_DestroySemaphore(worker->start);
+            }
+            if (worker->done)
+            {
+                SDL_DestroySemaphore(worker->done);
+            }
+            break;
+        }
+
+        numsightworkers++;
+    }
+
+    if (numsightworkers)
+    {
+        I_AtExit(P_StopSightWorkers, true);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// P_InitSightThreads
+// [JN] Called by P_Init.
+// -----------------------------------------------------------------------------
+
+void P_InitSightThreads (void)
+{
+    int i;
+
+    //!
+    // @category game
+    // @arg <n>
+    //
+    // Use n additional threads for sight checks of idle monsters.
+    // Has no effect while recording demos.
+    //
+
+    i = M_CheckParmWithArgs("-sightthreads", 1);
+
+    if (i > 0)
+    {
+        P_StartSightWorkers(BETWEEN(0, MAXSIGHTTHREADS, atoi(myargv[i + 1])));
+    }
+}
+
+// -----------------------------------------------------------------------------
+// P_AddSightJob
+// -----------------------------------------------------------------------------
+
+static void P_AddSightJob (const mobj_t *t1, const mobj_t *t2)
+{
+    // Nothing to trace?
+    if (P_SightRejected(t1, t2)
+    ||  P_SightCached(P_SightCacheSlot(t1, t2), t1, t2))
+    {
+        return;
+    }
+
+    if (numsightjobs == maxsightjobs)
+    {
+        maxsightjobs = maxsightjobs ? maxsightjobs * 2 : 256;
+        sightjobs = I_Realloc(sightjobs, maxsightjobs * sizeof(*sightjobs));
+    }
+
+    sightjobs[numsightjobs].t1 = t1;
+    sightjobs[numsightjobs].t2 = t2;
+    numsightjobs++;
+}
+
+// -----------------------------------------------------------------------------
+// P_PrefetchSight
+// [JN] Traces the sight checks of the monsters going to A_Look this tic
+// on the sight threads. Called by P_Ticker before running the thinkers.
+// -----------------------------------------------------------------------------
+
+void P_PrefetchSight (void)
+{
+    thinker_t *th;
+    int i, j;
+
+    // Demos are recorded exactly the same way as other ports do.
+    if (!numsightworkers || demorecording || gameversion <= exe_doom_1_2)
+    {
+        return;
+    }
+
+    numsightjobs = 0;
+
+    for (th = thinkercap.next ; th != &thinkercap ; th = th->next)
+    {
+        const mobj_t *mobj;
+
+        if (th->function.acp1 != (actionf_p1) P_MobjThinker)
+        {
+            continue;
+        }
+
+        mobj = (const mobj_t *) th;
+
+        // Same checks A_Look will do, in the same order.
+        if (mobj->tics != 1
+        ||  states[mobj->state->nextstate].action.acp1 != (actionf_p1) A_Look)
+        {
+            continue;
+        }
+
+        if (mobj->subsector->sector->soundtarget
+        && (mobj->subsector->sector->soundtarget->flags & MF_SHOOTABLE)
+        && (mobj->flags & MF_AMBUSH))
+        {
+            P_AddSightJob(mobj, mobj->subsector->sector->soundtarget);
+        }
+
+        for (j = 0 ; j < MAXPLAYERS ; j++)
+        {
+            if (playeringame[j] && players[j].mo && players[j].health > 0)
+            {
+                P_AddSightJob(mobj, players[j].mo);
+            }
+        }
+    }
+
+    if (!numsightjobs)
+    {
+        return;
+    }
+
+    // Every worker has its own validcount of the lines.
+    if (sightlines != numlines)
+    {
+        for (i = 0 ; i <= numsightworkers ; i++)
+        {
+            sightworkers[i].ctx.linecount =
+                I_Realloc(sightworkers[i].ctx.linecount,
+                          numlines * sizeof(*sightworkers[i].ctx.linecount));
+            memset(sightworkers[i].ctx.linecount, 0,
+                   numlines * sizeof(*sightworkers[i].ctx.linecount));
+        }
+
+        sightlines = numlines;
+    }
+
+    // Split the jobs evenly, the last part is ours.
+    for (i = 0, j = 0 ; i < numsightworkers ; i++)
+    {
+        sightworkers[i].first = j;
+        sightworkers[i].last = j = numsightjobs * (i + 1) / (numsightworkers + 1);
+        SDL_SemPost(sightworkers[i].start);
+    }
+
+    sightworkers[i].first = j;
+    sightworkers[i].last = numsightjobs;
+    P_RunSightJobs(&sightworkers[i]);
+
+    for (i = 0 ; i < numsightworkers ; i++)
+    {
+        SDL_SemWait(sightworkers[i].done);
+    }
+
+    // Results go to the cache in thinker order, so if two checks
+    // share a slot, the same one is kept on every run.
+    for (i = 0 ; i < numsightjobs ; i++)
+    {
+        P_SightCacheStore(P_SightCacheSlot(sightjobs[i].t1, sightjobs[i].t2),
+                          sightjobs[i].t1, sightjobs[i].t2, sightjobs[i].result);
+    }
+
+    sightprefetched += numsightjobs;
+}
+
+// -----------------------------------------------------------------------------
+// P_ReportSight
+// [JN] Prints how the sight checks of the game went, at exit.
+// -----------------------------------------------------------------------------
+
+void P_ReportSight (void)
+{
+    printf(english_language ?
+           "P_CheckSight: %d rejected, %d cached, %d traced.\n" :
+           "P_CheckSight: %d отброшено, %d из кэша, %d прослежено.\n",
+           sightcounts[0], sightcounts[2], sightcounts[1]);
+
+    if (numsightworkers)
+    {
+        printf(english_language ?
+               "P_PrefetchSight: %d traced on %d threads.\n" :
+               "P_PrefetchSight: %d прослежено в %d потоках.\n",
+               sightprefetched, numsightworkers + 1);
+    }
 }
@@ -92,6 +92,9 @@ static switchlist_t alphSwitchList_vanilla[] =
 static size_t  maxswitches;
 static int    *switchlist;
 static int     numswitches;
+static int    *switchfirst;    // [JN] First entry of every texture, or -1.
+static int    *switchnext;     // [JN] Next entry of the same texture, or -1.
+static int     switchtextures; // [JN] Size of switchfirst.
 static int     maxbuttons; // [crispy] remove MAXBUTTONS limit
 button_t      *buttonlist; // [crispy] remove MAXBUTTONS limit
 
@@ -181,6 +184,26 @@ void P_InitSwitchList (void)
     numswitches = slindex / 2;
     switchlist[slindex] = -1;
 
+    // [JN] Index the list by texture, so switches don't have to search it.
+    for (i = 0, switchtextures = 0 ; i < slindex ; i++)
+    {
+        switchtextures = MAX(switchtextures, switchlist[i] + 1);
+    }
+
+    switchfirst = I_Realloc(switchfirst, (switchtextures + 1) * sizeof(*switchfirst));
+    switchnext = I_Realloc(switchnext, (slindex + 1) * sizeof(*switchnext));
+
+    for (i = 0 ; i < switchtextures ; i++)
+    {
+        switchfirst[i] = -1;
+    }
+
+    for (i = slindex - 1 ; i >= 0 ; i--)
+    {
+        switchnext[i] = switchfirst[switchlist[i]];
+        switchfirst[switchlist[i]] = i;
+    }
+
     // [crispy] add support for SWITCHES lumps
     if (from_lump)
     {
@@ -241,6 +264,33 @@ void P_StartButton (line_t *line, const bwhere_e w, const int texture, const int
             "P_StartButton: превышен лимит слотов для переключателей!");
 }
 
+// -----------------------------------------------------------------------------
+// P_SwitchFirst, P_SwitchEarliest
+// [JN] First entry of a texture in the switch list, and the earliest
+// one of the given entries. Both return -1 for none.
+// -----------------------------------------------------------------------------
+
+static const int P_SwitchFirst (const int texture)
+{
+    return texture >= 0 && texture < switchtextures ? switchfirst[texture] : -1;
+}
+
+static const int P_SwitchEarliest (const int a, const int b, const int c)
+{
+    int i = a;
+
+    if (b >= 0 && (i < 0 || b < i))
+    {
+        i = b;
+    }
+    if (c >= 0 && (i < 0 || c < i))
+    {
+        i = c;
+    }
+
+    return i;
+}
+
 // -----------------------------------------------------------------------------
 // P_ChangeSwitchTexture
 // Function that changes wall texture.
@@ -252,6 +302,7 @@ void P_ChangeSwitchTexture (line_t *line, const int useAgain)
     int     texTop;
     int     texMid;
     int     texBot;
+    int     nextTop, nextMid, nextBot;
     int     sound = sfx_swtchn;
     int     i;
     boolean playsound = false;
@@ -285,10 +336,17 @@ void P_ChangeSwitchTexture (line_t *line, const int useAgain)
     // Fix vanilla bug of non-working switch animations in some instances.
     // Code by Fabian Greffrath (previously by Brad Harding),
     // discovered by Julian Nechaevsky (17.03.2018).
-    for (i = 0 ; i < numswitches*2 ; i++)
+    // [JN] Only the entries of the three textures are gone through,
+    // in the order of the list, as if it were searched all over.
+    nextTop = P_SwitchFirst(texTop);
+    nextMid = P_SwitchFirst(texMid);
+    nextBot = P_SwitchFirst(texBot);
+
+    while ((i = P_SwitchEarliest(nextTop, nextMid, nextBot)) != -1)
     {
-        if (switchlist[i] == texTop)
+        if (i == nextTop)
         {
+            nextTop = switchnext[i];
             playsound = true;
             sides[line->sidenum[0]].toptexture = switchlist[i^1];
 
@@ -300,8 +358,9 @@ void P_ChangeSwitchTexture (line_t *line, const int useAgain)
 
         // [crispy] register up to three buttons at once for lines 
         // with more than one switch texture
-        if (switchlist[i] == texMid)
+        if (i == nextMid)
         {
+            nextMid = switchnext[i];
             playsound = true;
             sides[line->sidenum[0]].midtexture = switchlist[i^1];
 
@@ -311,8 +370,9 @@ void P_ChangeSwitchTexture (line_t *line, const int useAgain)
             }
         }
 
-        if (switchlist[i] == texBot)
+        if (i == nextBot)
         {
+            nextBot = switchnext[i];
             playsound = true;
             sides[line->sidenum[0]].bottomtexture = switchlist[i^1];
 
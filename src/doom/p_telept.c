@@ -30,7 +30,7 @@
 
 const int EV_Teleport (const line_t *line, const int side, mobj_t *thing)
 {
-    int        i, tag;
+    int        i;
     unsigned   an;
     fixed_t    oldx, oldy, oldz;
     mobj_t    *m, *fog;
@@ -49,86 +49,81 @@ const int EV_Teleport (const line_t *line, const int side, mobj_t *thing)
         return 0;
     }
 
-    tag = line->tag;
-
-    for (i = 0 ; i < numsectors ; i++)
+    for (i = -1 ; (i = P_FindSectorFromLineTag(line, i)) >= 0 ; )
     {
-        if (sectors[i].tag == tag )
-        {
-            thinker = thinkercap.next;
+        thinker = thinkercap.next;
 
-            for (thinker = thinkercap.next ; thinker != &thinkercap ; thinker = thinker->next)
+        for (thinker = thinkercap.next ; thinker != &thinkercap ; thinker = thinker->next)
+        {
+            // Not a mobj.
+            if (thinker->function.acp1 != (actionf_p1)P_MobjThinker)
             {
-                // Not a mobj.
-                if (thinker->function.acp1 != (actionf_p1)P_MobjThinker)
-                {
-                    continue;
-                }
+                continue;
+            }
 
-                m = (mobj_t*)thinker;
+            m = (mobj_t*)thinker;
 		
-                // Not a teleportman.
-                if (m->type != MT_TELEPORTMAN)
-                {
-                    continue;
-                }
-
-                sector = m->subsector->sector;
-
-                // Wrong sector.
-                if (sector-sectors != i)
-                {
-                    continue;
-                }
-
-                oldx = thing->x;
-                oldy = thing->y;
-                oldz = thing->z;
-
-                if (!P_TeleportMove (thing, m->x, m->y))
-                {
-                    return 0;
-                }
-
-                // The first Final Doom executable does not set thing->z
-                // when teleporting. This quirk is unique to this
-                // particular version; the later version included in
-                // some versions of the Id Anthology fixed this.
-                //
-                // [JN] Fix behavior, safe for demos.
-                // https://doomwiki.org/wiki/Final_Doom_teleporters_do_not_set_Z_coordinate
-                if (gameversion != exe_final || (singleplayer && !strict_mode && !vanillaparm))
-                {
-                    thing->z = thing->floorz;
-                }
-
-                if (thing->player)
-                {
-                    thing->player->viewz = thing->z+thing->player->viewheight;
-                    thing->player->lookdir = 0;
-                }
-
-                // Spawn teleport fog at source and destination.
-                fog = P_SpawnMobj (oldx, oldy, oldz, MT_TFOG);
-                S_StartSound (fog, sfx_telept);
-                an = m->angle >> ANGLETOFINESHIFT;
-                fog = P_SpawnMobj (m->x+20*finecosine[an], m->y+20*finesine[an], thing->z, MT_TFOG);
-
-                // Emit sound, where?
-                S_StartSound (fog, sfx_telept);
-
-                // Don't move for a bit.
-                // [JN] Press Beta telepoters doesn't have this delay.
-                if (thing->player && gamemode != pressbeta)
-                {
-                    thing->reactiontime = 18;
-                }
-
-                thing->angle = m->angle;
-                thing->momx = thing->momy = thing->momz = 0;
-
-                return 1;
+            // Not a teleportman.
+            if (m->type != MT_TELEPORTMAN)
+            {
+                continue;
+            }
+
+            sector = m->subsector->sector;
+
+            // Wrong sector.
+            if (sector-sectors != i)
+            {
+                continue;
+            }
+
+            oldx = thing->x;
+            oldy = thing->y;
+            oldz = thing->z;
+
+            if (!P_TeleportMove (thing, m->x, m->y))
+            {
+                return 0;
             }
+
+            // The first Final Doom executable does not set thing->z
+            // when teleporting. This quirk is unique to this
+            // particular version; the later version included in
+            // some versions of the Id Anthology fixed this.
+            //
+            // [JN] Fix behavior, safe for demos.
+            // https://doomwiki.org/wiki/Final_Doom_teleporters_do_not_set_Z_coordinate
+            if (gameversion != exe_final || (singleplayer && !strict_mode && !vanillaparm))
+            {
+                thing->z = thing->floorz;
+            }
+
+            if (thing->player)
+            {
+                thing->player->viewz = thing->z+thing->player->viewheight;
+                thing->player->lookdir = 0;
+            }
+
+            // Spawn teleport fog at source and destination.
+            fog = P_SpawnMobj (oldx, oldy, oldz, MT_TFOG);
+            S_StartSound (fog, sfx_telept);
+            an = m->angle >> ANGLETOFINESHIFT;
+            fog = P_SpawnMobj (m->x+20*finecosine[an], m->y+20*finesine[an], thing->z, MT_TFOG);
+
+            // Emit sound, where?
+            S_StartSound (fog, sfx_telept);
+
+            // Don't move for a bit.
+            // [JN] Press Beta telepoters doesn't have this delay.
+            if (thing->player && gamemode != pressbeta)
+            {
+                thing->reactiontime = 18;
+            }
+
+            thing->angle = m->angle;
+            thing->momx = thing->momy = thing->momz = 0;
+
+            return 1;
         }
     }
 
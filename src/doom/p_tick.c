@@ -21,6 +21,8 @@
 
 #include <stdlib.h>
 #include "z_zone.h"
+#include "m_random.h"
+#include "m_prof.h"
 #include "p_local.h"
 #include "doomstat.h"
 #include "jn.h"
@@ -72,6 +74,19 @@ void P_RemoveThinker (thinker_t *thinker)
     thinker->function.acv = (actionf_v)(-1);
 }
 
+// -----------------------------------------------------------------------------
+// P_RunThinker
+// [JN] Runs a single thinker, timed if profiling.
+// -----------------------------------------------------------------------------
+
+static void P_RunThinker (thinker_t *thinker)
+{
+    M_PROFCALL(PROF_THINKER, thinker->function.acp1,
+               thinker->function.acp1 == (actionf_p1) P_MobjThinker ?
+               ((mobj_t *) thinker)->type : -1,
+               thinker->function.acp1(thinker));
+}
+
 // -----------------------------------------------------------------------------
 // P_RunThinkers
 // [JN] Additionally, animate flickering and glowing effect for brightmaps.
@@ -103,7 +118,7 @@ void P_RunThinkers (void)
         {
             if (currentthinker->function.acp1)
                 if (currentthinker->function.acp1 == (actionf_p1)P_MobjThinker)
-                    currentthinker->function.acp1 (currentthinker);
+                    P_RunThinker (currentthinker);
 
             nextthinker = currentthinker->next;
             currentthinker = nextthinker;
@@ -168,14 +183,14 @@ void P_RunThinkers (void)
             {
                 if (currentthinker->function.acp1)
                     if (currentthinker->function.acp1 != (actionf_p1)P_MobjThinker)
-                        currentthinker->function.acp1 (currentthinker);
+                        P_RunThinker (currentthinker);
 
                 nextthinker = currentthinker->next;
             }
             else
             {
                 if (currentthinker->function.acp1)
-                    currentthinker->function.acp1 (currentthinker);
+                    P_RunThinker (currentthinker);
 
                 nextthinker = currentthinker->next;
             }
@@ -233,10 +248,14 @@ void P_Ticker (void)
         return;
     }
 
+    // [JN] Don't keep sight checks of the previous tic.
+    sightstamp++;
+
     for (i=0 ; i < MAXPLAYERS ; i++)
         if (playeringame[i])
             P_PlayerThink (&players[i]);
 
+    P_PrefetchSight();
     P_RunThinkers();
     P_UpdateSpecials();
     P_RespawnSpecials();
@@ -244,3 +263,78 @@ void P_Ticker (void)
     // For par times.
     leveltime++;	
 }
+
+// -----------------------------------------------------------------------------
+// P_StateHash
+// [JN] Hash of the play simulation, to compare runs of the same demo,
+// e.g. with and without -sightthreads. Everything a desync would show
+// up in: things, sectors, players and the random index.
+// -----------------------------------------------------------------------------
+
+#define STATEHASH(h, v)  ((h) = ((h) ^ (unsigned int) (v)) * 16777619u)
+
+unsigned int P_StateHash (void)
+{
+    unsigned int hash = 2166136261u;
+    thinker_t *th;
+    int i, j;
+
+    STATEHASH(hash, leveltime);
+    STATEHASH(hash, prndindex);
+
+    for (th = thinkercap.next ; th != &thinkercap ; th = th->next)
+    {
+        const mobj_t *mo = (const mobj_t *) th;
+
+        if (th->function.acp1 != (actionf_p1) P_MobjThinker)
+        {
+            continue;
+        }
+
+        STATEHASH(hash, mo->type);
+        STATEHASH(hash, mo->x);
+        STATEHASH(hash, mo->y);
+        STATEHASH(hash, mo->z);
+        STATEHASH(hash, mo->momx);
+        STATEHASH(hash, mo->momy);
+        STATEHASH(hash, mo->momz);
+        STATEHASH(hash, mo->angle);
+        STATEHASH(hash, mo->flags);
+        STATEHASH(hash, mo->health);
+        STATEHASH(hash, mo->state - states);
+        STATEHASH(hash, mo->tics);
+        STATEHASH(hash, mo->movedir);
+        STATEHASH(hash, mo->movecount);
+        STATEHASH(hash, mo->reactiontime);
+        STATEHASH(hash, mo->threshold);
+        STATEHASH(hash, mo->target ? mo->target->type + 1 : 0);
+    }
+
+    for (i = 0 ; i < numsectors ; i++)
+    {
+        STATEHASH(hash, sectors[i].floorheight);
+        STATEHASH(hash, sectors[i].ceilingheight);
+        STATEHASH(hash, sectors[i].lightlevel);
+        STATEHASH(hash, sectors[i].special);
+    }
+
+    for (i = 0 ; i < MAXPLAYERS ; i++)
+    {
+        if (!playeringame[i])
+        {
+            continue;
+        }
+
+        STATEHASH(hash, players[i].health);
+        STATEHASH(hash, players[i].armorpoints);
+        STATEHASH(hash, players[i].readyweapon);
+        STATEHASH(hash, players[i].killcount);
+
+        for (j = 0 ; j < NUMAMMO ; j++)
+        {
+            STATEHASH(hash, players[i].ammo[j]);
+        }
+    }
+
+    return hash;
+}
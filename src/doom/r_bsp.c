@@ -22,6 +22,7 @@
 #include <stdlib.h>
 #include "m_bbox.h"
 #include "i_system.h"
+#include "z_zone.h"
 #include "r_local.h"
 #include "doomstat.h"
 #include "jn.h"
@@ -488,34 +489,331 @@ static void R_Subsector (const int num)
     }
 }
 
+// -----------------------------------------------------------------------------
+// [JN] Packed BSP nodes for rendering. Each node holds its partition line,
+// with the integer deltas R_PointOnSide needs already shifted, both
+// child bounding boxes and children in exactly one 64 byte cache line.
+// Nodes are stored in depth first order, front (0) child first, so that
+// descending the tree mostly walks forward in memory.
+// -----------------------------------------------------------------------------
+
+typedef struct
+{
+    fixed_t x, y, dx, dy;
+    fixed_t dxi, dyi;      // dx>>FRACBITS, dy>>FRACBITS
+    int     children[2];   // packed node number, or NF_SUBSECTOR | subsector
+    fixed_t bbox[2][4];
+} bspnode_t;
+
+#define BSPNODE_ALIGN 64
+
+#if defined(__GNUC__)
+#define R_PrefetchNode(n) __builtin_prefetch(n)
+#else
+#define R_PrefetchNode(n)
+#endif
+
+static bspnode_t *bspnodes;
+static int       *bspnodemap;   // nodes[] number to bspnodes[] number
+static int       *bspstack;     // back sides left to visit
+
+// [JN] Parents of packed nodes and subsectors, and packed nodes having
+// a subsector of the current PVS row below them.
+static int        *bspparent;
+static int        *bspleafparent;
+static byte       *bspinpvs;
+static const byte *bsppvs;
+
+// -----------------------------------------------------------------------------
+// R_InitBSPNodes
+// [JN] Builds packed nodes from nodes[], called once per level after
+// the nodes are loaded. The tree is walked without recursion, as
+// degenerate node builds may be thousands of levels deep.
+// -----------------------------------------------------------------------------
+
+void R_InitBSPNodes (void)
+{
+    byte *mem;
+    int   i, sp, next;
+    int  *stack;
+
+    bspnodes = NULL;
+    bsppvs = NULL;
+
+    if (numnodes <= 0)
+    {
+        return;
+    }
+
+    mem = Z_Malloc(numnodes * sizeof(*bspnodes) + BSPNODE_ALIGN, PU_LEVEL, 0);
+    bspnodes = (bspnode_t *) (((uintptr_t) mem + BSPNODE_ALIGN - 1) & ~(uintptr_t) (BSPNODE_ALIGN - 1));
+    bspnodemap = Z_Malloc(numnodes * sizeof(*bspnodemap), PU_LEVEL, 0);
+
+    // Each node on the path from the root leaves at most one back side.
+    bspstack = Z_Malloc(numnodes * sizeof(*bspstack), PU_LEVEL, 0);
+
+    bspparent = Z_Malloc(numnodes * sizeof(*bspparent), PU_LEVEL, 0);
+    bspleafparent = Z_Malloc(numsubsectors * sizeof(*bspleafparent), PU_LEVEL, 0);
+    bspinpvs = Z_Malloc(numnodes, PU_LEVEL, 0);
+
+    // Every node reached pushes at most both children.
+    stack = Z_Malloc((numnodes * 2 + 1) * sizeof(*stack), PU_STATIC, 0);
+
+    for (i = 0 ; i < numnodes ; i++)
+    {
+        bspnodemap[i] = -1;
+        bspparent[i] = -1;
+    }
+
+    for (i = 0 ; i < numsubsectors ; i++)
+    {
+        bspleafparent[i] = -1;
+    }
+
+    // Assign depth first numbers, child 0 first.
+    next = 0;
+    sp = 0;
+    stack[sp++] = numnodes - 1;
+
+    while (sp)
+    {
+        const int n = stack[--sp];
+
+        if (bspnodemap[n] != -1)
+        {
+            continue; // Broken node build, shared child.
+        }
+
+        bspnodemap[n] = next++;
+
+        for (i = 1 ; i >= 0 ; i--)
+        {
+            const int child = nodes[n].children[i];
+
+            if (!(child & NF_SUBSECTOR) && bspnodemap[child] == -1)
+            {
+                stack[sp++] = child;
+            }
+        }
+    }
+
+    Z_Free(stack);
+
+    // Fill packed nodes. Nodes out of reach of the root are never drawn.
+    for (i = 0 ; i < numnodes ; i++)
+    {
+        const node_t *node = &nodes[i];
+        bspnode_t *bsp;
+        int side;
+
+        if (bspnodemap[i] == -1)
+        {
+            continue;
+        }
+
+        bsp = &bspnodes[bspnodemap[i]];
+        bsp->x = node->x;
+        bsp->y = node->y;
+        bsp->dx = node->dx;
+        bsp->dy = node->dy;
+        bsp->dxi = node->dx >> FRACBITS;
+        bsp->dyi = node->dy >> FRACBITS;
+        memcpy(bsp->bbox, node->bbox, sizeof(bsp->bbox));
+
+        for (side = 0 ; side < 2 ; side++)
+        {
+            const int child = node->children[side];
+
+            bsp->children[side] = child & NF_SUBSECTOR ? child : bspnodemap[child];
+
+            if (!(child & NF_SUBSECTOR))
+            {
+                bspparent[bspnodemap[child]] = bspnodemap[i];
+            }
+            else if ((child & ~NF_SUBSECTOR) < numsubsectors)
+            {
+                bspleafparent[child & ~NF_SUBSECTOR] = bspnodemap[i];
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// R_MarkPVSNodes
+// [JN] Marks packed nodes having a subsector of PVS row "pvs" below them,
+// walking up from every such subsector. Only done when the view moves
+// into another subsector.
+// -----------------------------------------------------------------------------
+
+static void R_MarkPVSNodes (const byte *pvs)
+{
+    int i;
+
+    if (pvs == bsppvs)
+    {
+        return;
+    }
+
+    bsppvs = pvs;
+
+    if (!pvs)
+    {
+        return;
+    }
+
+    memset(bspinpvs, 0, numnodes);
+
+    for (i = 0 ; i < numsubsectors ; i++)
+    {
+        if (pvs[i >> 3] & (1 << (i & 7)))
+        {
+            int n = bspleafparent[i];
+
+            while (n != -1 && !bspinpvs[n])
+            {
+                bspinpvs[n] = 1;
+                n = bspparent[n];
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// R_ChildInPVS
+// [JN] Tells if a packed node child may be seen with PVS row "pvs".
+// -----------------------------------------------------------------------------
+
+static inline boolean R_ChildInPVS (const byte *pvs, const int child)
+{
+    if (child & NF_SUBSECTOR)
+    {
+        const int leaf = child == -1 ? 0 : child & ~NF_SUBSECTOR;
+
+        return (pvs[leaf >> 3] & (1 << (leaf & 7))) != 0;
+    }
+
+    return bspinpvs[child];
+}
+
+// -----------------------------------------------------------------------------
+// R_PointOnBSPSide
+// Same as R_PointOnSide, for packed nodes.
+// -----------------------------------------------------------------------------
+
+static inline int R_PointOnBSPSide (fixed_t x, fixed_t y, const bspnode_t *node)
+{
+    if (!node->dx)
+    {
+        return x <= node->x ? node->dy > 0 : node->dy < 0;
+    }
+
+    if (!node->dy)
+    {
+        return y <= node->y ? node->dx < 0 : node->dx > 0;
+    }
+
+    x -= node->x;
+    y -= node->y;
+
+    // Try to quickly decide by looking at sign bits.
+    if ((node->dy ^ node->dx ^ x ^ y) < 0)
+    {
+        return (node->dy ^ x) < 0;  // (left is negative)
+    }
+
+    return FixedMul(y, node->dxi) >= FixedMul(node->dyi, x);
+}
+
 // -----------------------------------------------------------------------------
 // RenderBSPNode
-// Renders all subsectors below a given node, traversing subtree recursively.
+// Renders all subsectors below a given node, traversing subtree.
 // Just call with BSP root.
 //
 // [JN] killough 5/2/98: reformatted, removed tail recursion
+// [JN] Walks packed nodes with an explicit stack of back sides still
+// to be checked, visiting subsectors in the same order as recursion.
+// With the PVS on, subtrees out of the view subsector's row are skipped.
 // -----------------------------------------------------------------------------
 
 void R_RenderBSPNode (int bspnum)
 {
-    while (!(bspnum & NF_SUBSECTOR))  // Found a subsector?
+    const byte *pvs;
+    boolean culled;
+    int sp = 0;
+
+    if (!(bspnum & NF_SUBSECTOR))
     {
-        const node_t *bsp = &nodes[bspnum];
+        if (!bspnodes)
+        {
+            return;
+        }
+        bspnum = bspnodemap[bspnum];
+    }
 
-        // Decide which side the view point is on.
-        int side = R_PointOnSide(viewx, viewy, bsp);
+    pvs = R_PVSForView(viewx, viewy);
+    R_MarkPVSNodes(pvs);
 
-        // Recursively divide front space.
-        R_RenderBSPNode(bsp->children[side]);
+    while (true)
+    {
+        culled = false;
 
-        // Possibly divide back space.
-        if (!R_CheckBBox(bsp->bbox[side^1]))
+        while (!(bspnum & NF_SUBSECTOR))  // Found a subsector?
         {
-            return;
+            const bspnode_t *bsp = &bspnodes[bspnum];
+
+            // Decide which side the view point is on.
+            const int side = R_PointOnBSPSide(viewx, viewy, bsp);
+            const int back = bsp->children[side^1];
+
+            // Back side is visited after the front space,
+            // start loading it in the meantime.
+            if (!(back & NF_SUBSECTOR))
+            {
+                R_PrefetchNode(&bspnodes[back]);
+            }
+
+            // Divide front space, remember back space.
+            bspstack[sp++] = (bspnum << 1) | side;
+            bspnum = bsp->children[side];
+
+            if (pvs && !R_ChildInPVS(pvs, bspnum))
+            {
+                rendered_pvsculled++;
+                culled = true;
+                break;
+            }
         }
 
-        bspnum = bsp->children[side^1];
-    }
+        if (!culled)
+        {
+            R_Subsector(bspnum == -1 ? 0 : bspnum & ~NF_SUBSECTOR);
+        }
+
+        // Possibly divide back space of the nearest node having one.
+        while (true)
+        {
+            const bspnode_t *bsp;
+            int side;
+
+            if (!sp)
+            {
+                return;
+            }
 
-    R_Subsector(bspnum == -1 ? 0 : bspnum & ~NF_SUBSECTOR);
+            bsp = &bspnodes[bspstack[--sp] >> 1];
+            side = bspstack[sp] & 1;
+
+            if (pvs && !R_ChildInPVS(pvs, bsp->children[side^1]))
+            {
+                rendered_pvsculled++;
+                continue;
+            }
+
+            if (R_CheckBBox(bsp->bbox[side^1]))
+            {
+                bspnum = bsp->children[side^1];
+                break;
+            }
+        }
+    }
 }
@@ -96,175 +96,21 @@ const byte         *ds_brightmap;
 // 
 // [crispy] replace R_DrawColumn() with Lee Killough's implementation
 // found in MBF to fix Tutti-Frutti, taken from mbfsrc/R_DRAW.C:99-1979
+//
+// [JN] All the column drawers are generated from the template in
+// r_drawcol.h, one function per combination of options.
 // -----------------------------------------------------------------------------
 
-void R_DrawColumn (void) 
-{ 
-    int      count = dc_yh - dc_yl;
-    byte    *dest;
-    fixed_t  frac, fracstep;
-
-    // Zero length, column does not exceed a pixel.
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK
-    if ((unsigned)dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawColumn: %i to %i at %i" :
-                 "R_DrawColumn: %i к %i у %i",
-                 dc_yl, dc_yh, dc_x);
-    }
-#endif
-
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-    fracstep = dc_iscale;
-    frac = dc_texturemid + (dc_yl-centery)*fracstep;
-
-    // Inner loop that does the actual texture mapping, e.g. a DDA-lile scaling.
-    // This is as fast as it gets.
-    // [JN] killough 2/1/98: more performance tuning
-    {
-        const byte *source = dc_source;
-        const byte *brightmap = dc_brightmap;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight-1;
-
-        if (dc_texheight & heightmask)  // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-
-            if (frac < 0)
-                while ((frac += heightmask) < 0);
-            else
-                while (frac >= heightmask)
-                    frac -= heightmask;
-
-            do
-            {
-                // Re-map color indices from wall texture column
-                //  using a lighting/special effects LUT.
-                // [JN] heightmask is the Tutti-Frutti fix -- killough
-                // [crispy] brightmaps
-                const byte src = source[frac>>FRACBITS];
-
-                *dest = colormap[brightmap[src]][src];
-                dest += screenwidth;
-                if ((frac += fracstep) >= heightmask)
-                {
-                    frac -= heightmask;
-                }
-            } while (count--);
-        }
-        else  // texture height is a power of 2 -- killough
-        {
-            do 
-            {
-                // Re-map color indices from wall texture column
-                //  using a lighting/special effects LUT.
-                // [crispy] brightmaps
-                const byte src = source[(frac>>FRACBITS)&heightmask];
-
-                *dest = colormap[brightmap[src]][src];
-                dest += screenwidth; 
-                frac += fracstep;
-            } while (count--); 
-        }
-    }
-}
-
-
-void R_DrawColumnLow (void) 
-{ 
-    int       x;
-    int       count = dc_yh - dc_yl; 
-    byte     *dest1, *dest2, *dest3, *dest4;
-    fixed_t   frac, fracstep;
-
-    // Zero length.
-    if (count < 0)
-    {
-        return; 
-    }
-
-    // Blocky mode, need to multiply by 2.
-    x = dc_x << 1;
-
-#ifdef RANGECHECK 
-    if ((unsigned)dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawColumnLow: %i to %i at %i" :
-                 "R_DrawColumnLow: %i к %i у %i",
-                 dc_yl, dc_yh, dc_x);
-    }
-#endif 
-
-    dest1 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
-    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x+1]];
-    dest3 = ylookup[(dc_yl << hires)+1] + columnofs[flipviewwidth[x]];
-    dest4 = ylookup[(dc_yl << hires)+1] + columnofs[flipviewwidth[x+1]];
-    fracstep = dc_iscale; 
-    frac = dc_texturemid + (dc_yl-centery)*fracstep;
-
-    // Inner loop that does the actual texture mapping, e.g. a DDA-lile scaling.
-    {
-        const byte *source = dc_source;
-        const byte *brightmap = dc_brightmap;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight-1;
-
-        if (dc_texheight & heightmask) // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-
-            if (frac < 0)
-                while ((frac += heightmask) < 0);
-            else
-                while (frac >= heightmask)
-                    frac -= heightmask;
-
-            do
-            {
-                // [crispy] brightmaps
-                const byte src = source[frac>>FRACBITS];
-                *dest4 = *dest3 = *dest2 = *dest1 = colormap[brightmap[src]][src];
-
-                dest1 += screenwidth_low;
-                dest2 += screenwidth_low;
-                dest3 += screenwidth_low;
-                dest4 += screenwidth_low;
-
-                if ((frac += fracstep) >= heightmask)
-                {
-                    frac -= heightmask;
-                }
-            } while (count--);
-        }
-        else // texture height is a power of 2 -- killough
-        {
-            do 
-            {
-                // [crispy] brightmaps
-                const byte src = source[(frac>>FRACBITS)&heightmask];
-                *dest4 = *dest3 = *dest2 = *dest1 = colormap[brightmap[src]][src];
-
-                dest1 += screenwidth_low;
-                dest2 += screenwidth_low;
-                dest3 += screenwidth_low;
-                dest4 += screenwidth_low;
-
-                frac += fracstep; 
+#define COLFUNC   R_DrawColumn
+#define COLWRAP   1
+#define COLBRIGHT 1
+#include "r_drawcol.h"
 
-            } while (count--);
-        }
-    }
-}
+#define COLFUNC   R_DrawColumnLow
+#define COLLOW    1
+#define COLWRAP   1
+#define COLBRIGHT 1
+#include "r_drawcol.h"
 
 // -----------------------------------------------------------------------------
 // Framebuffer postprocessing.
@@ -284,693 +130,90 @@ void R_SetFuzzPosDraw (void)
 	fuzzpos = fuzzpos_tic;
 }
 
-// -----------------------------------------------------------------------------
-// [JN] Fuzz effect, original version (improved_fuzz = 0)
-// -----------------------------------------------------------------------------
-
-void R_DrawFuzzColumn (void) 
-{ 
-    int      count;
-    byte    *dest;
-    boolean  cutoff = false;
-
-    // Adjust borders. Low... 
-    if (!dc_yl)
-    {
-        dc_yl = 1;
-    }
-
-    // .. and high.
-    if (dc_yh == viewheight-1) 
-    {
-        dc_yh = viewheight - 2; 
-        cutoff = true;
-    }
-
-    count = dc_yh - dc_yl; 
-
-    // Zero length.
-    if (count < 0)
-    {
-        return; 
-    }
-
-#ifdef RANGECHECK 
-    if ((unsigned)dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawFuzzColumn: %i to %i at %i" :
-                 "R_DrawFuzzColumn: %i к %i у %i", dc_yl, dc_yh, dc_x);
-    }
-#endif
-
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-
-    // Looks like an attempt at dithering, 
-    //  using the colormap #6 (of 0-31, a bit
-    //  brighter than average).
-    do 
-    {
-        // Lookup framebuffer, and retrieve
-        //  a pixel that is either one column
-        //  left or right of the current one.
-        // Add index from colormap to index.
-        *dest = colormaps[6*256+dest[screenwidth*fuzzoffset[fuzzpos]]]; 
-
-        // Clamp table lookup index.
-        if (++fuzzpos == FUZZTABLE)
-        {
-            fuzzpos = 0;
-        }
-
-        dest += screenwidth;
-    } while (count--); 
-
-    // [crispy] if the line at the bottom had to be cut off,
-    // draw one extra line using only pixels of that line and the one above
-    if (cutoff)
-    {
-        *dest = colormaps[6*256+dest[(screenwidth*fuzzoffset[fuzzpos]-screenwidth)/2]];
-    }
-} 
-
-
-// low detail mode version
-void R_DrawFuzzColumnLow (void)
-{
-    int        count;
-    int        x;
-    byte      *dest1, *dest2, *dest3, *dest4;
-    boolean    cutoff = false;
-
-    // Adjust borders. Low...
-    if (!dc_yl)
-    {
-        dc_yl = 1;
-    }
-
-    // .. and high.
-    if (dc_yh == viewheight-1)
-    {
-        dc_yh = viewheight - 2;
-        cutoff = true;
-    }
-
-    count = dc_yh - dc_yl;
 
-    // Zero length.
-    if (count < 0)
-    {
-        return;
-    }
-
-    // low detail mode, need to multiply by 2
-    x = dc_x << 1;
-
-#ifdef RANGECHECK 
-    if ((unsigned)x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawFuzzColumnLow: %i to %i at %i" :
-                 "R_DrawFuzzColumnLow: %i к %i у %i",
-                 dc_yl, dc_yh, dc_x);
-    }
-#endif
+// Darkening colormap of black and white fuzz, green with infrared visor.
+#define FUZZBWMAP (colormaps_rd + (infragreen_visor                              \
+                && players[displayplayer].powers[pw_infrared]                    \
+                && !players[displayplayer].powers[pw_invulnerability] ? 1 : 2) * 256)
 
-    dest1 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
-    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x+1]];
-    dest3 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x]];
-    dest4 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x+1]];
+// Random fuzz restarting point of improved fuzz.
+#define FUZZRANDOM (leveltime > oldleveltime ? Crispy_Random() % 49 : 0)
 
-    do
-    {
-        *dest3 = *dest1 = colormaps[6*256+dest1[screenwidth*fuzzoffset[fuzzpos]]];
-        *dest4 = *dest2 = colormaps[6*256+dest2[screenwidth*fuzzoffset[fuzzpos]]];
-
-        // Clamp table lookup index.
-        if (++fuzzpos == FUZZTABLE)
-        {
-            fuzzpos = 0;
-        }
+// -----------------------------------------------------------------------------
+// [JN] Fuzz effect, original version (improved_fuzz = 0)
+// Uses the colormap #6 (of 0-31, a bit brighter than average).
+// -----------------------------------------------------------------------------
 
-        dest1 += screenwidth_low;
-        dest2 += screenwidth_low;
-        dest3 += screenwidth_low;
-        dest4 += screenwidth_low;
-    } while (count--);
+#define COLFUNC      R_DrawFuzzColumn
+#define COLFUZZ      (colormaps + 6*256)
+#define COLFUZZRESET 0
+#include "r_drawcol.h"
 
-    // [crispy] if the line at the bottom had to be cut off,
-    // draw one extra line using only pixels of that line and the one above
-    if (cutoff)
-    {
-        *dest3 = *dest1 = colormaps[6*256+dest1[(screenwidth*fuzzoffset[fuzzpos]-screenwidth)/2]];
-        *dest4 = *dest2 = colormaps[6*256+dest2[(screenwidth*fuzzoffset[fuzzpos]-screenwidth)/2]];
-    }
-} 
+#define COLFUNC      R_DrawFuzzColumnLow
+#define COLLOW       1
+#define COLFUZZ      (colormaps + 6*256)
+#define COLFUZZRESET 0
+#include "r_drawcol.h"
 
 // -----------------------------------------------------------------------------
 // [JN] Fuzz effect, original version + black and white (improved_fuzz = 1)
 // -----------------------------------------------------------------------------
 
-void R_DrawFuzzColumnBW (void) 
-{ 
-    int      count;
-    byte    *dest;
-    boolean  cutoff = false;
-    const boolean greenfuzz = infragreen_visor
-                            &&  players[displayplayer].powers[pw_infrared]
-                            && !players[displayplayer].powers[pw_invulnerability];
-
-    if (!dc_yl)
-    {
-        dc_yl = 1;
-    }
+#define COLFUNC      R_DrawFuzzColumnBW
+#define COLFUZZ      FUZZBWMAP
+#define COLFUZZRESET 0
+#include "r_drawcol.h"
 
-    if (dc_yh == viewheight-1)
-    {
-        dc_yh = viewheight-2;
-        cutoff = true;
-    }
-
-    count = dc_yh - dc_yl;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK 
-    if ((unsigned)dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawFuzzColumnBW: %i to %i at %i" :
-                 "R_DrawFuzzColumnBW: %i к %i у %i", dc_yl, dc_yh, dc_x);
-    }
-#endif
-
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-
-    do
-    {
-        *dest = colormaps_rd[(greenfuzz ? 1 : 2) * 256
-              + dest[screenwidth*fuzzoffset[fuzzpos]]];
-
-        if (++fuzzpos == FUZZTABLE)
-        fuzzpos = 0;
-
-        dest += screenwidth;
-    } while (count--);
-
-    if (cutoff)
-    {
-        *dest = colormaps_rd[(greenfuzz ? 1 : 2) * 256
-              + dest[(screenwidth*fuzzoffset[fuzzpos]-screenwidth)/2]];
-    }
-}
-
-void R_DrawFuzzColumnLowBW (void)
-{
-    int        count;
-    int        x;
-    byte      *dest1, *dest2, *dest3, *dest4;
-    boolean    cutoff = false;
-    const boolean greenfuzz = infragreen_visor
-                            && players[displayplayer].powers[pw_infrared]
-                            && !players[displayplayer].powers[pw_invulnerability];
-
-    if (!dc_yl)
-    {
-        dc_yl = 1;
-    }
-
-    if (dc_yh == viewheight-1)
-    {
-        dc_yh = viewheight-2;
-        cutoff = true;
-    }
-
-    count = dc_yh - dc_yl;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-    x = dc_x << 1;
-
-#ifdef RANGECHECK 
-    if ((unsigned)x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawFuzzColumnLowBW: %i to %i at %i" :
-                 "R_DrawFuzzColumnLowBW: %i к %i у %i",
-                 dc_yl, dc_yh, dc_x);
-    }
-#endif
-
-    dest1 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
-    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x+1]];
-    dest3 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x]];
-    dest4 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x+1]];
-
-    do 
-    {
-        *dest3 = *dest1 = colormaps_rd[(greenfuzz ? 1 : 2) * 256
-               + dest1[screenwidth*fuzzoffset[fuzzpos]]]; 
-        *dest4 = *dest2 = colormaps_rd[(greenfuzz ? 1 : 2) * 256
-               + dest2[screenwidth*fuzzoffset[fuzzpos]]]; 
-
-        if (++fuzzpos == FUZZTABLE)
-        {
-            fuzzpos = 0;
-        }
-
-        dest1 += screenwidth_low;
-        dest2 += screenwidth_low;
-        dest3 += screenwidth_low;
-        dest4 += screenwidth_low;
-    } while (count--); 
-
-    if (cutoff)
-    {
-        *dest3 = *dest1 = colormaps_rd[(greenfuzz ? 1 : 2) * 256
-               + dest1[(screenwidth*fuzzoffset[fuzzpos]-screenwidth)/2]];
-        *dest4 = *dest2 = colormaps_rd[(greenfuzz ? 1 : 2) * 256
-               + dest2[(screenwidth*fuzzoffset[fuzzpos]-screenwidth)/2]];
-    }
-}
+#define COLFUNC      R_DrawFuzzColumnLowBW
+#define COLLOW       1
+#define COLFUZZ      FUZZBWMAP
+#define COLFUZZRESET 0
+#include "r_drawcol.h"
 
 // -----------------------------------------------------------------------------
 // [JN] Fuzz effect, improved version (improved_fuzz = 2)
 // -----------------------------------------------------------------------------
 
-void R_DrawFuzzColumnImproved (void)
-{
-    int      count;
-    byte    *dest;
-    boolean  cutoff = false;
-
-    if (!dc_yl)
-    {
-        dc_yl = 1;
-    }
-
-    if (dc_yh == viewheight-1)
-    {
-        dc_yh = viewheight-2;
-        cutoff = true;
-    }
-
-    count = dc_yh - dc_yl;
+#define COLFUNC      R_DrawFuzzColumnImproved
+#define COLFUZZ      (colormaps + 6*256)
+#define COLFUZZRESET FUZZRANDOM
+#include "r_drawcol.h"
 
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK 
-    if ((unsigned)dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawFuzzColumnImproved: %i to %i at %i" :
-                 "R_DrawFuzzColumnImproved: %i к %i у %i", dc_yl, dc_yh, dc_x);
-    }
-#endif
-
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-
-    do
-    {
-        *dest = colormaps[6*256+dest[screenwidth*fuzzoffset[fuzzpos]]];
-
-        if (++fuzzpos == FUZZTABLE)
-        {
-            fuzzpos = leveltime > oldleveltime ? Crispy_Random() % 49 : 0;
-        }
-
-        dest += screenwidth;
-    } while (count--);
-
-    if (cutoff)
-    {
-        *dest = colormaps[6*256+dest[(screenwidth*fuzzoffset[fuzzpos]-screenwidth)/2]];
-    }
-} 
-
-void R_DrawFuzzColumnLowImproved (void) 
-{
-    int        count;
-    int        x;
-    byte      *dest1, *dest2, *dest3, *dest4;
-    boolean    cutoff = false;
-
-    if (!dc_yl)
-    {
-        dc_yl = 1;
-    }
-
-    if (dc_yh == viewheight-1)
-    {
-        dc_yh = viewheight-2;
-        cutoff = true;
-    }
-
-    count = dc_yh - dc_yl;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-    x = dc_x << 1;
-
-#ifdef RANGECHECK 
-    if ((unsigned)x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawFuzzColumnLowImproved: %i to %i at %i" :
-                 "R_DrawFuzzColumnLowImproved: %i к %i у %i",
-                 dc_yl, dc_yh, dc_x);
-    }
-#endif
-
-    dest1 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
-    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x+1]];
-    dest3 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x]];
-    dest4 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x+1]];
-
-    do 
-    {
-        *dest3 = *dest1 = colormaps[6*256+dest1[screenwidth*fuzzoffset[fuzzpos]]]; 
-        *dest4 = *dest2 = colormaps[6*256+dest2[screenwidth*fuzzoffset[fuzzpos]]]; 
-
-        if (++fuzzpos == FUZZTABLE)
-        {
-            fuzzpos = leveltime > oldleveltime ? Crispy_Random() % 49 : 0;
-        }
-
-        dest1 += screenwidth_low;
-        dest2 += screenwidth_low;
-        dest3 += screenwidth_low;
-        dest4 += screenwidth_low;
-    } while (count--); 
-
-    if (cutoff)
-    {
-        *dest3 = *dest1 = colormaps[6*256+dest1[(screenwidth*fuzzoffset[fuzzpos]-screenwidth)/2]];
-        *dest4 = *dest2 = colormaps[6*256+dest2[(screenwidth*fuzzoffset[fuzzpos]-screenwidth)/2]];
-    }
-}
+#define COLFUNC      R_DrawFuzzColumnLowImproved
+#define COLLOW       1
+#define COLFUZZ      (colormaps + 6*256)
+#define COLFUZZRESET FUZZRANDOM
+#include "r_drawcol.h"
 
 // -----------------------------------------------------------------------------
 // [JN] Fuzz effect, improved version + black and white (improved_fuzz = 3)
 // -----------------------------------------------------------------------------
 
-void R_DrawFuzzColumnImprovedBW (void)
-{ 
-    int     count;
-    byte   *dest;
-    boolean cutoff = false;
-    const boolean greenfuzz = infragreen_visor
-                            && players[displayplayer].powers[pw_infrared]
-                            && !players[displayplayer].powers[pw_invulnerability];
-
-    if (!dc_yl)
-    {
-        dc_yl = 1;
-    }
-
-    if (dc_yh == viewheight-1)
-    {
-        dc_yh = viewheight-2;
-        cutoff = true;
-    }
-
-    count = dc_yh - dc_yl; 
+#define COLFUNC      R_DrawFuzzColumnImprovedBW
+#define COLFUZZ      FUZZBWMAP
+#define COLFUZZRESET FUZZRANDOM
+#include "r_drawcol.h"
 
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK 
-    if ((unsigned)dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawFuzzColumnImprovedBW: %i to %i at %i" :
-                 "R_DrawFuzzColumnImprovedBW: %i к %i у %i", dc_yl, dc_yh, dc_x);
-    }
-#endif
-
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-
-    do
-    {
-        *dest = colormaps_rd[(greenfuzz ? 1 : 2) * 256+dest[screenwidth*fuzzoffset[fuzzpos]]];
-
-        if (++fuzzpos == FUZZTABLE)
-        {
-            fuzzpos = leveltime > oldleveltime ? Crispy_Random() % 49 : 0;
-        }
-
-        dest += screenwidth;
-    } while (count--); 
-
-    if (cutoff)
-    {
-        *dest = colormaps_rd[(greenfuzz ? 1 : 2) * 256
-              + dest[(screenwidth*fuzzoffset[fuzzpos]-screenwidth)/2]];
-    }
-} 
-
-void R_DrawFuzzColumnLowImprovedBW (void) 
-{
-    int        count;
-    int        x;
-    byte      *dest1, *dest2, *dest3, *dest4;
-    boolean    cutoff = false;
-    const boolean greenfuzz = infragreen_visor
-                            && players[displayplayer].powers[pw_infrared]
-                            && !players[displayplayer].powers[pw_invulnerability];
-
-    if (!dc_yl)
-    {
-        dc_yl = 1;
-    }
-
-    if (dc_yh == viewheight-1)
-    {
-        dc_yh = viewheight-2;
-        cutoff = true;
-    }
-
-    count = dc_yh - dc_yl;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-    x = dc_x << 1;
-
-#ifdef RANGECHECK 
-    if ((unsigned)x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawFuzzColumnLowImprovedBW: %i to %i at %i" :
-                 "R_DrawFuzzColumnLowImprovedBW: %i к %i у %i",
-                 dc_yl, dc_yh, dc_x);
-    }
-#endif
-
-    dest1 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
-    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x+1]];
-    dest3 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x]];
-    dest4 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x+1]];
-
-    do
-    {
-        *dest3 = *dest1 = colormaps_rd[(greenfuzz ? 1 : 2) * 256
-               + dest1[screenwidth*fuzzoffset[fuzzpos]]];
-        *dest4 = *dest2 = colormaps_rd[(greenfuzz ? 1 : 2) * 256
-               + dest2[screenwidth*fuzzoffset[fuzzpos]]];
-
-        if (++fuzzpos == FUZZTABLE)
-        {
-            fuzzpos = leveltime > oldleveltime ? Crispy_Random() % 49 : 0;
-        }
-
-        dest1 += screenwidth_low;
-        dest2 += screenwidth_low;
-        dest3 += screenwidth_low;
-        dest4 += screenwidth_low;
-    } while (count--);
-
-    if (cutoff)
-    {
-        *dest3 = *dest1 = colormaps_rd[(greenfuzz ? 1 : 2) * 256
-              + dest1[(screenwidth*fuzzoffset[fuzzpos]-screenwidth)/2]];
-        *dest4 = *dest2 = colormaps_rd[(greenfuzz ? 1 : 2) * 256
-               + dest2[(screenwidth*fuzzoffset[fuzzpos]-screenwidth)/2]];
-    }
-}
+#define COLFUNC      R_DrawFuzzColumnLowImprovedBW
+#define COLLOW       1
+#define COLFUZZ      FUZZBWMAP
+#define COLFUZZRESET FUZZRANDOM
+#include "r_drawcol.h"
 
 // -----------------------------------------------------------------------------
 // [JN] Fuzz effect, translucent (improved_fuzz = 4)
 // -----------------------------------------------------------------------------
 
-void R_DrawFuzzColumnTranslucent (void)
-{
-    int      count = dc_yh - dc_yl;
-    byte    *dest;
-    fixed_t  frac, fracstep;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK
-    if ((unsigned)dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawFuzzColumnTranslucent: %i to %i at %i" :
-                 "R_DrawFuzzColumnTranslucent: %i к %i у %i",
-                 dc_yl, dc_yh, dc_x);
-    }
-#endif
-
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-    fracstep = dc_iscale;
-    frac = dc_texturemid + (dc_yl-centery)*fracstep;
-
-    {
-        const byte *source = dc_source;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight-1;
-
-        if (dc_texheight & heightmask)   // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-
-            if (frac < 0)
-                while ((frac += heightmask) < 0);
-            else
-                while (frac >= heightmask)
-                    frac -= heightmask;
-
-            do
-            {
-                *dest = transtable30[(*dest<<8)+colormap[0][source[frac>>FRACBITS]]];
-                dest += screenwidth;
-                if ((frac += fracstep) >= heightmask)
-                frac -= heightmask;
-            }
-            while (count--);
-        }
-        else    // texture height is a power of 2 -- killough
-        {
-            do
-            {
-                *dest = transtable30[(*dest<<8)+colormap[0][source[(frac>>FRACBITS)&heightmask]]];
-                dest += screenwidth;
-                frac += fracstep;
-            } while (count--);
-        }
-    }
-}
-
-void R_DrawFuzzColumnTranslucentLow (void)
-{
-    int       x;
-    int       count = dc_yh - dc_yl;
-    byte     *dest1, *dest2, *dest3, *dest4;
-    fixed_t   frac, fracstep;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-    x = dc_x << 1;
-
-#ifdef RANGECHECK
-    if ((unsigned)x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawFuzzColumnTranslucentLow: %i to %i at %i" :
-                 "R_DrawFuzzColumnTranslucentLow: %i к %i у %i",
-                 dc_yl, dc_yh, x);
-    }
-#endif
-
-    dest1 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
-    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x+1]];
-    dest3 = ylookup[(dc_yl << hires)+1] + columnofs[flipviewwidth[x]];
-    dest4 = ylookup[(dc_yl << hires)+1] + columnofs[flipviewwidth[x+1]];
-    fracstep = dc_iscale;
-    frac = dc_texturemid + (dc_yl-centery)*fracstep;
-
-    {
-        const byte *source = dc_source;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight-1;
-
-        if (dc_texheight & heightmask) // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-
-            if (frac < 0)
-                while ((frac += heightmask) < 0);
-            else
-                while (frac >= heightmask)
-                    frac -= heightmask;
-
-            do
-            {
-                const byte src = source[frac>>FRACBITS];
-
-                *dest1 = transtable30[(*dest1<<8)+colormap[0][src]];
-                *dest2 = transtable30[(*dest2<<8)+colormap[0][src]];
-                *dest3 = transtable30[(*dest3<<8)+colormap[0][src]];
-                *dest4 = transtable30[(*dest4<<8)+colormap[0][src]];
-
-                dest1 += screenwidth_low;
-                dest2 += screenwidth_low;
-                dest3 += screenwidth_low;
-                dest4 += screenwidth_low;
-
-                if ((frac += fracstep) >= heightmask)
-                {
-                    frac -= heightmask;
-                }
-            } while (count--);
-        }
-        else // texture height is a power of 2 -- killough
-        {
-            do 
-            {
-                const byte src = source[(frac>>FRACBITS)&heightmask];
-
-                *dest1 = transtable30[(*dest1<<8)+colormap[0][src]];
-                *dest2 = transtable30[(*dest2<<8)+colormap[0][src]];
-                *dest3 = transtable30[(*dest3<<8)+colormap[0][src]];
-                *dest4 = transtable30[(*dest4<<8)+colormap[0][src]];
-
-                dest1 += screenwidth_low;
-                dest2 += screenwidth_low;
-                dest3 += screenwidth_low;
-                dest4 += screenwidth_low;
-
-                frac += fracstep; 
-
-            } while (count--);
-        }
-    }
-}
+#define COLFUNC   R_DrawFuzzColumnTranslucent
+#define COLWRAP   1
+#define COLBLEND  transtable30
+#include "r_drawcol.h"
 
+#define COLFUNC   R_DrawFuzzColumnTranslucentLow
+#define COLLOW    1
+#define COLWRAP   1
+#define COLBLEND  transtable30
+#include "r_drawcol.h"
 
 // -----------------------------------------------------------------------------
 // R_DrawTranslatedColumn
@@ -980,412 +223,48 @@ void R_DrawFuzzColumnTranslucentLow (void)
 // kinda brightened up.
 // -----------------------------------------------------------------------------
 
-void R_DrawTranslatedColumn (void) 
-{ 
-    int      count = dc_yh - dc_yl; 
-    byte    *dest;
-    fixed_t  frac;
-    fixed_t  fracstep;
+#define COLFUNC   R_DrawTranslatedColumn
+#define COLTRANS  1
+#include "r_drawcol.h"
 
-    if (count < 0)
-    {
-        return; 
-    }
-
-#ifdef RANGECHECK 
-    if ((unsigned)dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawColumn: %i to %i at %i" :
-                 "R_DrawColumn: %i к %i у %i",
-                 dc_yl, dc_yh, dc_x);
-    }    
-#endif 
-
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-    fracstep = dc_iscale;
-    frac = dc_texturemid + (dc_yl-centery)*fracstep; 
-
-    // Here we do an additional index re-mapping.
-    do 
-    {
-        // Translation tables are used to map certain colorramps to other ones,
-        // used with PLAY sprites. Thus the "green" ramp of the player 0 sprite
-        // is mapped to gray, red, black/indigo. 
-        *dest = dc_colormap[0][dc_translation[dc_source[frac>>FRACBITS]]];
-        dest += screenwidth;
-	
-        frac += fracstep;
-    } while (count--); 
-} 
-
-// -----------------------------------------------------------------------------
-// R_DrawTranslatedColumnLow
-// -----------------------------------------------------------------------------
-
-void R_DrawTranslatedColumnLow (void) 
-{
-    int     x;
-    int     count = dc_yh - dc_yl; 
-    byte   *dest, *dest2, *dest3, *dest4;
-    fixed_t frac;
-    fixed_t fracstep;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-    x = dc_x << 1;
-
-#ifdef RANGECHECK 
-    if ((unsigned)x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawColumn: %i to %i at %i" :
-                 "R_DrawColumn: %i к %i у %i",
-                 dc_yl, dc_yh, x);
-    }
-#endif 
-
-    dest  = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
-    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x+1]];
-    dest3 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x]];
-    dest4 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x+1]];
-    fracstep = dc_iscale;
-    frac  = dc_texturemid + (dc_yl-centery)*fracstep; 
-
-    // Here we do an additional index re-mapping.
-    do 
-    {
-        *dest4 = *dest3 = *dest2 = *dest = dc_colormap[0][dc_translation[dc_source[frac>>FRACBITS]]];
-        dest  += screenwidth_low;
-        dest2 += screenwidth_low;
-        dest3 += screenwidth_low;
-        dest4 += screenwidth_low;
-
-        frac += fracstep;
-    } while (count--); 
-}
+#define COLFUNC   R_DrawTranslatedColumnLow
+#define COLLOW    1
+#define COLTRANS  1
+#include "r_drawcol.h"
 
 // -----------------------------------------------------------------------------
 // R_DrawTLColumn
 // [crispy] draw translucent column
 // -----------------------------------------------------------------------------
 
-void R_DrawTLColumn (void)
-{
-    int      count = dc_yh - dc_yl;
-    byte    *dest;
-    fixed_t  frac, fracstep;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK
-    if ((unsigned)dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawTLColumn: %i to %i at %i" :
-                 "R_DrawTLColumn: %i к %i у %i",
-                 dc_yl, dc_yh, dc_x);
-    }
-#endif
-
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-    fracstep = dc_iscale; 
-    frac = dc_texturemid + (dc_yl-centery)*fracstep;
-
-    {
-        const byte *source = dc_source;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight-1;
-
-        if (dc_texheight & heightmask)   // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-        
-            if (frac < 0)
-            while ((frac += heightmask) < 0);
-            else
-            while (frac >= heightmask)
-            frac -= heightmask;
-        
-            do
-            {
-                *dest = transtable80[(*dest<<8)+colormap[0][source[frac>>FRACBITS]]];
-                dest += screenwidth;
-                if ((frac += fracstep) >= heightmask)
-                frac -= heightmask;
-            }
-            while (count--);
-        }
-        else    // texture height is a power of 2 -- killough
-        {
-            do
-            {
-                *dest = transtable80[(*dest<<8)+colormap[0][source[frac>>FRACBITS & heightmask]]];
-                dest += screenwidth;
-                frac += fracstep;
-            } while (count--);
-        }
-    }
-}
-
-// -----------------------------------------------------------------------------
-// R_DrawTLColumnLow
-// [crispy] draw translucent column, low-resolution version
-// -----------------------------------------------------------------------------
-
-void R_DrawTLColumnLow (void)
-{
-    int       x;
-    int       count = dc_yh - dc_yl;
-    byte     *dest1, *dest2, *dest3, *dest4;
-    fixed_t   frac, fracstep;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-    x = dc_x << 1;
-
-#ifdef RANGECHECK
-    if ((unsigned)x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawTLColumnLow: %i to %i at %i" :
-                 "R_DrawTLColumnLow: %i к %i у %i",
-                 dc_yl, dc_yh, x);
-    }
-#endif
-
-    dest1 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
-    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x+1]];
-    dest3 = ylookup[(dc_yl << hires)+1] + columnofs[flipviewwidth[x]];
-    dest4 = ylookup[(dc_yl << hires)+1] + columnofs[flipviewwidth[x+1]];
-    fracstep = dc_iscale; 
-    frac  = dc_texturemid + (dc_yl-centery)*fracstep;
+#define COLFUNC   R_DrawTLColumn
+#define COLWRAP   1
+#define COLBLEND  transtable80
+#include "r_drawcol.h"
 
-    {
-        const byte *source = dc_source;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight-1;
-
-        if (dc_texheight & heightmask) // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-    
-            if (frac < 0)
-            while ((frac += heightmask) < 0);
-            else
-            while (frac >= heightmask)
-            frac -= heightmask;
-    
-            do
-            {
-                const byte src = source[frac>>FRACBITS];
-
-                *dest1 = transtable80[(*dest1<<8)+colormap[0][src]];
-                *dest2 = transtable80[(*dest2<<8)+colormap[0][src]];
-                *dest3 = transtable80[(*dest3<<8)+colormap[0][src]];
-                *dest4 = transtable80[(*dest4<<8)+colormap[0][src]];
-                dest1 += screenwidth_low;
-                dest2 += screenwidth_low;
-                dest3 += screenwidth_low;
-                dest4 += screenwidth_low;
-    
-                if ((frac += fracstep) >= heightmask)
-                {
-                    frac -= heightmask;
-                }
-            } while (count--);
-        }
-        else // texture height is a power of 2 -- killough
-        {
-            do 
-            {
-                const byte src = source[(frac>>FRACBITS)&heightmask];
-
-                *dest1 = transtable80[(*dest1<<8)+colormap[0][src]];
-                *dest2 = transtable80[(*dest2<<8)+colormap[0][src]];
-                *dest3 = transtable80[(*dest3<<8)+colormap[0][src]];
-                *dest4 = transtable80[(*dest4<<8)+colormap[0][src]];
-    
-                dest1 += screenwidth_low;
-                dest2 += screenwidth_low;
-                dest3 += screenwidth_low;
-                dest4 += screenwidth_low;
-    
-                frac += fracstep; 
-    
-            } while (count--);
-        }
-    }
-}
+#define COLFUNC   R_DrawTLColumnLow
+#define COLLOW    1
+#define COLWRAP   1
+#define COLBLEND  transtable80
+#include "r_drawcol.h"
 
 // -----------------------------------------------------------------------------
 // R_DrawTranslatedTLColumn
 // [JN] draw translucent, color-translated column
 // -----------------------------------------------------------------------------
 
-void R_DrawTranslatedTLColumn (void)
-{
-    int      count = dc_yh - dc_yl;
-    byte    *dest;
-    fixed_t  frac, fracstep;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK
-    if ((unsigned)dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawTranslatedTLColumn: %i to %i at %i" :
-                 "R_DrawTranslatedTLColumn: %i к %i у %i",
-                 dc_yl, dc_yh, dc_x);
-    }
-#endif
+#define COLFUNC   R_DrawTranslatedTLColumn
+#define COLWRAP   1
+#define COLTRANS  1
+#define COLBLEND  transtable30
+#include "r_drawcol.h"
 
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-    fracstep = dc_iscale; 
-    frac = dc_texturemid + (dc_yl-centery)*fracstep;
-
-    {
-        const byte *translation = dc_translation;
-        const byte *source = dc_source;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight-1;
-
-        if (dc_texheight & heightmask)   // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-        
-            if (frac < 0)
-            while ((frac += heightmask) < 0);
-            else
-            while (frac >= heightmask)
-            frac -= heightmask;
-        
-            do
-            {
-                *dest = transtable30[(*dest<<8)+colormap[0][translation[source[frac>>FRACBITS]]]];
-                dest += screenwidth;
-                if ((frac += fracstep) >= heightmask)
-                frac -= heightmask;
-            }
-            while (count--);
-        }
-        else    // texture height is a power of 2 -- killough
-        {
-            do
-            {
-                *dest = transtable30[(*dest<<8)+colormap[0][translation[source[frac>>FRACBITS & heightmask]]]];
-                dest += screenwidth;
-                frac += fracstep;
-            } while (count--);
-        }
-    }
-}
-
-void R_DrawTranslatedTLColumnLow (void)
-{
-    int       x;
-    int       count = dc_yh - dc_yl;
-    byte     *dest1, *dest2, *dest3, *dest4;
-    fixed_t   frac, fracstep;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-    x = dc_x << 1;
-
-#ifdef RANGECHECK
-    if ((unsigned)x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawTranslatedTLColumnLow: %i to %i at %i" :
-                 "R_DrawTranslatedTLColumnLow: %i к %i у %i",
-                 dc_yl, dc_yh, x);
-    }
-#endif
-
-    dest1 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
-    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x+1]];
-    dest3 = ylookup[(dc_yl << hires)+1] + columnofs[flipviewwidth[x]];
-    dest4 = ylookup[(dc_yl << hires)+1] + columnofs[flipviewwidth[x+1]];
-    fracstep = dc_iscale; 
-    frac  = dc_texturemid + (dc_yl-centery)*fracstep;
-
-    {
-        const byte *translation = dc_translation;
-        const byte *source = dc_source;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight-1;
-
-        if (dc_texheight & heightmask) // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-    
-            if (frac < 0)
-            while ((frac += heightmask) < 0);
-            else
-            while (frac >= heightmask)
-            frac -= heightmask;
-    
-            do
-            {
-                const byte src = translation[source[frac>>FRACBITS]];
-
-                *dest1 = transtable30[(*dest1<<8)+colormap[0][src]];
-                *dest2 = transtable30[(*dest2<<8)+colormap[0][src]];
-                *dest3 = transtable30[(*dest3<<8)+colormap[0][src]];
-                *dest4 = transtable30[(*dest4<<8)+colormap[0][src]];
-                dest1 += screenwidth_low;
-                dest2 += screenwidth_low;
-                dest3 += screenwidth_low;
-                dest4 += screenwidth_low;
-    
-                if ((frac += fracstep) >= heightmask)
-                {
-                    frac -= heightmask;
-                }
-            } while (count--);
-        }
-        else // texture height is a power of 2 -- killough
-        {
-            do 
-            {
-                const byte src = translation[source[(frac>>FRACBITS)&heightmask]];
-
-                *dest1 = transtable30[(*dest1<<8)+colormap[0][src]];
-                *dest2 = transtable30[(*dest2<<8)+colormap[0][src]];
-                *dest3 = transtable30[(*dest3<<8)+colormap[0][src]];
-                *dest4 = transtable30[(*dest4<<8)+colormap[0][src]];
-    
-                dest1 += screenwidth_low;
-                dest2 += screenwidth_low;
-                dest3 += screenwidth_low;
-                dest4 += screenwidth_low;
-    
-                frac += fracstep; 
-    
-            } while (count--);
-        }
-    }
-}
+#define COLFUNC   R_DrawTranslatedTLColumnLow
+#define COLLOW    1
+#define COLWRAP   1
+#define COLTRANS  1
+#define COLBLEND  transtable30
+#include "r_drawcol.h"
 
 // -----------------------------------------------------------------------------
 // R_DrawGhostColumn
@@ -1393,74 +272,16 @@ void R_DrawTranslatedTLColumnLow (void)
 // Used exclusively for ghost monsters, ressurected by Arch-Vile.
 // -----------------------------------------------------------------------------
 
-void R_DrawGhostColumn (void)
-{
-    int      count = dc_yh - dc_yl;
-    byte    *dest;
-    fixed_t  frac, fracstep;
+#define COLFUNC   R_DrawGhostColumn
+#define COLTRANS  1
+#define COLBLEND  transtable50
+#include "r_drawcol.h"
 
-    if (count < 0)
-    {
-        return;
-    }
-
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-    fracstep = dc_iscale;
-    frac = dc_texturemid + (dc_yl-centery)*fracstep;
-
-    do
-    {
-        *dest = transtable50[(*dest<<8)+dc_colormap[0][dc_translation[dc_source[frac>>FRACBITS]]]];
-        dest += screenwidth;
-        frac += fracstep;
-    } while (count--);
-}
-
-// -----------------------------------------------------------------------------
-// R_DrawGhostColumn
-// [JN] Draw translucent (50%) with given color translation (CR_THIRDSATURTION).
-// Low-resolution version.
-// -----------------------------------------------------------------------------
-
-void R_DrawGhostColumnLow (void)
-{
-    int       x;
-    int       count = dc_yh - dc_yl;
-    byte     *dest1, *dest2, *dest3, *dest4;
-    fixed_t   frac, fracstep;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-    x = dc_x << 1;
-
-    dest1 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
-    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x+1]];
-    dest3 = ylookup[(dc_yl << hires)+1] + columnofs[flipviewwidth[x]];
-    dest4 = ylookup[(dc_yl << hires)+1] + columnofs[flipviewwidth[x+1]];
-    fracstep = dc_iscale; 
-    frac = dc_texturemid + (dc_yl-centery)*fracstep;
-
-    do
-    {
-        const lighttable_t *const *colormap = dc_colormap;
-        const byte trans = dc_translation[dc_source[frac>>FRACBITS]];
-
-        *dest1 = transtable50[(*dest1<<8)+colormap[0][trans]];
-        *dest2 = transtable50[(*dest2<<8)+colormap[0][trans]];
-        *dest3 = transtable50[(*dest3<<8)+colormap[0][trans]];
-        *dest4 = transtable50[(*dest4<<8)+colormap[0][trans]];
-
-        dest1 += screenwidth_low;
-        dest2 += screenwidth_low;
-        dest3 += screenwidth_low;
-        dest4 += screenwidth_low;
-
-        frac += fracstep;
-    } while (count--);
-}
+#define COLFUNC   R_DrawGhostColumnLow
+#define COLLOW    1
+#define COLTRANS  1
+#define COLBLEND  transtable50
+#include "r_drawcol.h"
 
 // -----------------------------------------------------------------------------
 // R_DrawSpan 
@@ -107,6 +107,9 @@ typedef	struct
     // mapblock bounding box for height changes
     int     blockbox[4];
 
+    // [JN] bounding box of the lines, for P_ChangeSector
+    fixed_t bbox[4];
+
     // origin for any sounds played by the sector
     degenmobj_t soundorg;
 
@@ -474,10 +477,43 @@ extern boolean       markceiling;
 
 void R_ClearClipSegs (void);
 void R_ClearDrawSegs (void);
+void R_InitBSPNodes (void);
 void R_InitClipSegs (void);
 void R_RenderBSPNode (int bspnum);
 void R_StoreWallRange (const int start, const int stop);
 
+// -----------------------------------------------------------------------------
+// R_PVS
+// -----------------------------------------------------------------------------
+
+extern boolean pvs_active;
+
+const byte *R_PVSForView (fixed_t x, fixed_t y);
+void R_InitPVS (void);
+
+// -----------------------------------------------------------------------------
+// R_STATS
+// -----------------------------------------------------------------------------
+
+typedef enum
+{
+    RSTAGE_BSP,
+    RSTAGE_PLANES,
+    RSTAGE_MASKED,
+    RSTAGE_TOTAL,
+    NUMRENDERSTAGES
+} renderstage_t;
+
+extern int rendered_segs, rendered_visplanes, rendered_vissprites, rendered_pvsculled;
+extern int rendered_drawsegs;
+extern int rendered_colpixels, rendered_spanpixels, rendered_maskedpixels;
+extern uint64_t rendered_stagetime[NUMRENDERSTAGES];
+
+void R_BeginStage (const renderstage_t stage);
+void R_ClearStats (void);
+void R_EndStage (const renderstage_t stage);
+void R_InitStats (void);
+
 // -----------------------------------------------------------------------------
 // R_DATA
 // -----------------------------------------------------------------------------
@@ -584,7 +620,6 @@ extern fixed_t viewcos, viewsin;
 extern int centerx, centery;
 extern int extralight;
 extern int maxlightz, lightzshift;
-extern int rendered_segs, rendered_visplanes, rendered_vissprites;
 extern int skyflatnum, skytexture, skytexturemid;
 extern int validcount;
 extern int viewwindowx, viewwindowy;
@@ -603,7 +638,6 @@ extern void (*spanfunc) (fixed_t x1, fixed_t x2, fixed_t y,
                          fixed_t ds_xfrac, const fixed_t ds_xstep,
                          fixed_t ds_yfrac, const fixed_t ds_ystep);
 extern void R_InitLightTables (void);
-extern void R_ClearStats (void);
 
 angle_t R_InterpolateAngle(angle_t oangle, angle_t nangle, fixed_t scale);
 angle_t R_PointToAngle (fixed_t x, fixed_t y);
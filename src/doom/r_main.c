@@ -35,8 +35,6 @@
 // [JN] Will be false if modified PLAYPAL lump is loaded.
 boolean original_playpal = true;
 
-// [JN] Used by perfomance counter.
-int rendered_segs, rendered_visplanes, rendered_vissprites;
 
 int           viewangleoffset;
 int           validcount = 1;   // increment every time a check is made
@@ -765,6 +763,7 @@ void R_Init (void)
         original_playpal = false;
     }
 
+    R_InitStats ();
     R_InitClipSegs ();
     R_InitSpritesRes ();
     R_InitPlanesRes ();
@@ -935,23 +934,13 @@ static void R_SetupFrame (player_t *player)
     validcount++;
 }
 
-// -----------------------------------------------------------------------------
-// R_ClearStats
-// -----------------------------------------------------------------------------
-
-void R_ClearStats (void)
-{
-    rendered_segs = 0;
-    rendered_visplanes = 0;
-    rendered_vissprites = 0;
-}
-
 // -----------------------------------------------------------------------------
 // R_RenderView
 // -----------------------------------------------------------------------------
 
 void R_RenderPlayerView (player_t *player)
 {
+    R_BeginStage (RSTAGE_TOTAL);
     R_SetupFrame (player);
 
     // Clear buffers.
@@ -959,7 +948,10 @@ void R_RenderPlayerView (player_t *player)
     R_ClearDrawSegs ();
     if (automapactive && !automap_overlay)
     {
+        R_BeginStage (RSTAGE_BSP);
         R_RenderBSPNode (numnodes-1);
+        R_EndStage (RSTAGE_BSP);
+        R_EndStage (RSTAGE_TOTAL);
         return;
     }
 
@@ -972,6 +964,7 @@ void R_RenderPlayerView (player_t *player)
     if (singleplayer && player->playerstate == PST_DEAD
     &&  player->viewz < player->mo->floorz)
     {
+        R_EndStage (RSTAGE_TOTAL);
         return;
     }
 
@@ -985,12 +978,17 @@ void R_RenderPlayerView (player_t *player)
     R_InterpolateTextureOffsets();
 
     // The head node is the last node output.
+    R_BeginStage (RSTAGE_BSP);
     R_RenderBSPNode (numnodes-1);
+    R_EndStage (RSTAGE_BSP);
+    rendered_drawsegs = ds_p - drawsegs;
 
     // Check for new console commands.
     NetUpdate ();
 
+    R_BeginStage (RSTAGE_PLANES);
     R_DrawPlanes ();
+    R_EndStage (RSTAGE_PLANES);
 
     // Check for new console commands.
     NetUpdate ();
@@ -1002,8 +1000,11 @@ void R_RenderPlayerView (player_t *player)
         R_SetFuzzPosDraw();
     }
 
+    R_BeginStage (RSTAGE_MASKED);
     R_DrawMasked ();
+    R_EndStage (RSTAGE_MASKED);
 
     // Check for new console commands.
     NetUpdate ();				
+    R_EndStage (RSTAGE_TOTAL);
 }
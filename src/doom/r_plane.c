@@ -45,6 +45,11 @@ static visplane_t *freetail;                 // [JN] killough
 static visplane_t **freehead = &freetail;    // [JN] killough
 visplane_t *floorplane, *ceilingplane;
 
+// [JN] Visplanes used in current frame, in order of creation,
+// so they can be drawn and freed without walking all hash slots.
+static visplane_t **usedplanes;
+static int numusedplanes, maxusedplanes;
+
 // [JN] killough -- hash function for visplanes
 // Empirically verified to be fairly uniform:
 
@@ -86,6 +91,7 @@ static fixed_t cachedheight[MAXHEIGHT];
 static fixed_t cacheddistance[MAXHEIGHT];
 static fixed_t cachedxstep[MAXHEIGHT];
 static fixed_t cachedystep[MAXHEIGHT];
+static unsigned cachedlightindex[MAXHEIGHT];
 
 // [JN] Andrey Budko: resolution limitation is removed
 fixed_t *yslope = NULL;
@@ -135,6 +141,7 @@ void R_InitVisplanesRes (void)
 {
     freetail = NULL;
     freehead = &freetail;
+    numusedplanes = 0;
 
     for (int i = 0; i < MAXVISPLANES; i++)
     {
@@ -178,18 +185,29 @@ static void R_MapPlane (const int y, const int x1, const int x2)
         return;
     }
 
+    // [JN] Row values only depend on the plane height, and visplanes are
+    // drawn sorted by height, so they are shared by all planes at it.
     if (planeheight != cachedheight[y])
     {
         cachedheight[y] = planeheight;
         distance = cacheddistance[y] = FixedMul (planeheight, yslope[y]);
         ds_xstep = cachedxstep[y] = FixedMul (viewsin, planeheight) / dy;
         ds_ystep = cachedystep[y] = FixedMul (viewcos, planeheight) / dy;
+
+        // [JN] Note: no smoother diminished lighting in -vanilla mode
+        index = distance >> lightzshift;
+
+        if (index >= maxlightz)
+            index = maxlightz-1;
+
+        cachedlightindex[y] = index;
     }
     else
     {
         distance = cacheddistance[y];
         ds_xstep = cachedxstep[y];
         ds_ystep = cachedystep[y];
+        index = cachedlightindex[y];
     }
 
     dx = x1 - centerx;
@@ -204,18 +222,13 @@ static void R_MapPlane (const int y, const int x1, const int x2)
     }
     else
     {
-        // [JN] Note: no smoother diminished lighting in -vanilla mode
-        index = distance >> lightzshift;
-
-        if (index >= maxlightz)
-            index = maxlightz-1;
-
         ds_colormap[0] = planezlight[index];
         ds_colormap[1] = colormaps;
     }
 
     // high or low detail
     spanfunc (x1, x2, y, ds_xfrac, ds_xstep, ds_yfrac, ds_ystep);
+    rendered_spanpixels += x2 - x1 + 1;
 }
 
 // -----------------------------------------------------------------------------
@@ -234,9 +247,16 @@ void R_ClearPlanes (void)
         ceilingclip[i] = -1;
     }
 
-    for (i = 0; i < MAXVISPLANES; i++)  // [JN] new code -- killough
-        for (*freehead = visplanes[i], visplanes[i] = NULL ; *freehead ; )
-            freehead = &(*freehead)->next;
+    // [JN] new code -- killough
+    // Move used visplanes to the free list and empty the hash slots.
+    for (i = 0 ; i < numusedplanes ; i++)
+    {
+        *freehead = usedplanes[i];
+        freehead = &usedplanes[i]->next;
+    }
+    *freehead = NULL;
+    numusedplanes = 0;
+    memset(visplanes, 0, sizeof(visplanes));
 
     lastopening = openings;
 
@@ -265,9 +285,31 @@ static visplane_t *new_visplane (unsigned const int hash)
     check->next = visplanes[hash];
     visplanes[hash] = check;
 
+    if (numusedplanes == maxusedplanes)
+    {
+        maxusedplanes = maxusedplanes ? maxusedplanes * 2 : 128;
+        usedplanes = I_Realloc(usedplanes, maxusedplanes * sizeof(*usedplanes));
+    }
+    usedplanes[numusedplanes++] = check;
+
     return check;
 }
 
+// -----------------------------------------------------------------------------
+// R_ClearPlaneColumns
+// [JN] Marks columns start...stop of the plane as empty. Top values are
+// only kept valid within [minx, maxx], so instead of clearing the whole
+// array for every new plane, only the columns its range grows by are.
+// -----------------------------------------------------------------------------
+
+static void R_ClearPlaneColumns (visplane_t *pl, const int start, const int stop)
+{
+    if (start <= stop)
+    {
+        memset(pl->top + start, 0xff, (stop - start + 1) * sizeof(*pl->top));
+    }
+}
+
 // -----------------------------------------------------------------------------
 // R_FindPlane
 // -----------------------------------------------------------------------------
@@ -303,8 +345,6 @@ visplane_t *R_FindPlane (fixed_t height, const int picnum, const int lightlevel,
     check->minx = screenwidth;
     check->maxx = -1;
 
-    memset(check->top, UINT_MAX, sizeof(check->top));
-
     return check;
 }
 
@@ -323,7 +363,7 @@ visplane_t *R_DupPlane(const visplane_t *pl, const int start, const int stop)
     new_pl->minx = start;
     new_pl->maxx = stop;
 
-    memset(new_pl->top, UINT_MAX, sizeof(new_pl->top));
+    R_ClearPlaneColumns(new_pl, start, stop);
 
     return new_pl;
 }
@@ -358,6 +398,15 @@ visplane_t *R_CheckPlane (visplane_t *pl, int start, int stop)
     if (x > intrh)
     {
         // Can use existing plane; extend range
+        if (pl->minx > pl->maxx)
+        {
+            R_ClearPlaneColumns(pl, unionl, unionh);
+        }
+        else
+        {
+            R_ClearPlaneColumns(pl, unionl, pl->minx - 1);
+            R_ClearPlaneColumns(pl, pl->maxx + 1, unionh);
+        }
         pl->minx = unionl, pl->maxx = unionh;
         return pl;
     }
@@ -394,6 +443,31 @@ R_MakeSpans (const int x, unsigned int t1, unsigned int b1, // [crispy] 32-bit i
     }
 }
 
+// -----------------------------------------------------------------------------
+// R_ComparePlanes
+// [JN] Draw order of visplanes. Planes at the same height go one after
+// another, so they share the per-row values cached by R_MapPlane, and
+// among them, planes of the same flat are drawn together. Visplanes
+// never cover the same pixels, so the order doesn't change the picture.
+// -----------------------------------------------------------------------------
+
+static int R_ComparePlanes (const void *a, const void *b)
+{
+    const visplane_t *pa = *(visplane_t *const *) a;
+    const visplane_t *pb = *(visplane_t *const *) b;
+
+    if (pa->height != pb->height)
+    {
+        return pa->height < pb->height ? -1 : 1;
+    }
+    if (pa->picnum != pb->picnum)
+    {
+        return pa->picnum < pb->picnum ? -1 : 1;
+    }
+
+    return pa->lightlevel - pb->lightlevel;
+}
+
 // -----------------------------------------------------------------------------
 // R_DrawPlanes
 // At the end of each frame.
@@ -401,10 +475,13 @@ R_MakeSpans (const int x, unsigned int t1, unsigned int b1, // [crispy] 32-bit i
 
 void R_DrawPlanes (void) 
 {
-    for (int i = 0 ; i < MAXVISPLANES ; i++)
-    for (visplane_t *pl = visplanes[i] ; pl ; pl = pl->next, rendered_visplanes++)
-    if (pl->minx <= pl->maxx)
+    qsort(usedplanes, numusedplanes, sizeof(*usedplanes), R_ComparePlanes);
+
+    for (int i = 0 ; i < numusedplanes ; i++, rendered_visplanes++)
+    if (usedplanes[i]->minx <= usedplanes[i]->maxx)
     {
+        visplane_t *const pl = usedplanes[i];
+
         // sky flat
         if (pl->picnum == skyflatnum)
         {
@@ -442,6 +519,7 @@ void R_DrawPlanes (void)
                     dc_x = x;
                     dc_source = R_GetColumn(skytexture, angle);
                     colfunc ();
+                    rendered_colpixels += dc_yh - dc_yl + 1;
                 }
             }
         }
@@ -0,0 +1,1079 @@
+//
+// Copyright(C) 2016-2023 Julian Nechaevsky
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// DESCRIPTION:
+//	Potentially visible set of subsectors, built at level load.
+//
+//	Subsectors are joined by portals: the parts of BSP partition lines
+//	where two subsectors meet and no one-sided wall is in the way.
+//	For every portal, lines of sight are flooded through chains of
+//	portals, narrowed by the separating lines between the first portal
+//	and the last one, as in the vis tools of later engines. Only map
+//	geometry that never moves in Doom is involved: one-sided walls
+//	block the view, two-sided lines never do, whatever their heights.
+//
+
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "i_system.h"
+#include "m_argv.h"
+#include "m_bbox.h"
+#include "z_zone.h"
+#include "r_local.h"
+#include "jn.h"
+
+
+#define PVS_EPSILON    (1.0 / 64)  // Map units.
+#define PVS_SEGSLOP    2.0         // Partitions only roughly follow the segs.
+#define PVS_WALLSLOP   0.5         // Walls closer than this to a portal close it.
+#define PVS_MAXLEAFS   16384       // Rows take numsubsectors^2 bits.
+#define PVS_MAXPORTALS 16384       // One way portals, flow takes their number^2 bits.
+#define PVS_MAXSTEPS   100000      // Flow steps per portal before giving up.
+#define PVS_MAXDEPTH   1024        // Portals in a row before giving up.
+
+// Line with normalized direction. Side() is the signed distance,
+// positive on the front (right) side, as in R_PointOnSide.
+typedef struct
+{
+    double x, y;
+    double dx, dy;
+} pvsline_t;
+
+typedef struct
+{
+    double x, y;
+} pvspoint_t;
+
+typedef struct
+{
+    pvspoint_t a, b;
+} pvswinding_t;
+
+// Portal "p" is seen as one way portals 2*p, looking from leaf[0] into
+// leaf[1], and 2*p+1 the other way. Leaf[0] is on the front side.
+typedef struct
+{
+    pvswinding_t w;
+    int          leaf[2];
+} pvsportal_t;
+
+// Part of a partition line next to a subsector on one side of it.
+typedef struct
+{
+    double t1, t2;
+    int    leaf;
+} pvsspan_t;
+
+boolean pvs_active;
+
+static byte *pvsrows;
+static int   pvsrowbytes;
+
+static pvsportal_t *pvsportals;
+static int          numpvsportals, maxpvsportals;
+static int         *leafportals;      // One way portals out of each subsector.
+static int         *leafportalstart;  // numsubsectors + 1 offsets.
+
+static pvsspan_t *pvsspans[2];
+static int        numpvsspans[2], maxpvsspans[2];
+
+// Flow state.
+static int           pvsportalwords;
+static unsigned int *portalmight;   // One way portals each one might see.
+static unsigned int *portalvis;     // One way portals each one does see.
+static byte    *portaldone;
+static unsigned int *pvsmight;      // PVS_MAXDEPTH + 1 rows.
+static byte    *pvsonpath;
+static unsigned int *pvsvis;
+static int      pvssteps;
+static boolean  pvsgaveup;
+
+// Subsector rows are bytes, portal rows are words.
+#define PVS_BIT(row, n)   ((row)[(n) >> 3] & (1 << ((n) & 7)))
+#define PVS_SET(row, n)   ((row)[(n) >> 3] |= 1 << ((n) & 7))
+#define PVS_PBIT(row, n)  ((row)[(n) >> 5] & (1u << ((n) & 31)))
+#define PVS_PSET(row, n)  ((row)[(n) >> 5] |= 1u << ((n) & 31))
+
+
+// -----------------------------------------------------------------------------
+// Geometry helpers.
+// -----------------------------------------------------------------------------
+
+static void PVS_MakeLine (pvsline_t *line, const double x1, const double y1,
+                                           const double x2, const double y2)
+{
+    const double len = sqrt((x2 - x1) * (x2 - x1) + (y2 - y1) * (y2 - y1));
+
+    line->x = x1;
+    line->y = y1;
+    line->dx = len > 0 ? (x2 - x1) / len : 0;
+    line->dy = len > 0 ? (y2 - y1) / len : 0;
+}
+
+static inline double PVS_Side (const pvsline_t *line, const double x, const double y)
+{
+    return (x - line->x) * line->dy - (y - line->y) * line->dx;
+}
+
+static void PVS_NodeLine (pvsline_t *line, const node_t *node)
+{
+    const double x = node->x / (double) FRACUNIT;
+    const double y = node->y / (double) FRACUNIT;
+
+    PVS_MakeLine(line, x, y, x + node->dx / (double) FRACUNIT,
+                             y + node->dy / (double) FRACUNIT);
+}
+
+static void PVS_SegLine (pvsline_t *line, const seg_t *seg)
+{
+    PVS_MakeLine(line, seg->v1->x / (double) FRACUNIT, seg->v1->y / (double) FRACUNIT,
+                       seg->v2->x / (double) FRACUNIT, seg->v2->y / (double) FRACUNIT);
+}
+
+// Tells if a seg runs along a line, within "slop". Partition lines
+// drift off the segs they were made from by a unit or two over a long
+// way, and short segs ending at rounded split points point anywhere.
+static boolean PVS_OnLine (const pvsline_t *line, const seg_t *seg, const double slop)
+{
+    pvsline_t segline;
+    double s1, s2;
+
+    PVS_SegLine(&segline, seg);
+    s1 = fabs(PVS_Side(line, segline.x, segline.y));
+    s2 = fabs(PVS_Side(line, seg->v2->x / (double) FRACUNIT, seg->v2->y / (double) FRACUNIT));
+
+    if (s1 <= slop && s2 <= slop)
+    {
+        return true;
+    }
+
+    return fabs(segline.dx * line->dy - segline.dy * line->dx) < 1.0 / 32
+        && MIN(s1, s2) <= slop && MAX(s1, s2) <= slop * 4;
+}
+
+// -----------------------------------------------------------------------------
+// PVS_ClipRange
+// Narrows parameter range t1...t2 along "line" to where "sign" times the
+// side of "plane" is at least -epsilon. Returns false if nothing is left.
+// -----------------------------------------------------------------------------
+
+static boolean PVS_ClipRange (const pvsline_t *line, double *t1, double *t2,
+                              const pvsline_t *plane, const double sign, const double epsilon)
+{
+    const double a = sign * PVS_Side(plane, line->x, line->y) + epsilon;
+    const double b = sign * (line->dx * plane->dy - line->dy * plane->dx);
+
+    if (fabs(b) < 1e-12)
+    {
+        return a >= 0;
+    }
+
+    if (b > 0)
+    {
+        *t1 = MAX(*t1, -a / b);
+    }
+    else
+    {
+        *t2 = MIN(*t2, -a / b);
+    }
+
+    return *t1 < *t2;
+}
+
+// -----------------------------------------------------------------------------
+// PVS_ClipWinding
+// Keeps the part of the winding where "sign" times the side of "plane"
+// is at least -PVS_EPSILON. Returns false if nothing is left.
+// -----------------------------------------------------------------------------
+
+static boolean PVS_ClipWinding (pvswinding_t *w, const pvsline_t *plane, const double sign)
+{
+    const double sa = sign * PVS_Side(plane, w->a.x, w->a.y);
+    const double sb = sign * PVS_Side(plane, w->b.x, w->b.y);
+    double frac;
+
+    if (sa >= -PVS_EPSILON && sb >= -PVS_EPSILON)
+    {
+        return true;
+    }
+    if (sa < -PVS_EPSILON && sb < -PVS_EPSILON)
+    {
+        return false;
+    }
+
+    frac = sa / (sa - sb);
+
+    if (sa < -PVS_EPSILON)
+    {
+        w->a.x += (w->b.x - w->a.x) * frac;
+        w->a.y += (w->b.y - w->a.y) * frac;
+    }
+    else
+    {
+        w->b.x = w->a.x + (w->b.x - w->a.x) * frac;
+        w->b.y = w->a.y + (w->b.y - w->a.y) * frac;
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// PVS_ClipToSeparators
+// Lines of sight running from winding "from" through winding "pass" are
+// bounded by the lines through an end of each which have the other ends
+// strictly on opposite sides. Clips "target" to the side of those lines
+// where sight continues past "pass". Lines which don't strictly separate
+// the windings are not used, which only keeps more of the target.
+// -----------------------------------------------------------------------------
+
+static boolean PVS_ClipToSeparators (const pvswinding_t *from, const pvswinding_t *pass,
+                                     pvswinding_t *target)
+{
+    const pvspoint_t *fp[2] = { &from->a, &from->b };
+    const pvspoint_t *pp[2] = { &pass->a, &pass->b };
+    int i, j;
+
+    for (i = 0 ; i < 2 ; i++)
+    {
+        for (j = 0 ; j < 2 ; j++)
+        {
+            pvsline_t line;
+            double sf, sp;
+
+            if (fabs(pp[j]->x - fp[i]->x) + fabs(pp[j]->y - fp[i]->y) < PVS_EPSILON)
+            {
+                continue;
+            }
+
+            PVS_MakeLine(&line, fp[i]->x, fp[i]->y, pp[j]->x, pp[j]->y);
+            sf = PVS_Side(&line, fp[i^1]->x, fp[i^1]->y);
+            sp = PVS_Side(&line, pp[j^1]->x, pp[j^1]->y);
+
+            if ((sf > PVS_EPSILON && sp < -PVS_EPSILON)
+            ||  (sf < -PVS_EPSILON && sp > PVS_EPSILON))
+            {
+                if (!PVS_ClipWinding(target, &line, sp > 0 ? 1 : -1))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// PVS_AddSpan
+// -----------------------------------------------------------------------------
+
+static void PVS_AddSpan (const int side, const double t1, const double t2, const int leaf)
+{
+    pvsspan_t *span;
+
+    if (numpvsspans[side] == maxpvsspans[side])
+    {
+        maxpvsspans[side] = maxpvsspans[side] ? maxpvsspans[side] * 2 : 256;
+        pvsspans[side] = I_Realloc(pvsspans[side], maxpvsspans[side] * sizeof(*pvsspans[side]));
+    }
+
+    span = &pvsspans[side][numpvsspans[side]++];
+    span->t1 = t1;
+    span->t2 = t2;
+    span->leaf = leaf;
+}
+
+static int PVS_CompareSpans (const void *a, const void *b)
+{
+    const pvsspan_t *sa = a;
+    const pvsspan_t *sb = b;
+
+    return sa->t1 < sb->t1 ? -1 : sa->t1 > sb->t1 ? 1 : 0;
+}
+
+// -----------------------------------------------------------------------------
+// PVS_PushSpan
+// Splits range t1...t2 of a partition line down the subtree "child",
+// which lies on the "sign" side of the line, into the subsectors it
+// borders on. Partitions of the subtree along the same line lead to
+// the child on that side, as the other one can't touch the line.
+// -----------------------------------------------------------------------------
+
+typedef struct
+{
+    double t1, t2;
+    int    child;
+} pvspush_t;
+
+static pvspush_t *pvspushstack;
+
+static void PVS_PushSpan (const pvsline_t *line, const double sign, const int side,
+                          double t1, double t2, int child)
+{
+    int sp = 0;
+
+    while (true)
+    {
+        while (!(child & NF_SUBSECTOR))
+        {
+            const node_t *node = &nodes[child];
+            pvsline_t plane;
+            double s1, s2;
+
+            PVS_NodeLine(&plane, node);
+            s1 = PVS_Side(&plane, line->x + line->dx * t1, line->y + line->dy * t1);
+            s2 = PVS_Side(&plane, line->x + line->dx * t2, line->y + line->dy * t2);
+
+            if (fabs(s1) < PVS_EPSILON && fabs(s2) < PVS_EPSILON)
+            {
+                // Same line: our side of it is the front one
+                // if both lines run the same way.
+                const double facing = sign * (line->dx * plane.dx + line->dy * plane.dy);
+
+                child = node->children[facing > 0 ? 0 : 1];
+            }
+            else if (s1 > -PVS_EPSILON && s2 > -PVS_EPSILON)
+            {
+                child = node->children[0];
+            }
+            else if (s1 < PVS_EPSILON && s2 < PVS_EPSILON)
+            {
+                child = node->children[1];
+            }
+            else
+            {
+                // Crosses the partition: the t1 end now, the t2 end later.
+                const double t = t1 + (t2 - t1) * s1 / (s1 - s2);
+
+                pvspushstack[sp].t1 = t;
+                pvspushstack[sp].t2 = t2;
+                pvspushstack[sp].child = node->children[s2 > 0 ? 0 : 1];
+                sp++;
+
+                t2 = t;
+                child = node->children[s1 > 0 ? 0 : 1];
+            }
+        }
+
+        PVS_AddSpan(side, t1, t2, child == -1 ? 0 : child & ~NF_SUBSECTOR);
+
+        if (!sp)
+        {
+            break;
+        }
+
+        sp--;
+        t1 = pvspushstack[sp].t1;
+        t2 = pvspushstack[sp].t2;
+        child = pvspushstack[sp].child;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// PVS_ClipToLeaf
+// Narrows range t1...t2 of a line to the front sides of the segs
+// of a subsector, which bound the part of it that isn't solid.
+// Partition lines have integer deltas and drift off the segs they
+// were made from, so the segs are given some slop, and segs along
+// the line are left out.
+// -----------------------------------------------------------------------------
+
+static boolean PVS_ClipToLeaf (const pvsline_t *line, double *t1, double *t2, const int leaf)
+{
+    const subsector_t *sub = &subsectors[leaf];
+    int i;
+
+    for (i = 0 ; i < sub->numlines ; i++)
+    {
+        const seg_t *seg = &segs[sub->firstline + i];
+        pvsline_t segline;
+
+        // Segs along the line itself may lean over it further on.
+        if (PVS_OnLine(line, seg, PVS_SEGSLOP))
+        {
+            continue;
+        }
+
+        PVS_SegLine(&segline, seg);
+
+        if (!PVS_ClipRange(line, t1, t2, &segline, 1, PVS_SEGSLOP))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// PVS_AddPortal
+// Adds the parts of range t1...t2 of a partition line between two
+// subsectors which aren't covered by one-sided segs of either one.
+// -----------------------------------------------------------------------------
+
+static void PVS_AddPortal (const pvsline_t *line, double t1, double t2,
+                           const int front, const int back)
+{
+    const int leafs[2] = { front, back };
+    int i, j;
+
+    if (!PVS_ClipToLeaf(line, &t1, &t2, front) || !PVS_ClipToLeaf(line, &t1, &t2, back))
+    {
+        return;
+    }
+
+    while (t2 - t1 > PVS_EPSILON)
+    {
+        double end = t2;
+        double next = t2;
+
+        // Find the nearest one-sided seg lying on the line, if any.
+        for (i = 0 ; i < 2 ; i++)
+        {
+            const subsector_t *sub = &subsectors[leafs[i]];
+
+            for (j = 0 ; j < sub->numlines ; j++)
+            {
+                const seg_t *seg = &segs[sub->firstline + j];
+                double u1, u2;
+
+                if (seg->backsector || !PVS_OnLine(line, seg, PVS_WALLSLOP))
+                {
+                    continue;
+                }
+
+                u1 = (seg->v1->x / (double) FRACUNIT - line->x) * line->dx
+                   + (seg->v1->y / (double) FRACUNIT - line->y) * line->dy;
+                u2 = (seg->v2->x / (double) FRACUNIT - line->x) * line->dx
+                   + (seg->v2->y / (double) FRACUNIT - line->y) * line->dy;
+
+                if (u1 > u2)
+                {
+                    const double u = u1;
+                    u1 = u2;
+                    u2 = u;
+                }
+
+                if (u2 > t1 + PVS_EPSILON && u1 < end)
+                {
+                    end = MAX(u1, t1);
+                    next = MAX(u2, end);
+                }
+            }
+        }
+
+        if (end - t1 > PVS_EPSILON)
+        {
+            pvsportal_t *portal;
+
+            if (numpvsportals == maxpvsportals)
+            {
+                maxpvsportals = maxpvsportals ? maxpvsportals * 2 : 256;
+                pvsportals = I_Realloc(pvsportals, maxpvsportals * sizeof(*pvsportals));
+            }
+
+            portal = &pvsportals[numpvsportals++];
+            portal->w.a.x = line->x + line->dx * t1;
+            portal->w.a.y = line->y + line->dy * t1;
+            portal->w.b.x = line->x + line->dx * end;
+            portal->w.b.y = line->y + line->dy * end;
+            portal->leaf[0] = front;
+            portal->leaf[1] = back;
+        }
+
+        t1 = next;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// PVS_BuildPortals
+// Walks the node tree keeping the partitions on the path to each node,
+// which bound the region the node splits. The partition is clipped to
+// that region, pushed down both children and the subsectors meeting
+// on each part of it are joined by a portal.
+// -----------------------------------------------------------------------------
+
+static void PVS_BuildPortals (void)
+{
+    pvsline_t *path;      // Partitions on the path, facing the way down.
+    int       *pathnode;  // Node, or ~node once its front side is done.
+    double     bounds[4];
+    int        depth, i;
+
+    path = Z_Malloc(numnodes * sizeof(*path), PU_STATIC, 0);
+    pathnode = Z_Malloc(numnodes * sizeof(*pathnode), PU_STATIC, 0);
+
+    // Map bounds, a little larger than both halves of the root.
+    for (i = 0 ; i < 4 ; i++)
+    {
+        const fixed_t *box0 = nodes[numnodes - 1].bbox[0];
+        const fixed_t *box1 = nodes[numnodes - 1].bbox[1];
+
+        bounds[i] = (i == BOXTOP || i == BOXRIGHT ? MAX(box0[i], box1[i]) + FRACUNIT * 64
+                                                  : MIN(box0[i], box1[i]) - FRACUNIT * 64)
+                  / (double) FRACUNIT;
+    }
+
+    depth = 0;
+    pathnode[depth++] = numnodes - 1;
+
+    while (depth)
+    {
+        const int n = pathnode[depth - 1];
+        const node_t *node = &nodes[n < 0 ? ~n : n];
+        int child;
+
+        if (n < 0)
+        {
+            // Front side done, go down the back one.
+            pathnode[depth - 1] = numnodes;  // Both sides done.
+            PVS_NodeLine(&path[depth - 1], node);
+            path[depth - 1].dx = -path[depth - 1].dx;
+            path[depth - 1].dy = -path[depth - 1].dy;
+            child = node->children[1];
+        }
+        else if (n == numnodes)
+        {
+            depth--;
+            continue;
+        }
+        else
+        {
+            pvsline_t line;
+            double t1 = -1e9, t2 = 1e9;
+
+            PVS_NodeLine(&line, node);
+
+            if (line.dx || line.dy)
+            {
+                pvsline_t edge;
+                boolean inside = true;
+
+                // Map bounds, as lines with the map on the back side.
+                PVS_MakeLine(&edge, bounds[BOXLEFT], bounds[BOXTOP], bounds[BOXLEFT], bounds[BOXBOTTOM]);
+                inside &= PVS_ClipRange(&line, &t1, &t2, &edge, -1, 0);
+                PVS_MakeLine(&edge, bounds[BOXRIGHT], bounds[BOXBOTTOM], bounds[BOXRIGHT], bounds[BOXTOP]);
+                inside &= PVS_ClipRange(&line, &t1, &t2, &edge, -1, 0);
+                PVS_MakeLine(&edge, bounds[BOXLEFT], bounds[BOXBOTTOM], bounds[BOXRIGHT], bounds[BOXBOTTOM]);
+                inside &= PVS_ClipRange(&line, &t1, &t2, &edge, -1, 0);
+                PVS_MakeLine(&edge, bounds[BOXRIGHT], bounds[BOXTOP], bounds[BOXLEFT], bounds[BOXTOP]);
+                inside &= PVS_ClipRange(&line, &t1, &t2, &edge, -1, 0);
+
+                for (i = 0 ; inside && i < depth - 1 ; i++)
+                {
+                    inside = PVS_ClipRange(&line, &t1, &t2, &path[i], 1, PVS_EPSILON);
+                }
+
+                if (inside)
+                {
+                    int f, b;
+
+                    numpvsspans[0] = numpvsspans[1] = 0;
+                    PVS_PushSpan(&line, 1, 0, t1, t2, node->children[0]);
+                    PVS_PushSpan(&line, -1, 1, t1, t2, node->children[1]);
+                    qsort(pvsspans[0], numpvsspans[0], sizeof(pvsspan_t), PVS_CompareSpans);
+                    qsort(pvsspans[1], numpvsspans[1], sizeof(pvsspan_t), PVS_CompareSpans);
+
+                    // Overlay both sides.
+                    for (f = 0, b = 0 ; f < numpvsspans[0] && b < numpvsspans[1] ; )
+                    {
+                        const pvsspan_t *fs = &pvsspans[0][f];
+                        const pvsspan_t *bs = &pvsspans[1][b];
+                        const double lo = MAX(fs->t1, bs->t1);
+                        const double hi = MIN(fs->t2, bs->t2);
+
+                        if (hi - lo > PVS_EPSILON)
+                        {
+                            PVS_AddPortal(&line, lo, hi, fs->leaf, bs->leaf);
+                        }
+
+                        if (fs->t2 < bs->t2)
+                        {
+                            f++;
+                        }
+                        else
+                        {
+                            b++;
+                        }
+                    }
+                }
+            }
+
+            // Go down the front side.
+            pathnode[depth - 1] = ~n;
+            path[depth - 1] = line;
+            child = node->children[0];
+        }
+
+        if (!(child & NF_SUBSECTOR) && depth < numnodes)
+        {
+            pathnode[depth++] = child;
+        }
+    }
+
+    Z_Free(path);
+    Z_Free(pathnode);
+}
+
+// -----------------------------------------------------------------------------
+// PVS_LinkPortals
+// Lists the one way portals going out of each subsector.
+// -----------------------------------------------------------------------------
+
+static void PVS_LinkPortals (void)
+{
+    int *count;
+    int  i, j;
+
+    leafportalstart = Z_Malloc((numsubsectors + 1) * sizeof(*leafportalstart), PU_STATIC, 0);
+    leafportals = Z_Malloc((numpvsportals * 2 + 1) * sizeof(*leafportals), PU_STATIC, 0);
+    count = Z_Malloc((numsubsectors + 1) * sizeof(*count), PU_STATIC, 0);
+    memset(count, 0, (numsubsectors + 1) * sizeof(*count));
+
+    for (i = 0 ; i < numpvsportals ; i++)
+    {
+        count[pvsportals[i].leaf[0]]++;
+        count[pvsportals[i].leaf[1]]++;
+    }
+
+    leafportalstart[0] = 0;
+    for (i = 0 ; i < numsubsectors ; i++)
+    {
+        leafportalstart[i + 1] = leafportalstart[i] + count[i];
+        count[i] = leafportalstart[i];
+    }
+
+    for (i = 0 ; i < numpvsportals ; i++)
+    {
+        for (j = 0 ; j < 2 ; j++)
+        {
+            leafportals[count[pvsportals[i].leaf[j]]++] = i * 2 + j;
+        }
+    }
+
+    Z_Free(count);
+}
+
+// -----------------------------------------------------------------------------
+// One way portal helpers. "Beyond" a one way portal is the side of its
+// line facing away from the subsector it is looked through from.
+// -----------------------------------------------------------------------------
+
+static inline int PVS_PortalFrom (const int d)
+{
+    return pvsportals[d >> 1].leaf[d & 1];
+}
+
+static inline int PVS_PortalTo (const int d)
+{
+    return pvsportals[d >> 1].leaf[(d & 1) ^ 1];
+}
+
+static double PVS_PortalLine (pvsline_t *line, const int d)
+{
+    const pvswinding_t *w = &pvsportals[d >> 1].w;
+
+    PVS_MakeLine(line, w->a.x, w->a.y, w->b.x, w->b.y);
+
+    return d & 1 ? 1 : -1;
+}
+
+// -----------------------------------------------------------------------------
+// PVS_BasePortalVis
+// Floods subsectors out of one way portal "d" through every portal
+// which is partly beyond it and has it partly behind, ignoring where
+// lines of sight can actually go. What is left out can't be seen.
+// -----------------------------------------------------------------------------
+
+static void PVS_BasePortalVis (const int d, int *queue, int *stamp)
+{
+    const pvswinding_t *w = &pvsportals[d >> 1].w;
+    unsigned int *might = portalmight + d * pvsportalwords;
+    pvsline_t line;
+    double sign;
+    int head = 0, tail = 0;
+
+    sign = PVS_PortalLine(&line, d);
+
+    stamp[PVS_PortalFrom(d)] = d + 1;
+    stamp[PVS_PortalTo(d)] = d + 1;
+    queue[tail++] = PVS_PortalTo(d);
+
+    while (head < tail)
+    {
+        const int leaf = queue[head++];
+        int i;
+
+        for (i = leafportalstart[leaf] ; i < leafportalstart[leaf + 1] ; i++)
+        {
+            const int e = leafportals[i];
+            const pvswinding_t *ew = &pvsportals[e >> 1].w;
+            pvsline_t eline;
+            double esign;
+
+            if (sign * PVS_Side(&line, ew->a.x, ew->a.y) < PVS_EPSILON
+            &&  sign * PVS_Side(&line, ew->b.x, ew->b.y) < PVS_EPSILON)
+            {
+                continue;
+            }
+
+            esign = PVS_PortalLine(&eline, e);
+
+            if (esign * PVS_Side(&eline, w->a.x, w->a.y) > -PVS_EPSILON
+            &&  esign * PVS_Side(&eline, w->b.x, w->b.y) > -PVS_EPSILON)
+            {
+                continue;
+            }
+
+            PVS_PSET(might, e);
+
+            if (stamp[PVS_PortalTo(e)] != d + 1)
+            {
+                stamp[PVS_PortalTo(e)] = d + 1;
+                queue[tail++] = PVS_PortalTo(e);
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// PVS_RecursiveLeafFlow
+// Sight enters "leaf" through winding "pass", having come from winding
+// "source" in the first portal of the chain. Marks every one way portal
+// out of "leaf" it can get through, narrowing both windings on the way.
+// Portals are only tried if they might see something not seen yet.
+// -----------------------------------------------------------------------------
+
+static void PVS_RecursiveLeafFlow (const int leaf, const pvswinding_t *source,
+                                   const pvswinding_t *pass, const unsigned int *might,
+                                   const int depth)
+{
+    unsigned int *newmight;
+    int i;
+
+    if (depth >= PVS_MAXDEPTH)
+    {
+        pvsgaveup = true;
+        return;
+    }
+
+    newmight = pvsmight + (depth + 1) * pvsportalwords;
+    pvsonpath[leaf] = 1;
+
+    for (i = leafportalstart[leaf] ; i < leafportalstart[leaf + 1] && !pvsgaveup ; i++)
+    {
+        const int e = leafportals[i];
+        const unsigned int *test;
+        pvswinding_t target, newsource;
+        boolean more;
+        int k;
+
+        if (!PVS_PBIT(might, e) || pvsonpath[PVS_PortalTo(e)])
+        {
+            continue;
+        }
+
+        if (++pvssteps > PVS_MAXSTEPS)
+        {
+            pvsgaveup = true;
+            break;
+        }
+
+        // Whatever gets seen through "e" is seen by "e" itself.
+        test = (portaldone[e] ? portalvis : portalmight) + e * pvsportalwords;
+        more = false;
+
+        for (k = 0 ; k < pvsportalwords ; k++)
+        {
+            newmight[k] = might[k] & test[k];
+            more |= (newmight[k] & ~pvsvis[k]) != 0;
+        }
+
+        if (!more && PVS_PBIT(pvsvis, e))
+        {
+            continue;
+        }
+
+        target = pvsportals[e >> 1].w;
+        if (!PVS_ClipToSeparators(source, pass, &target))
+        {
+            continue;
+        }
+
+        PVS_PSET(pvsvis, e);
+
+        newsource = *source;
+        if (!PVS_ClipToSeparators(&target, pass, &newsource))
+        {
+            continue;
+        }
+
+        PVS_RecursiveLeafFlow(PVS_PortalTo(e), &newsource, &target, newmight, depth + 1);
+    }
+
+    pvsonpath[leaf] = 0;
+}
+
+// -----------------------------------------------------------------------------
+// PVS_PortalFlow
+// Finds the one way portals seen through one way portal "d".
+// -----------------------------------------------------------------------------
+
+static void PVS_PortalFlow (const int d)
+{
+    const pvswinding_t *w = &pvsportals[d >> 1].w;
+    const int from = PVS_PortalFrom(d);
+
+    pvsvis = portalvis + d * pvsportalwords;
+    pvssteps = 0;
+    pvsgaveup = false;
+
+    pvsonpath[from] = 1;
+    PVS_RecursiveLeafFlow(PVS_PortalTo(d), w, w, portalmight + d * pvsportalwords, 0);
+    pvsonpath[from] = 0;
+
+    if (pvsgaveup)
+    {
+        // Too complex to tell, take everything it might see.
+        memset(pvsonpath, 0, numsubsectors);
+        memcpy(pvsvis, portalmight + d * pvsportalwords, pvsportalwords * sizeof(*pvsvis));
+    }
+
+    portaldone[d] = 1;
+}
+
+static int *portalcount;
+
+static int PVS_CompareCounts (const void *a, const void *b)
+{
+    return portalcount[*(const int *) a] - portalcount[*(const int *) b];
+}
+
+// -----------------------------------------------------------------------------
+// PVS_BuildRows
+// Runs the flow for every one way portal, fewest possible portals to
+// see first, so that later ones are cut short by what those saw.
+// A subsector sees its neighbours and whatever their portals see.
+// -----------------------------------------------------------------------------
+
+static boolean PVS_BuildRows (void)
+{
+    const int numdportals = numpvsportals * 2;
+    int *order, *queue, *stamp;
+    int  i, j, k;
+
+    pvsportalwords = (numdportals + 31) >> 5;
+    portalmight = calloc(numdportals, pvsportalwords * sizeof(*portalmight));
+    portalvis = calloc(numdportals, pvsportalwords * sizeof(*portalvis));
+    pvsmight = calloc(PVS_MAXDEPTH + 1, pvsportalwords * sizeof(*pvsmight));
+
+    if (!portalmight || !portalvis || !pvsmight)
+    {
+        free(portalmight);
+        free(portalvis);
+        free(pvsmight);
+        return false;
+    }
+
+    portaldone = Z_Malloc(numdportals + 1, PU_STATIC, 0);
+    pvsonpath = Z_Malloc(numsubsectors, PU_STATIC, 0);
+    order = Z_Malloc((numdportals + 1) * sizeof(*order), PU_STATIC, 0);
+    portalcount = Z_Malloc((numdportals + 1) * sizeof(*portalcount), PU_STATIC, 0);
+    queue = Z_Malloc(numsubsectors * sizeof(*queue), PU_STATIC, 0);
+    stamp = Z_Malloc(numsubsectors * sizeof(*stamp), PU_STATIC, 0);
+    memset(portaldone, 0, numdportals + 1);
+    memset(pvsonpath, 0, numsubsectors);
+    memset(stamp, 0, numsubsectors * sizeof(*stamp));
+
+    for (i = 0 ; i < numdportals ; i++)
+    {
+        const unsigned int *might = portalmight + i * pvsportalwords;
+
+        PVS_BasePortalVis(i, queue, stamp);
+
+        order[i] = i;
+        portalcount[i] = 0;
+        for (j = 0 ; j < numdportals ; j++)
+        {
+            portalcount[i] += PVS_PBIT(might, j) != 0;
+        }
+    }
+
+    qsort(order, numdportals, sizeof(*order), PVS_CompareCounts);
+
+    for (i = 0 ; i < numdportals ; i++)
+    {
+        PVS_PortalFlow(order[i]);
+    }
+
+    memset(pvsrows, 0, numsubsectors * pvsrowbytes);
+
+    for (i = 0 ; i < numsubsectors ; i++)
+    {
+        byte *row = pvsrows + i * pvsrowbytes;
+
+        PVS_SET(row, i);
+
+        for (j = leafportalstart[i] ; j < leafportalstart[i + 1] ; j++)
+        {
+            const int d = leafportals[j];
+            const unsigned int *vis = portalvis + d * pvsportalwords;
+
+            PVS_SET(row, PVS_PortalTo(d));
+
+            for (k = 0 ; k < numdportals ; k++)
+            {
+                if (!vis[k >> 5])
+                {
+                    k |= 31;  // Skip empty words.
+                }
+                else if (PVS_PBIT(vis, k))
+                {
+                    PVS_SET(row, PVS_PortalTo(k));
+                }
+            }
+        }
+    }
+
+    free(portalmight);
+    free(portalvis);
+    free(pvsmight);
+    Z_Free(portaldone);
+    Z_Free(pvsonpath);
+    Z_Free(order);
+    Z_Free(portalcount);
+    Z_Free(queue);
+    Z_Free(stamp);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// PVS_DilateRows
+// Grows every row by one portal, so that things standing across a
+// portal edge and rounding in the windings never get lost.
+// -----------------------------------------------------------------------------
+
+static void PVS_DilateRows (void)
+{
+    byte *dilated = Z_Malloc(pvsrowbytes, PU_STATIC, 0);
+    int   i, j, k;
+
+    for (i = 0 ; i < numsubsectors ; i++)
+    {
+        byte *row = pvsrows + i * pvsrowbytes;
+
+        memcpy(dilated, row, pvsrowbytes);
+
+        for (j = 0 ; j < numsubsectors ; j++)
+        {
+            if (!PVS_BIT(row, j))
+            {
+                continue;
+            }
+
+            for (k = leafportalstart[j] ; k < leafportalstart[j + 1] ; k++)
+            {
+                PVS_SET(dilated, PVS_PortalTo(leafportals[k]));
+            }
+        }
+
+        memcpy(row, dilated, pvsrowbytes);
+    }
+
+    Z_Free(dilated);
+}
+
+// -----------------------------------------------------------------------------
+// R_InitPVS
+// [JN] Builds the potentially visible set for the level just loaded,
+// if enabled. Called after the nodes are loaded and packed.
+// -----------------------------------------------------------------------------
+
+void R_InitPVS (void)
+{
+    pvs_active = false;
+
+    //!
+    // @category video
+    //
+    // Precompute which subsectors may be seen from each other on level
+    // load and don't walk BSP subtrees which can't be visible.
+    //
+
+    if (!M_ParmExists("-pvs") || numnodes <= 0 || numsubsectors > PVS_MAXLEAFS)
+    {
+        return;
+    }
+
+    numpvsportals = 0;
+    pvspushstack = Z_Malloc((numnodes + 1) * sizeof(*pvspushstack), PU_STATIC, 0);
+    PVS_BuildPortals();
+    Z_Free(pvspushstack);
+
+    if (numpvsportals * 2 > PVS_MAXPORTALS)
+    {
+        return;
+    }
+
+    PVS_LinkPortals();
+
+    pvsrowbytes = (numsubsectors + 7) >> 3;
+    pvsrows = I_Realloc(pvsrows, numsubsectors * pvsrowbytes);
+
+    if (PVS_BuildRows())
+    {
+        PVS_DilateRows();
+        pvs_active = true;
+    }
+
+    Z_Free(leafportals);
+    Z_Free(leafportalstart);
+}
+
+// -----------------------------------------------------------------------------
+// R_PVSForView
+// [JN] Returns the row of subsectors that may be seen from a view point,
+// or NULL if everything has to be checked. The latter happens with the
+// PVS off, or with the view point out of the open part of its subsector,
+// as with noclipping through walls.
+// -----------------------------------------------------------------------------
+
+const byte *R_PVSForView (fixed_t x, fixed_t y)
+{
+    const subsector_t *sub;
+    int i;
+
+    if (!pvs_active)
+    {
+        return NULL;
+    }
+
+    sub = R_PointInSubsector(x, y);
+
+    for (i = 0 ; i < sub->numlines ; i++)
+    {
+        pvsline_t segline;
+
+        PVS_SegLine(&segline, &segs[sub->firstline + i]);
+
+        if (PVS_Side(&segline, x / (double) FRACUNIT, y / (double) FRACUNIT) < -PVS_EPSILON)
+        {
+            return NULL;
+        }
+    }
+
+    return pvsrows + (sub - subsectors) * pvsrowbytes;
+}
@@ -397,6 +397,7 @@ static void R_RenderSegLoop (void)
             dc_texheight = textureheight[midtexture] >> FRACBITS;
             dc_brightmap = texturebrightmap[midtexture];
             colfunc ();
+            rendered_colpixels += MAX(yh - yl + 1, 0);
             ceilingclip[rw_x] = viewheight;
             floorclip[rw_x] = -1;
         }
@@ -418,6 +419,7 @@ static void R_RenderSegLoop (void)
                     dc_texheight = textureheight[toptexture]>>FRACBITS;
                     dc_brightmap = texturebrightmap[toptexture];
                     colfunc ();
+                    rendered_colpixels += mid - yl + 1;
                     ceilingclip[rw_x] = mid;
                 }
                 else
@@ -449,6 +451,7 @@ static void R_RenderSegLoop (void)
                     dc_texheight = textureheight[bottomtexture]>>FRACBITS;
                     dc_brightmap = texturebrightmap[bottomtexture];
                     colfunc ();
+                    rendered_colpixels += yh - mid + 1;
                     floorclip[rw_x] = mid;
                 }
                 else
@@ -0,0 +1,156 @@
+//
+// Copyright(C) 2016-2023 Julian Nechaevsky
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// DESCRIPTION:
+//	Renderer statistics: per frame counters and stage timings,
+//	shown by the performance counter and optionally written
+//	to a CSV file, one line per rendered frame.
+//
+
+
+#include <stdio.h>
+#include "doomstat.h"
+#include "i_system.h"
+#include "i_timer.h"
+#include "m_argv.h"
+#include "r_local.h"
+#include "jn.h"
+
+
+// [JN] Used by perfomance counter.
+int rendered_segs, rendered_visplanes, rendered_vissprites, rendered_pvsculled;
+int rendered_drawsegs;
+int rendered_colpixels, rendered_spanpixels, rendered_maskedpixels;
+
+// Microseconds spent in each rendering stage this frame.
+uint64_t rendered_stagetime[NUMRENDERSTAGES];
+
+static uint64_t stagestart[NUMRENDERSTAGES];
+static boolean  framerendered;
+static int      framecount;
+static FILE    *statsfile;
+
+// -----------------------------------------------------------------------------
+// R_CloseStats
+// -----------------------------------------------------------------------------
+
+static void R_CloseStats (void)
+{
+    if (statsfile)
+    {
+        fclose(statsfile);
+        statsfile = NULL;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// R_InitStats
+// -----------------------------------------------------------------------------
+
+void R_InitStats (void)
+{
+    int p;
+
+    //!
+    // @category video
+    // @arg <filename>
+    //
+    // Write renderer counters and stage timings of every rendered frame
+    // to the specified CSV file, along with the map and view position.
+    //
+
+    p = M_CheckParmWithArgs("-renderstats", 1);
+
+    if (p > 0)
+    {
+        statsfile = fopen(myargv[p + 1], "w");
+
+        if (!statsfile)
+        {
+            printf(english_language ?
+                   "\n R_InitStats: can't open %s for writing" :
+                   "\n R_InitStats: невозможно открыть %s для записи", myargv[p + 1]);
+            return;
+        }
+
+        fprintf(statsfile, "frame,gametic,episode,map,x,y,angle,"
+                           "segs,drawsegs,visplanes,vissprites,pvsculled,"
+                           "colpixels,spanpixels,maskedpixels,"
+                           "bsp_us,planes_us,masked_us,total_us\n");
+
+        I_AtExit(R_CloseStats, true);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// R_BeginStage, R_EndStage
+// Accumulate the time between both calls into rendered_stagetime[stage].
+// Stages may be nested, as RSTAGE_TOTAL holds all the others.
+// -----------------------------------------------------------------------------
+
+void R_BeginStage (const renderstage_t stage)
+{
+    stagestart[stage] = I_GetTimeUS();
+    framerendered = true;
+}
+
+void R_EndStage (const renderstage_t stage)
+{
+    rendered_stagetime[stage] += I_GetTimeUS() - stagestart[stage];
+}
+
+// -----------------------------------------------------------------------------
+// R_ClearStats
+// [JN] Called once per displayed frame, after the counters were drawn.
+// Writes them out first, if a frame was rendered and a file is open.
+// -----------------------------------------------------------------------------
+
+void R_ClearStats (void)
+{
+    int i;
+
+    if (statsfile && framerendered)
+    {
+        fprintf(statsfile, "%d,%d,%d,%d,%d,%d,%u,%d,%d,%d,%d,%d,%d,%d,%d",
+                framecount, gametic, gameepisode, gamemap,
+                viewx >> FRACBITS, viewy >> FRACBITS,
+                (viewangle >> ANGLETOFINESHIFT) * 360 / FINEANGLES,
+                rendered_segs, rendered_drawsegs, rendered_visplanes,
+                rendered_vissprites, rendered_pvsculled,
+                rendered_colpixels, rendered_spanpixels, rendered_maskedpixels);
+
+        for (i = 0 ; i < NUMRENDERSTAGES ; i++)
+        {
+            fprintf(statsfile, ",%u", (unsigned int) rendered_stagetime[i]);
+        }
+
+        fprintf(statsfile, "\n");
+        framecount++;
+    }
+
+    rendered_segs = 0;
+    rendered_visplanes = 0;
+    rendered_vissprites = 0;
+    rendered_pvsculled = 0;
+    rendered_drawsegs = 0;
+    rendered_colpixels = 0;
+    rendered_spanpixels = 0;
+    rendered_maskedpixels = 0;
+
+    for (i = 0 ; i < NUMRENDERSTAGES ; i++)
+    {
+        rendered_stagetime[i] = 0;
+    }
+
+    framerendered = false;
+}
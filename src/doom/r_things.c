@@ -88,6 +88,22 @@ static drawseg_xrange_item_t *drawsegs_xrange;
 static unsigned int drawsegs_xrange_size = 0;
 static int drawsegs_xrange_count = 0;
 
+// [JN] Drawseg index for crowded scenes. Every tile holds the items of
+// drawsegs_xranges[0] that overlap it, in the same order. Tiles of level
+// "l" are DS_TILE_MIN << l columns wide and start every half of that, so
+// a sprite no wider than a half tile always fits into a single tile.
+#define DS_TILE_MIN     32   // tile width at level 0
+#define DS_TILE_LEVELS  8    // up to 4096 columns
+#define DS_TILE_SPRITES 32   // with fewer sprites, don't build the index
+
+static int *dstilestart[DS_TILE_LEVELS];  // first item of every tile
+static int  dstilecount[DS_TILE_LEVELS];  // number of tiles on level
+static int *dstileoffsets;
+static int  dstileoffsets_size;
+static drawseg_xrange_item_t *dstileitems;
+static int  dstileitems_size;
+static boolean dstileactive;
+
 
 // -----------------------------------------------------------------------------
 // R_InitSpritesRes
@@ -444,6 +460,7 @@ void R_DrawMaskedColumn (const column_t *column)
             // Drawn by either R_DrawColumn
             //  or (SHADOW) R_DrawFuzzColumn.
             colfunc ();	
+            rendered_maskedpixels += dc_yh - dc_yl + 1;
         }
 
         column = (column_t *)(  (byte *)column + column->length + 4);
@@ -1249,6 +1266,107 @@ static void msort(vissprite_t **s, vissprite_t **t, const int n)
     }
 }
 
+// -----------------------------------------------------------------------------
+// R_RadixSortOrder
+// [JN] Lists the vissprites in the order msort gives to sprites of equal
+// scale: the right half of every split goes before the left one, and
+// blocks of less than 16 sprites keep their original order.
+// -----------------------------------------------------------------------------
+
+static vissprite_t **R_RadixSortOrder (vissprite_t **d, vissprite_t *first, const int n)
+{
+    int i;
+
+    if (n >= 16)
+    {
+        const int n1 = n/2;
+
+        d = R_RadixSortOrder(d, first + n1, n - n1);
+        return R_RadixSortOrder(d, first, n1);
+    }
+
+    for (i = 0 ; i < n ; i++)
+    {
+        *d++ = first + i;
+    }
+
+    return d;
+}
+
+// -----------------------------------------------------------------------------
+// R_RadixSort
+// [JN] Stable LSD radix sort of vissprites by descending scale, used for
+// large amounts of sprites. Starting from the order above, it gives
+// exactly the same result as msort, so the drawing order of sprites
+// having equal scale stays the same.
+// -----------------------------------------------------------------------------
+
+#define RADIX_BITS    11
+#define RADIX_SIZE    (1 << RADIX_BITS)
+#define RADIX_PASSES  3
+#define RADIX_MINSORT 64    // use msort for less sprites than this
+
+// Ascending order of the key is descending order of the scale.
+#define RADIX_KEY(v)  (~((unsigned int) (v)->scale ^ 0x80000000u))
+
+static void R_RadixSort (vissprite_t **s, vissprite_t **t, const int n)
+{
+    static int count[RADIX_PASSES][RADIX_SIZE];
+    vissprite_t **src = t, **dst = s;
+    int i, pass;
+
+    R_RadixSortOrder(t, vissprites, n);
+
+    memset(count, 0, sizeof(count));
+
+    for (i = 0 ; i < n ; i++)
+    {
+        const unsigned int key = RADIX_KEY(t[i]);
+
+        count[0][key & (RADIX_SIZE - 1)]++;
+        count[1][(key >> RADIX_BITS) & (RADIX_SIZE - 1)]++;
+        count[2][key >> (2 * RADIX_BITS)]++;
+    }
+
+    for (pass = 0 ; pass < RADIX_PASSES ; pass++)
+    {
+        const int shift = pass * RADIX_BITS;
+        int *c = count[pass];
+        int sum = 0;
+
+        // All keys share this digit, nothing to move.
+        if (c[(RADIX_KEY(src[0]) >> shift) & (RADIX_SIZE - 1)] == n)
+        {
+            continue;
+        }
+
+        for (i = 0 ; i < RADIX_SIZE ; i++)
+        {
+            const int cnt = c[i];
+
+            c[i] = sum;
+            sum += cnt;
+        }
+
+        for (i = 0 ; i < n ; i++)
+        {
+            dst[c[(RADIX_KEY(src[i]) >> shift) & (RADIX_SIZE - 1)]++] = src[i];
+        }
+
+        {
+            vissprite_t **tmp = src;
+
+            src = dst;
+            dst = tmp;
+        }
+    }
+
+    if (src != s)
+    {
+        bcopyp(s, src, n);
+    }
+}
+
 // -----------------------------------------------------------------------------
 // R_SortVisSprites
 // -----------------------------------------------------------------------------
@@ -1278,7 +1396,17 @@ static void R_SortVisSprites (void)
         // killough 9/22/98: replace qsort with merge sort, since the keys
         // are roughly in order to begin with, due to BSP rendering.
 
-        msort(vissprite_ptrs, vissprite_ptrs + num_vissprite, num_vissprite);
+        // [JN] Radix sort is faster for crowded scenes and gives
+        // the same order, so use it when there are many sprites.
+
+        if (num_vissprite >= RADIX_MINSORT)
+        {
+            R_RadixSort(vissprite_ptrs, vissprite_ptrs + num_vissprite, num_vissprite);
+        }
+        else
+        {
+            msort(vissprite_ptrs, vissprite_ptrs + num_vissprite, num_vissprite);
+        }
     }
 }
 
@@ -1380,6 +1508,123 @@ static void R_DrawSprite (const vissprite_t *spr)
     R_DrawVisSprite (spr, spr->x1, spr->x2);
 }
 
+// -----------------------------------------------------------------------------
+// R_BuildDrawsegTiles
+// [JN] Distributes drawsegs_xranges[0] into the tiles of every level.
+// -----------------------------------------------------------------------------
+
+static void R_BuildDrawsegTiles (void)
+{
+    const drawseg_xrange_item_t *items = drawsegs_xranges[0].items;
+    const int count = drawsegs_xranges[0].count;
+    int numoffsets = 0;
+    int total = 0;
+    int l, i, k;
+
+    for (l = 0 ; l < DS_TILE_LEVELS ; l++)
+    {
+        const int step = (DS_TILE_MIN / 2) << l;
+
+        dstilecount[l] = (viewwidth + step - 1) / step;
+        numoffsets += dstilecount[l] + 1;
+    }
+
+    if (dstileoffsets_size < numoffsets)
+    {
+        dstileoffsets_size = numoffsets;
+        dstileoffsets = I_Realloc(dstileoffsets, numoffsets * sizeof(*dstileoffsets));
+    }
+
+    memset(dstileoffsets, 0, numoffsets * sizeof(*dstileoffsets));
+
+    // Count the items of every tile.
+    for (l = 0, numoffsets = 0 ; l < DS_TILE_LEVELS ; l++)
+    {
+        const int step = (DS_TILE_MIN / 2) << l;
+        int *start = dstilestart[l] = dstileoffsets + numoffsets;
+
+        numoffsets += dstilecount[l] + 1;
+
+        for (i = 0 ; i < count ; i++)
+        {
+            // Tile k covers columns from k*step to k*step + 2*step - 1.
+            const int k1 = MAX(items[i].x1 / step - 1, 0);
+            const int k2 = MIN(items[i].x2 / step, dstilecount[l] - 1);
+
+            for (k = k1 ; k <= k2 ; k++)
+            {
+                start[k + 1]++;
+            }
+        }
+
+        // Turn the counts into offsets of the first item.
+        start[0] = total;
+        for (k = 0 ; k < dstilecount[l] ; k++)
+        {
+            start[k + 1] += start[k];
+        }
+        total = start[dstilecount[l]];
+    }
+
+    if (dstileitems_size < total)
+    {
+        dstileitems_size = 2 * total;
+        dstileitems = I_Realloc(dstileitems, dstileitems_size * sizeof(*dstileitems));
+    }
+
+    // Fill the tiles, keeping the order of the items. The start offsets
+    // are advanced while filling and moved back afterwards.
+    for (l = 0 ; l < DS_TILE_LEVELS ; l++)
+    {
+        const int step = (DS_TILE_MIN / 2) << l;
+        int *start = dstilestart[l];
+
+        for (i = 0 ; i < count ; i++)
+        {
+            const int k1 = MAX(items[i].x1 / step - 1, 0);
+            const int k2 = MIN(items[i].x2 / step, dstilecount[l] - 1);
+
+            for (k = k1 ; k <= k2 ; k++)
+            {
+                dstileitems[start[k]++] = items[i];
+            }
+        }
+
+        for (k = dstilecount[l] - 1 ; k > 0 ; k--)
+        {
+            start[k] = start[k - 1];
+        }
+        start[0] = l ? dstilestart[l - 1][dstilecount[l - 1]] : 0;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// R_SetDrawsegTile
+// [JN] Chooses the smallest tile holding the whole sprite, if any.
+// -----------------------------------------------------------------------------
+
+static boolean R_SetDrawsegTile (const vissprite_t *spr)
+{
+    const int width = spr->x2 - spr->x1 + 1;
+    int l;
+
+    for (l = 0 ; l < DS_TILE_LEVELS ; l++)
+    {
+        const int step = (DS_TILE_MIN / 2) << l;
+
+        if (width <= step)
+        {
+            const int k = spr->x1 / step;
+
+            drawsegs_xrange = dstileitems + dstilestart[l][k];
+            drawsegs_xrange_count = dstilestart[l][k + 1] - dstilestart[l][k];
+            return true;
+        }
+    }
+
+    return false;
+}
+
 // -------------------------------------------------------------------------
 //
 // R_DrawMasked
@@ -1442,6 +1687,15 @@ void R_DrawMasked (void)
         }
     }
 
+    // [JN] With many sprites, index drawsegs by tiles of columns,
+    // so every sprite only checks the drawsegs near to it.
+    dstileactive = num_vissprite >= DS_TILE_SPRITES;
+
+    if (dstileactive)
+    {
+        R_BuildDrawsegTiles();
+    }
+
     // draw all vissprites back to front
 
     rendered_vissprites = num_vissprite;
@@ -1449,7 +1703,11 @@ void R_DrawMasked (void)
     {
         vissprite_t* spr = vissprite_ptrs[i];
 
-        if (spr->x2 < centerx)
+        if (dstileactive && R_SetDrawsegTile(spr))
+        {
+            // drawsegs_xrange is set to the tile
+        }
+        else if (spr->x2 < centerx)
         {
             drawsegs_xrange = drawsegs_xranges[1].items;
             drawsegs_xrange_count = drawsegs_xranges[1].count;
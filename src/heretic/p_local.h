@@ -146,6 +146,16 @@ extern void P_InitThinkers (void);
 extern void P_RemoveThinker (thinker_t *thinker);
 extern void P_Ticker (void);
 
+/* 
+================================================================================
+=
+= P_PROF
+=
+================================================================================
+*/
+
+extern void P_InitProfile (void);
+
 /* 
 ================================================================================
 =
@@ -463,6 +473,9 @@ typedef struct
     int basepic;
     int numpics;
     int speed;
+    int frame;       // [JN] Frame set in the translations, -1 if none yet.
+    boolean swirl;   // [JN] Swirling was set instead of the frame.
+    boolean shared;  // [JN] Shares pics with an earlier animation.
 } anim_t;
 
 // Source animation definition
@@ -510,6 +523,7 @@ extern const fixed_t P_FindNextHighestFloor (const sector_t *sec, const int curr
 extern const int EV_DoDonut (const line_t *line);
 extern const int P_FindMinSurroundingLight (const sector_t *sector, const int max);
 extern const int P_FindSectorFromLineTag (const line_t *line, const int start);
+extern void P_InitTagLists (void);
 extern const int twoSided (const int sector, const int line);
 
 extern const sector_t *getNextSector (const line_t *line, const sector_t *sec);
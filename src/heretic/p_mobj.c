@@ -21,6 +21,7 @@
 
 #include "hr_local.h"
 #include "i_system.h"
+#include "m_prof.h"
 #include "p_local.h"
 #include "sounds.h"
 #include "s_sound.h"
@@ -99,7 +100,8 @@ boolean P_SetMobjState (mobj_t *mobj, statenum_t state)
     mobj->frame = st->frame;
     if (st->action)
     {                           // Call action function
-        st->action(mobj, NULL, NULL);
+        M_PROFCALL(PROF_ACTION, st->action, mobj->type,
+                   st->action(mobj, NULL, NULL));
     }
     return (true);
 }
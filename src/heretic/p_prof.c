@@ -0,0 +1,180 @@
+//
+// Copyright(C) 2016-2023 Julian Nechaevsky
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// DESCRIPTION:
+//	Names of action functions and thinkers for profiling, see m_prof.c.
+//
+
+
+#include "hr_local.h"
+#include "m_prof.h"
+#include "p_action.h"
+#include "p_local.h"
+
+
+#define PROFNAME(f) { (proffunc_t) f, #f }
+
+static const profname_t profnames[] = {
+    // Thinkers.
+    PROFNAME(P_MobjThinker),
+    PROFNAME(P_BlasterMobjThinker),
+    PROFNAME(T_MoveFloor),
+    PROFNAME(T_MoveCeiling),
+    PROFNAME(T_VerticalDoor),
+    PROFNAME(T_PlatRaise),
+    PROFNAME(T_LightFlash),
+    PROFNAME(T_StrobeFlash),
+    PROFNAME(T_Glow),
+
+    // Action functions.
+    PROFNAME(A_FreeTargMobj),
+    PROFNAME(A_RestoreSpecialThing1),
+    PROFNAME(A_RestoreSpecialThing2),
+    PROFNAME(A_HideThing),
+    PROFNAME(A_UnHideThing),
+    PROFNAME(A_RestoreArtifact),
+    PROFNAME(A_Scream),
+    PROFNAME(A_Explode),
+    PROFNAME(A_PodPain),
+    PROFNAME(A_RemovePod),
+    PROFNAME(A_MakePod),
+    PROFNAME(A_InitKeyGizmo),
+    PROFNAME(A_VolcanoSet),
+    PROFNAME(A_VolcanoBlast),
+    PROFNAME(A_BeastPuff),
+    PROFNAME(A_VolcBallImpact),
+    PROFNAME(A_SpawnTeleGlitter),
+    PROFNAME(A_SpawnTeleGlitter2),
+    PROFNAME(A_AccTeleGlitter),
+    PROFNAME(A_Light0),
+    PROFNAME(A_WeaponReady),
+    PROFNAME(A_Lower),
+    PROFNAME(A_Raise),
+    PROFNAME(A_StaffAttackPL1),
+    PROFNAME(A_ReFire),
+    PROFNAME(A_StaffAttackPL2),
+    PROFNAME(A_BeakReady),
+    PROFNAME(A_BeakRaise),
+    PROFNAME(A_BeakAttackPL1),
+    PROFNAME(A_BeakAttackPL2),
+    PROFNAME(A_GauntletAttack),
+    PROFNAME(A_FireBlasterPL1),
+    PROFNAME(A_FireBlasterPL2),
+    PROFNAME(A_SpawnRippers),
+    PROFNAME(A_FireMacePL1),
+    PROFNAME(A_FireMacePL2),
+    PROFNAME(A_MacePL1Check),
+    PROFNAME(A_MaceBallImpact),
+    PROFNAME(A_MaceBallImpact2),
+    PROFNAME(A_DeathBallImpact),
+    PROFNAME(A_FireSkullRodPL1),
+    PROFNAME(A_FireSkullRodPL2),
+    PROFNAME(A_SkullRodPL2Seek),
+    PROFNAME(A_AddPlayerRain),
+    PROFNAME(A_HideInCeiling),
+    PROFNAME(A_SkullRodStorm),
+    PROFNAME(A_RainImpact),
+    PROFNAME(A_FireGoldWandPL1),
+    PROFNAME(A_FireGoldWandPL2),
+    PROFNAME(A_FirePhoenixPL1),
+    PROFNAME(A_InitPhoenixPL2),
+    PROFNAME(A_FirePhoenixPL2),
+    PROFNAME(A_ShutdownPhoenixPL2),
+    PROFNAME(A_PhoenixPuff),
+    PROFNAME(A_RemovedPhoenixFunc),
+    PROFNAME(A_FlameEnd),
+    PROFNAME(A_FloatPuff),
+    PROFNAME(A_FireCrossbowPL1),
+    PROFNAME(A_FireCrossbowPL2),
+    PROFNAME(A_BoltSpark),
+    PROFNAME(A_Pain),
+    PROFNAME(A_NoBlocking),
+    PROFNAME(A_AddPlayerCorpse),
+    PROFNAME(A_SkullPop),
+    PROFNAME(A_FlameSnd),
+    PROFNAME(A_CheckBurnGone),
+    PROFNAME(A_CheckSkullFloor),
+    PROFNAME(A_CheckSkullDone),
+    PROFNAME(A_Feathers),
+    PROFNAME(A_ChicLook),
+    PROFNAME(A_ChicChase),
+    PROFNAME(A_ChicPain),
+    PROFNAME(A_FaceTarget),
+    PROFNAME(A_ChicAttack),
+    PROFNAME(A_Look),
+    PROFNAME(A_Chase),
+    PROFNAME(A_MummyAttack),
+    PROFNAME(A_MummyAttack2),
+    PROFNAME(A_MummySoul),
+    PROFNAME(A_ContMobjSound),
+    PROFNAME(A_MummyFX1Seek),
+    PROFNAME(A_BeastAttack),
+    PROFNAME(A_SnakeAttack),
+    PROFNAME(A_SnakeAttack2),
+    PROFNAME(A_HeadAttack),
+    PROFNAME(A_BossDeath),
+    PROFNAME(A_HeadIceImpact),
+    PROFNAME(A_HeadFireGrow),
+    PROFNAME(A_WhirlwindSeek),
+    PROFNAME(A_ClinkAttack),
+    PROFNAME(A_WizAtk1),
+    PROFNAME(A_WizAtk2),
+    PROFNAME(A_WizAtk3),
+    PROFNAME(A_GhostOff),
+    PROFNAME(A_ImpMeAttack),
+    PROFNAME(A_ImpMsAttack),
+    PROFNAME(A_ImpMsAttack2),
+    PROFNAME(A_ImpDeath),
+    PROFNAME(A_ImpXDeath1),
+    PROFNAME(A_ImpXDeath2),
+    PROFNAME(A_ImpExplode),
+    PROFNAME(A_KnightAttack),
+    PROFNAME(A_DripBlood),
+    PROFNAME(A_Sor1Chase),
+    PROFNAME(A_Sor1Pain),
+    PROFNAME(A_Srcr1Attack),
+    PROFNAME(A_SorZap),
+    PROFNAME(A_SorcererRise),
+    PROFNAME(A_SorRise),
+    PROFNAME(A_SorSightSnd),
+    PROFNAME(A_Srcr2Decide),
+    PROFNAME(A_Srcr2Attack),
+    PROFNAME(A_Sor2DthInit),
+    PROFNAME(A_SorDSph),
+    PROFNAME(A_Sor2DthLoop),
+    PROFNAME(A_SorDExp),
+    PROFNAME(A_SorDBon),
+    PROFNAME(A_BlueSpark),
+    PROFNAME(A_GenWizard),
+    PROFNAME(A_MinotaurAtk1),
+    PROFNAME(A_MinotaurDecide),
+    PROFNAME(A_MinotaurAtk2),
+    PROFNAME(A_MinotaurAtk3),
+    PROFNAME(A_MinotaurCharge),
+    PROFNAME(A_MntrFloorFire),
+    PROFNAME(A_ESound),
+    { NULL, NULL }
+};
+
+/*
+================================================================================
+=
+= P_InitProfile
+=
+================================================================================
+*/
+
+void P_InitProfile (void)
+{
+    M_ProfInit(profnames);
+}
@@ -20,6 +20,7 @@
 
 #include "hr_local.h"
 #include "i_system.h"
+#include "m_prof.h"
 #include "p_local.h"
 #include "s_sound.h"
 #include "jn.h"
@@ -354,7 +355,8 @@ void P_SetPsprite (const player_t *player, const int position, statenum_t stnum)
         }
         if (state->action)
         {                       // Call action routine.
-            state->action(NULL, player, psp);
+            M_PROFCALL(PROF_WEAPON, state->action, -1,
+                       state->action(NULL, player, psp));
             if (!psp->state)
             {
                 break;
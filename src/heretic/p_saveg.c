@@ -1650,6 +1650,9 @@ void P_UnArchiveWorld(void)
             si->midtexture = SV_ReadWord();
         }
     }
+
+    // [JN] sector tags are restored too
+    P_InitTagLists();
 }
 
 //=============================================================================
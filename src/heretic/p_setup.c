@@ -29,6 +29,7 @@
 #include "i_system.h"
 #include "m_argv.h"
 #include "m_bbox.h"
+#include "m_prof.h"
 #include "p_local.h"
 #include "s_sound.h"
 #include "jn.h"
@@ -2019,6 +2020,9 @@ void P_SetupLevel (int episode, int map, int playermask, skill_t skill)
 
     lumpnum = W_GetNumForName(lumpname);
 
+    // [JN] Report the actions and thinkers of the previous level.
+    M_ProfLevel(lumpname);
+
     // [JN] Checking for multiple map lump names for allowing map fixes to work.
     // Adaptaken from DOOM Retro, thanks Brad Harding!
     canmodify = (W_CheckMultipleLumps(lumpname) == 1
@@ -2078,6 +2082,8 @@ void P_SetupLevel (int episode, int map, int playermask, skill_t skill)
     }
 
     P_GroupLines ();
+    // [JN] chain sectors by tag for specials
+    P_InitTagLists ();
     P_LoadReject (lumpnum+ML_REJECT);
 
     // [crispy] remove slime trails
@@ -2162,4 +2168,5 @@ void P_Init(void)
     P_InitTerrainTypes();
     P_InitLava();
     R_InitSprites(sprnames);
+    P_InitProfile();
 }
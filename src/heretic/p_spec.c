@@ -315,6 +315,18 @@ void P_InitPicAnims (void)
             continue;
         }
         lastanim->speed = animdefs[i].speed;
+        lastanim->frame = -1;
+        lastanim->shared = false;
+
+        for (anim_t *prev = anims; prev < lastanim; prev++)
+        {
+            if (prev->istexture == lastanim->istexture
+            &&  prev->basepic <= lastanim->picnum && lastanim->basepic <= prev->picnum)
+            {
+                lastanim->shared = true;
+            }
+        }
+
         lastanim++;
     }
 
@@ -547,6 +559,42 @@ const fixed_t P_FindHighestCeilingSurrounding (const sector_t *sec)
     return height;
 }
 
+/*
+================================================================================
+=
+= P_InitTagLists
+=
+= [JN] Chains sectors of every tag in ascending order, hashed by tag,
+= so P_FindSectorFromLineTag doesn't have to scan all of the sectors.
+= Must be called again whenever sector tags change.
+=
+================================================================================
+*/
+
+static int *sectortaghead;  // First sector of each hash bucket.
+static int *sectortagnext;  // Next sector of the same bucket.
+
+void P_InitTagLists (void)
+{
+    int i;
+
+    sectortaghead = I_Realloc(sectortaghead, numsectors * sizeof(*sectortaghead));
+    sectortagnext = I_Realloc(sectortagnext, numsectors * sizeof(*sectortagnext));
+
+    for (i = 0; i < numsectors; i++)
+    {
+        sectortaghead[i] = -1;
+    }
+
+    for (i = numsectors - 1; i >= 0; i--)
+    {
+        const int j = (unsigned) sectors[i].tag % numsectors;
+
+        sectortagnext[i] = sectortaghead[j];
+        sectortaghead[j] = i;
+    }
+}
+
 /*
 ================================================================================
 
@@ -557,14 +605,29 @@ const fixed_t P_FindHighestCeilingSurrounding (const sector_t *sec)
 
 const int P_FindSectorFromLineTag (const line_t *line, const int start)
 {
-    for (int i = start + 1; i < numsectors; i++)
+    int i;
+
+    // [JN] Only sectors of the same tag are certainly in the same chain.
+    if (start >= 0 && sectors[start].tag != line->tag)
     {
-        if (sectors[i].tag == line->tag)
+        for (i = start + 1; i < numsectors; i++)
         {
-            return i;
+            if (sectors[i].tag == line->tag)
+            {
+                return i;
+            }
         }
+        return -1;
     }
-    return -1;
+
+    i = start < 0 ? sectortaghead[(unsigned) line->tag % numsectors]
+                  : sectortagnext[start];
+
+    while (i >= 0 && sectors[i].tag != line->tag)
+    {
+        i = sectortagnext[i];
+    }
+    return i;
 }
 
 /*
@@ -1055,30 +1118,41 @@ void P_UpdateSpecials (void)
     int i;
     int pic;
     anim_t *anim;
+    boolean changed;
     line_t *line;
 
     // Animate flats and textures
-    for (anim = anims; anim < lastanim; anim++)
+    // [JN] The pics only change along with the frame of an animation,
+    // so the translations are set then only. Animations sharing pics
+    // are set again after an earlier one, to keep the same one on top.
+    for (anim = anims, changed = false; anim < lastanim; anim++)
     {
+        const int frame = leveltime / anim->speed;
+        // [crispy] add support for SMMU swirling flats
+        // [JN] Animate only surface with animation == 9,
+        // i.e. only those ones, which defined in animdefs.
+        const boolean swirl = !anim->istexture && anim->speed == 9
+                           && swirling_liquids && !vanillaparm;
+
+        if (frame == anim->frame && swirl == anim->swirl && !(anim->shared && changed))
+        {
+            continue;
+        }
+
+        anim->frame = frame;
+        anim->swirl = swirl;
+        changed = true;
+
         for (i = anim->basepic; i < anim->basepic + anim->numpics; i++)
         {
-            pic =
-                anim->basepic +
-                ((leveltime / anim->speed + i) % anim->numpics);
+            pic = anim->basepic + ((frame + i) % anim->numpics);
             if (anim->istexture)
             {
                 texturetranslation[i] = pic;
             }
-            // [crispy] add support for SMMU swirling flats
-            // [JN] Animate only surface with animation == 9,
-            // i.e. only those ones, which defined in animdefs.
-            else if (anim->speed == 9 && swirling_liquids && !vanillaparm)
-            {
-                flattranslation[i] = -1;
-            }
             else
             {
-                flattranslation[i] = pic;
+                flattranslation[i] = swirl ? -1 : pic;
             }
         }
     }
@@ -42,6 +42,9 @@ static const switchlist_t alphSwitchList[] =
 
 static int switchlist[MAXSWITCHES * 2];
 static int numswitches;
+static int *switchfirst;                // [JN] First entry of every texture, or -1.
+static int switchnext[MAXSWITCHES * 2]; // [JN] Next entry of the same texture, or -1.
+static int switchtextures;              // [JN] Size of switchfirst.
 
 button_t buttonlist[MAXBUTTONS];
 
@@ -81,6 +84,57 @@ void P_InitSwitchList (void)
                 R_TextureNumForName(DEH_String(alphSwitchList[i].name2));
         }
     }
+
+    // [JN] Index the list by texture, so switches don't have to search it.
+    switchtextures = 0;
+    for (int i = 0; i < numswitches * 2; i++)
+    {
+        switchtextures = MAX(switchtextures, switchlist[i] + 1);
+    }
+
+    switchfirst = Z_Malloc((switchtextures + 1) * sizeof(*switchfirst), PU_STATIC, 0);
+    for (int i = 0; i < switchtextures; i++)
+    {
+        switchfirst[i] = -1;
+    }
+
+    for (int i = numswitches * 2 - 1; i >= 0; i--)
+    {
+        switchnext[i] = switchfirst[switchlist[i]];
+        switchfirst[switchlist[i]] = i;
+    }
+}
+
+/*
+================================================================================
+=
+= P_SwitchFirst, P_SwitchEarliest
+=
+= [JN] First entry of a texture in the switch list, and the earliest
+= one of the given entries. Both return -1 for none.
+=
+================================================================================
+*/
+
+static int P_SwitchFirst (const int texture)
+{
+    return texture >= 0 && texture < switchtextures ? switchfirst[texture] : -1;
+}
+
+static int P_SwitchEarliest (const int a, const int b, const int c)
+{
+    int i = a;
+
+    if (b >= 0 && (i < 0 || b < i))
+    {
+        i = b;
+    }
+    if (c >= 0 && (i < 0 || c < i))
+    {
+        i = c;
+    }
+
+    return i;
 }
 
 /*
@@ -129,7 +183,9 @@ void P_ChangeSwitchTexture (line_t *line, const boolean useAgain)
     int texTop;
     int texMid;
     int texBot;
+    int nextTop, nextMid, nextBot;
     int sound;
+    int i;
     // [crispy] register up to three buttons at once 
     // for lines with more than one switch texture.
     boolean playsound = false;
@@ -145,10 +201,17 @@ void P_ChangeSwitchTexture (line_t *line, const boolean useAgain)
 
     sound = sfx_switch;
 
-    for (int i = 0 ; i < numswitches * 2 ; i++)
+    // [JN] Only the entries of the three textures are gone through,
+    // in the order of the list, as if it were searched all over.
+    nextTop = P_SwitchFirst(texTop);
+    nextMid = P_SwitchFirst(texMid);
+    nextBot = P_SwitchFirst(texBot);
+
+    while ((i = P_SwitchEarliest(nextTop, nextMid, nextBot)) != -1)
     {
-        if (switchlist[i] == texTop)
+        if (i == nextTop)
         {
+            nextTop = switchnext[i];
             playsound = true;
             sides[line->sidenum[0]].toptexture = switchlist[i ^ 1];
             if (useAgain)
@@ -156,8 +219,9 @@ void P_ChangeSwitchTexture (line_t *line, const boolean useAgain)
                 P_StartButton(line, top, switchlist[i], BUTTONTIME);
             }
         }
-        if (switchlist[i] == texMid)
+        if (i == nextMid)
         {
+            nextMid = switchnext[i];
             playsound = true;
             sides[line->sidenum[0]].midtexture = switchlist[i ^ 1];
             if (useAgain)
@@ -165,8 +229,9 @@ void P_ChangeSwitchTexture (line_t *line, const boolean useAgain)
                 P_StartButton(line, middle, switchlist[i], BUTTONTIME);
             }
         }
-        if (switchlist[i] == texBot)
+        if (i == nextBot)
         {
+            nextBot = switchnext[i];
             playsound = true;
             sides[line->sidenum[0]].bottomtexture = switchlist[i ^ 1];
             if (useAgain)
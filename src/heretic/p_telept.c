@@ -128,7 +128,6 @@ boolean P_Teleport (mobj_t * thing, fixed_t x, fixed_t y, angle_t angle)
 boolean EV_Teleport (const line_t *line, const int side, const mobj_t *thing)
 {
     int i;
-    int tag;
     mobj_t *m;
     thinker_t *thinker;
     sector_t *sector;
@@ -141,31 +140,27 @@ boolean EV_Teleport (const line_t *line, const int side, const mobj_t *thing)
     {                           // Don't teleport when crossing back side
         return (false);
     }
-    tag = line->tag;
-    for (i = 0; i < numsectors; i++)
+    for (i = -1; (i = P_FindSectorFromLineTag(line, i)) >= 0;)
     {
-        if (sectors[i].tag == tag)
+        thinker = thinkercap.next;
+        for (thinker = thinkercap.next; thinker != &thinkercap;
+             thinker = thinker->next)
         {
-            thinker = thinkercap.next;
-            for (thinker = thinkercap.next; thinker != &thinkercap;
-                 thinker = thinker->next)
-            {
-                if (thinker->function != P_MobjThinker)
-                {               // Not a mobj
-                    continue;
-                }
-                m = (mobj_t *) thinker;
-                if (m->type != MT_TELEPORTMAN)
-                {               // Not a teleportman
-                    continue;
-                }
-                sector = m->subsector->sector;
-                if (sector - sectors != i)
-                {               // Wrong sector
-                    continue;
-                }
-                return (P_Teleport(thing, m->x, m->y, m->angle));
+            if (thinker->function != P_MobjThinker)
+            {               // Not a mobj
+                continue;
+            }
+            m = (mobj_t *) thinker;
+            if (m->type != MT_TELEPORTMAN)
+            {               // Not a teleportman
+                continue;
+            }
+            sector = m->subsector->sector;
+            if (sector - sectors != i)
+            {               // Wrong sector
+                continue;
             }
+            return (P_Teleport(thing, m->x, m->y, m->angle));
         }
     }
     return (false);
@@ -20,6 +20,7 @@
 
 #include "hr_local.h"
 #include "i_system.h"
+#include "m_prof.h"
 #include "p_local.h"
 #include "v_video.h"
 #include "jn.h"
@@ -89,6 +90,25 @@ void P_RemoveThinker (thinker_t *thinker)
     thinker->function = (think_t) - 1;
 }
 
+/*
+================================================================================
+=
+= P_RunThinker
+=
+= [JN] Runs a single thinker, timed if profiling.
+=
+================================================================================
+*/
+
+static void P_RunThinker (thinker_t *thinker)
+{
+    M_PROFCALL(PROF_THINKER, thinker->function,
+               thinker->function == P_MobjThinker
+            || thinker->function == P_BlasterMobjThinker ?
+               ((mobj_t *) thinker)->type : -1,
+               thinker->function(thinker));
+}
+
 /*
 ================================================================================
 =
@@ -111,7 +131,7 @@ static void P_RunThinkers (void)
         {
             if (currentthinker->function)
                 if (currentthinker->function == P_MobjThinker)
-                    currentthinker->function (currentthinker);
+                    P_RunThinker(currentthinker);
             
             nextthinker = currentthinker->next;
             currentthinker = nextthinker;
@@ -135,14 +155,14 @@ static void P_RunThinkers (void)
             {
                 if (currentthinker->function)
                     if (currentthinker->function != P_MobjThinker)
-                        currentthinker->function (currentthinker);
+                        P_RunThinker(currentthinker);
 
                 nextthinker = currentthinker->next;
             }
             else
             {
                 if (currentthinker->function)
-                    currentthinker->function(currentthinker);
+                    P_RunThinker(currentthinker);
 
                 nextthinker = currentthinker->next;
             }
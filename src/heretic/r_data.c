@@ -992,6 +992,13 @@ static void R_InitTransMaps (void)
         transtable20 = Z_Malloc(256*256, PU_STATIC, 0);
         transtable10 = Z_Malloc(256*256, PU_STATIC, 0);
 
+        byte *transtables[] = {
+            transtable90, transtable80, transtable70, transtable60, transtable50,
+            transtable40, transtable30, transtable20, transtable10
+        };
+
+        // [JN] Use tables generated for this palette before, if any.
+        if (!V_LoadTransMaps(playpal, transtables, arrlen(transtables)))
         {
             byte *fg, *bg, blend[3];
             byte *tp90 = transtable90;
@@ -1069,6 +1076,8 @@ static void R_InitTransMaps (void)
                     *tp10++ = V_GetPaletteIndex(playpal, blend[r], blend[g], blend[b]);
                 }
             }
+
+            V_SaveTransMaps(playpal, transtables, arrlen(transtables));
         }
 
         W_ReleaseLumpName("PLAYPAL");
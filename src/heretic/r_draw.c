@@ -61,83 +61,14 @@ const byte         *ds_brightmap;
 =
 = R_DrawColumn
 =
+= [JN] Column drawers are generated from the template in r_drawcol.h.
+=
 ================================================================================
 */
-
-void R_DrawColumn (void)
-{
-    int      count = dc_yh - dc_yl;
-    byte    *dest;
-    fixed_t  frac, fracstep;
-
-    // Zero length, column does not exceed a pixel.
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK
-    if ((unsigned)dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-        I_Error (english_language ?
-                 "R_DrawColumn: %i to %i at %i" :
-                 "R_DrawColumn: %i к %i в %i",
-                 dc_yl, dc_yh, dc_x);
-#endif
-
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-    fracstep = dc_iscale;
-    frac = dc_texturemid + (dc_yl-centery) * fracstep;
-
-    // Inner loop that does the actual texture mapping, e.g. a DDA-lile scaling.
-    // This is as fast as it gets.
-    // [JN] killough 2/1/98: more performance tuning
-    {
-        const byte *source = dc_source;
-        const byte *brightmap = dc_brightmap;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight - 1;
-
-        if (dc_texheight & heightmask)   // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-
-            if (frac < 0)
-                while ((frac += heightmask) < 0);
-            else
-                while (frac >= heightmask)
-                       frac -= heightmask;
-
-            do
-            {
-                // Re-map color indices from wall texture column
-                //  using a lighting/special effects LUT.
-                // [JN] heightmask is the Tutti-Frutti fix -- killough
-                // [crispy] brightmaps
-                const byte src = source[frac>>FRACBITS];
-
-                *dest = colormap[brightmap[src]][src];
-                dest += screenwidth;
-                if ((frac += fracstep) >= heightmask)
-                {
-                    frac -= heightmask;
-                }
-            } while (count--);
-        }
-        else  // texture height is a power of 2 -- killough
-        {
-            do
-            {
-                // [crispy] brightmaps
-                const byte src = source[(frac>>FRACBITS)&heightmask];
-
-                *dest = colormap[brightmap[src]][src];
-                dest += screenwidth; 
-                frac += fracstep;
-            } while (count--); 
-        }
-    }
-}
+#define COLFUNC   R_DrawColumn
+#define COLWRAP   1
+#define COLBRIGHT 1
+#include "r_drawcol.h"
 
 /*
 ================================================================================
@@ -149,87 +80,11 @@ void R_DrawColumn (void)
 ================================================================================
 */
 
-void R_DrawColumnLow (void)
-{
-    const int x = dc_x << 1;  // Blocky mode, need to multiply by 2.
-    int       count = dc_yh - dc_yl; 
-    byte     *dest1, *dest2, *dest3, *dest4;
-    fixed_t   frac, fracstep;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK
-    if ((unsigned) dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-        I_Error(english_language ?
-                "R_DrawColumnLow: %i to %i at %i" :
-                "R_DrawColumnLow: %i к %i в %i",
-                dc_yl, dc_yh, dc_x);
-#endif
-
-    dest1 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
-    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x + 1]];
-    dest3 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x]];
-    dest4 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x + 1]];
-    fracstep = dc_iscale; 
-    frac = dc_texturemid + (dc_yl-centery) * fracstep;
-
-    // Inner loop that does the actual texture mapping, e.g. a DDA-lile scaling.
-    {
-        const byte *source = dc_source;
-        const byte *brightmap = dc_brightmap;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight - 1;
-
-        if (dc_texheight & heightmask)  // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-
-            if (frac < 0)
-                while ((frac += heightmask) < 0);
-            else
-                while (frac >= heightmask)
-                       frac -= heightmask;
-
-            do
-            {
-                // [crispy] brightmaps
-                const byte src = source[frac>>FRACBITS];
-                *dest4 = *dest3 = *dest2 = *dest1 = colormap[brightmap[src]][src];
-
-                dest1 += screenwidth << hires;
-                dest2 += screenwidth << hires;
-                dest3 += screenwidth << hires;
-                dest4 += screenwidth << hires;
-
-                if ((frac += dc_iscale) >= heightmask)
-                {
-                    frac -= heightmask;
-                }
-            } while (count--);
-        }
-        else  // texture height is a power of 2 -- killough
-        {
-            do 
-            {
-                // [crispy] brightmaps
-                const byte src = source[(frac>>FRACBITS)&heightmask];
-                *dest4 = *dest3 = *dest2 = *dest1 = colormap[brightmap[src]][src];
-
-                dest1 += screenwidth << hires;
-                dest2 += screenwidth << hires;
-                dest3 += screenwidth << hires;
-                dest4 += screenwidth << hires;
-
-                frac += fracstep; 
-
-            } while (count--);
-        }
-    }
-}
+#define COLFUNC   R_DrawColumnLow
+#define COLLOW    1
+#define COLWRAP   1
+#define COLBRIGHT 1
+#include "r_drawcol.h"
 
 /*
 ================================================================================
@@ -391,68 +246,10 @@ void R_DrawSkyColumnLow(void)
 ================================================================================
 */
 
-void R_DrawTLColumn (void)
-{
-    int      count = dc_yh - dc_yl;
-    byte    *dest;
-    fixed_t  frac, fracstep;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK
-    if ((unsigned)dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawTLColumn: %i to %i at %i" :
-                 "R_DrawTLColumn: %i к %i у %i",
-                 dc_yl, dc_yh, dc_x);
-    }
-#endif
-
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-    fracstep = dc_iscale; 
-    frac = dc_texturemid + (dc_yl - centery) * fracstep;
-
-    {
-        const byte *source = dc_source;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight - 1;
-
-        if (dc_texheight & heightmask)  // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-
-            if (frac < 0)
-                while ((frac += heightmask) < 0);
-            else
-                while (frac >= heightmask)
-                       frac -= heightmask;
-
-            do
-            {
-                *dest = tinttable[(*dest << 8) + colormap[0][source[frac >> FRACBITS]]];
-                dest += screenwidth;
-                if ((frac += fracstep) >= heightmask)
-                {
-                    frac -= heightmask;
-                }
-            } while (count--);
-        }
-        else  // texture height is a power of 2 -- killough
-        {
-            do
-            {
-                *dest = tinttable[(*dest << 8) + colormap[0][source[(frac >> FRACBITS) & heightmask]]];
-                dest += screenwidth;
-                frac += fracstep;
-            } while (count--);
-        }
-    }
-}
+#define COLFUNC   R_DrawTLColumn
+#define COLWRAP   1
+#define COLBLEND  tinttable
+#include "r_drawcol.h"
 
 /*
 ================================================================================
@@ -464,92 +261,11 @@ void R_DrawTLColumn (void)
 ================================================================================
 */
 
-void R_DrawTLColumnLow (void)
-{
-    const int x = dc_x << 1;  // Blocky mode, need to multiply by 2.
-    int       count = dc_yh - dc_yl;
-    byte     *dest1, *dest2, *dest3, *dest4;
-    fixed_t   frac, fracstep;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK
-    if ((unsigned)x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawTLColumnLow: %i to %i at %i" :
-                 "R_DrawTLColumnLow: %i к %i у %i",
-                 dc_yl, dc_yh, x);
-    }
-#endif
-
-    dest1 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
-    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x + 1]];
-    dest3 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x]];
-    dest4 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x + 1]];
-    fracstep = dc_iscale; 
-    frac  = dc_texturemid + (dc_yl-centery)*fracstep;
-
-    {
-        const byte *source = dc_source;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight - 1;
-
-        if (dc_texheight & heightmask)  // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-
-            if (frac < 0)
-                while ((frac += heightmask) < 0);
-            else
-                while (frac >= heightmask)
-                       frac -= heightmask;
-
-            do
-            {
-                const byte src = source[frac >> FRACBITS];
-
-                *dest1 = tinttable[(*dest1 << 8) + colormap[0][src]];
-                *dest2 = tinttable[(*dest2 << 8) + colormap[0][src]];
-                *dest3 = tinttable[(*dest3 << 8) + colormap[0][src]];
-                *dest4 = tinttable[(*dest4 << 8) + colormap[0][src]];
-                dest1 += screenwidth << hires;
-                dest2 += screenwidth << hires;
-                dest3 += screenwidth << hires;
-                dest4 += screenwidth << hires;
-    
-                if ((frac += fracstep) >= heightmask)
-                {
-                    frac -= heightmask;
-                }
-            } while (count--);
-        }
-        else  // texture height is a power of 2 -- killough
-        {
-            do 
-            {
-                const byte src = source[(frac >> FRACBITS) & heightmask];
-
-                *dest1 = tinttable[(*dest1 << 8) +colormap[0][src]];
-                *dest2 = tinttable[(*dest2 << 8) +colormap[0][src]];
-                *dest3 = tinttable[(*dest3 << 8) +colormap[0][src]];
-                *dest4 = tinttable[(*dest4 << 8) +colormap[0][src]];
-    
-                dest1 += screenwidth << hires;
-                dest2 += screenwidth << hires;
-                dest3 += screenwidth << hires;
-                dest4 += screenwidth << hires;
-    
-                frac += fracstep; 
-
-            } while (count--);
-        }
-    }
-}
+#define COLFUNC   R_DrawTLColumnLow
+#define COLLOW    1
+#define COLWRAP   1
+#define COLBLEND  tinttable
+#include "r_drawcol.h"
 
 /*
 ================================================================================
@@ -561,73 +277,11 @@ void R_DrawTLColumnLow (void)
 ================================================================================
 */
 
-void R_DrawExtraTLColumn (void)
-{
-    int      count = dc_yh - dc_yl;
-    byte    *dest;
-    fixed_t  frac, fracstep;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK
-    if ((unsigned)dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawTLColumn: %i to %i at %i" :
-                 "R_DrawTLColumn: %i к %i у %i",
-                 dc_yl, dc_yh, dc_x);
-    }
-#endif
-
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-    fracstep = dc_iscale; 
-    frac = dc_texturemid + (dc_yl - centery) * fracstep;
-
-    {
-        const byte *source = dc_source;
-        const byte *brightmap = dc_brightmap;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight - 1;
-
-        if (dc_texheight & heightmask)  // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-
-            if (frac < 0)
-                while ((frac += heightmask) < 0);
-            else
-                while (frac >= heightmask)
-                       frac -= heightmask;
-
-            do
-            {
-                const byte src = source[frac >> FRACBITS];
-
-                *dest = transtable80[(*dest << 8) + colormap[brightmap[src]][src]];
-                dest += screenwidth;
-                if ((frac += fracstep) >= heightmask)
-                {
-                    frac -= heightmask;
-                }
-            } while (count--);
-        }
-        else  // texture height is a power of 2 -- killough
-        {
-            do
-            {
-                const byte src = source[(frac >> FRACBITS) & heightmask];
-                
-                *dest = transtable80[(*dest << 8) + colormap[brightmap[src]][src]];
-                dest += screenwidth;
-                frac += fracstep;
-            } while (count--);
-        }
-    }
-}
+#define COLFUNC   R_DrawExtraTLColumn
+#define COLWRAP   1
+#define COLBRIGHT 1
+#define COLBLEND  transtable80
+#include "r_drawcol.h"
 
 /*
 ================================================================================
@@ -639,94 +293,12 @@ void R_DrawExtraTLColumn (void)
 ================================================================================
 */
 
-void R_DrawExtraTLColumnLow (void)
-{
-    const int x = dc_x << 1;  // Blocky mode, need to multiply by 2.
-    int       count = dc_yh - dc_yl;
-    byte     *dest1, *dest2, *dest3, *dest4;
-    fixed_t   frac, fracstep;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK
-    if ((unsigned)x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawExtraTLColumnLow: %i to %i at %i" :
-                 "R_DrawTLColumnLow: %i к %i у %i",
-                 dc_yl, dc_yh, x);
-    }
-#endif
-
-    dest1 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
-    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x + 1]];
-    dest3 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x]];
-    dest4 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x + 1]];
-    fracstep = dc_iscale; 
-    frac  = dc_texturemid + (dc_yl-centery)*fracstep;
-
-    {
-        const byte *source = dc_source;
-        const byte *brightmap = dc_brightmap;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight - 1;
-
-        if (dc_texheight & heightmask) // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-
-            if (frac < 0)
-                while ((frac += heightmask) < 0);
-            else
-                while (frac >= heightmask)
-                       frac -= heightmask;
-
-            do
-            {
-                const byte src = source[frac >> FRACBITS];
-
-                *dest1 = transtable80[(*dest1 << 8) + colormap[brightmap[src]][src]];
-                *dest2 = transtable80[(*dest2 << 8) + colormap[brightmap[src]][src]];
-                *dest4 = transtable80[(*dest4 << 8) + colormap[brightmap[src]][src]];
-                *dest3 = transtable80[(*dest3 << 8) + colormap[brightmap[src]][src]];
-
-                dest1 += screenwidth << hires;
-                dest2 += screenwidth << hires;
-                dest3 += screenwidth << hires;
-                dest4 += screenwidth << hires;
-
-                if ((frac += fracstep) >= heightmask)
-                {
-                    frac -= heightmask;
-                }
-            } while (count--);
-        }
-        else // texture height is a power of 2 -- killough
-        {
-            do 
-            {
-                const byte src = source[(frac>>FRACBITS)&heightmask];
-
-                *dest1 = transtable80[(*dest1 << 8) + colormap[brightmap[src]][src]];
-                *dest2 = transtable80[(*dest2 << 8) + colormap[brightmap[src]][src]];
-                *dest3 = transtable80[(*dest3 << 8) + colormap[brightmap[src]][src]];
-                *dest4 = transtable80[(*dest4 << 8) + colormap[brightmap[src]][src]];
-
-                dest1 += screenwidth << hires;
-                dest2 += screenwidth << hires;
-                dest3 += screenwidth << hires;
-                dest4 += screenwidth << hires;
-
-                frac += fracstep; 
-
-            } while (count--);
-        }
-    }
-}
+#define COLFUNC   R_DrawExtraTLColumnLow
+#define COLLOW    1
+#define COLWRAP   1
+#define COLBRIGHT 1
+#define COLBLEND  transtable80
+#include "r_drawcol.h"
 
 /*
 ================================================================================
@@ -736,35 +308,9 @@ void R_DrawExtraTLColumnLow (void)
 ================================================================================
 */
 
-void R_DrawTranslatedColumn (void)
-{
-    int      count = dc_yh - dc_yl;
-    byte    *dest;
-    fixed_t  frac;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK
-    if ((unsigned) dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-        I_Error(english_language ?
-                "R_DrawColumn: %i to %i at %i" :
-                "R_DrawColumn: %i к %i в %i",
-                dc_yl, dc_yh, dc_x);
-#endif
-
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-    frac = dc_texturemid + (dc_yl - centery) * dc_iscale; 
-
-    do
-    {
-        *dest = dc_colormap[0][dc_translation[dc_source[frac >> FRACBITS]]];
-        dest += screenwidth;
-        frac += dc_iscale;
-    } while (count--);
-}
+#define COLFUNC   R_DrawTranslatedColumn
+#define COLTRANS  1
+#include "r_drawcol.h"
 
 /*
 ================================================================================
@@ -776,46 +322,10 @@ void R_DrawTranslatedColumn (void)
 ================================================================================
 */
 
-void R_DrawTranslatedColumnLow (void) 
-{ 
-    const int x = dc_x << 1;  // low detail, need to scale by 2
-    int       count = dc_yh - dc_yl; 
-    byte     *dest1, *dest2, *dest3, *dest4;
-    fixed_t   frac; 
-
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK 
-    if ((unsigned)x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        I_Error (english_language ?
-                 "R_DrawTranslatedColumnLow: %i to %i at %i" :
-                 "R_DrawTranslatedColumnLow: %i к %i у %i",
-                 dc_yl, dc_yh, x);
-    }
-#endif 
-
-    dest1 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
-    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x + 1]];
-    dest3 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x]];
-    dest4 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x + 1]];
-    frac = dc_texturemid + (dc_yl-centery)*dc_iscale; 
-
-    do 
-    {
-        *dest4 = *dest3 = *dest2 = *dest1 = dc_colormap[0][dc_translation[dc_source[frac >> FRACBITS]]];
-
-        dest1 += screenwidth << hires;
-        dest2 += screenwidth << hires;
-        dest3 += screenwidth << hires;
-        dest4 += screenwidth << hires;
-
-        frac += dc_iscale; 
-    } while (count--); 
-}
+#define COLFUNC   R_DrawTranslatedColumnLow
+#define COLLOW    1
+#define COLTRANS  1
+#include "r_drawcol.h"
 
 void R_DrawTranslatedTLColumn(void)
 {
@@ -45,6 +45,11 @@ static visplane_t  *freetail;                // [JN] killough
 static visplane_t **freehead = &freetail;    // [JN] killough
 visplane_t         *floorplane, *ceilingplane;
 
+// [JN] Visplanes used in current frame, in order of creation,
+// so they can be drawn and freed without walking all hash slots.
+static visplane_t **usedplanes;
+static int          numusedplanes, maxusedplanes;
+
 // [JN] killough -- hash function for visplanes
 // Empirically verified to be fairly uniform:
 
@@ -163,6 +168,7 @@ void R_InitVisplanesRes (void)
 {
     freetail = NULL;
     freehead = &freetail;
+    numusedplanes = 0;
 
     for (int i = 0 ; i < MAXVISPLANES ; i++)
     {
@@ -293,13 +299,16 @@ void R_ClearPlanes (void)
         ceilingclip[i] = -1;
     }
 
-    for (i = 0 ; i < MAXVISPLANES ; i++)  // [JN] new code -- killough
+    // [JN] new code -- killough
+    // Move used visplanes to the free list and empty the hash slots.
+    for (i = 0 ; i < numusedplanes ; i++)
     {
-        for (*freehead = visplanes[i], visplanes[i] = NULL ; *freehead ; )
-        {
-            freehead = &(*freehead)->next;
-        }
+        *freehead = usedplanes[i];
+        freehead = &usedplanes[i]->next;
     }
+    *freehead = NULL;
+    numusedplanes = 0;
+    memset(visplanes, 0, sizeof(visplanes));
 
     lastopening = openings;
 
@@ -332,9 +341,37 @@ static const visplane_t *new_visplane (unsigned const int hash)
     }
     check->next = visplanes[hash];
     visplanes[hash] = check;
+
+    if (numusedplanes == maxusedplanes)
+    {
+        maxusedplanes = maxusedplanes ? maxusedplanes * 2 : 128;
+        usedplanes = I_Realloc(usedplanes, maxusedplanes * sizeof(*usedplanes));
+    }
+    usedplanes[numusedplanes++] = check;
+
     return check;
 }
 
+/*
+================================================================================
+=
+= R_ClearPlaneColumns
+=
+= [JN] Marks columns start...stop of the plane as empty. Top values are
+= only kept valid within [minx, maxx], so instead of clearing the whole
+= array for every new plane, only the columns its range grows by are.
+=
+================================================================================
+*/
+
+static void R_ClearPlaneColumns (visplane_t *pl, const int start, const int stop)
+{
+    if (start <= stop)
+    {
+        memset(pl->top + start, 0xff, (stop - start + 1) * sizeof(*pl->top));
+    }
+}
+
 /*
 ================================================================================
 =
@@ -375,8 +412,6 @@ const visplane_t *R_FindPlane (fixed_t height, const int picnum, const int light
     check->minx = screenwidth;
     check->maxx = -1;
 
-    memset(check->top, UINT_MAX, sizeof(check->top));
-
     return (check);
 }
 
@@ -400,7 +435,7 @@ const visplane_t *R_DupPlane (const visplane_t *pl, const int start, const int s
     new_pl->minx = start;
     new_pl->maxx = stop;
 
-    memset(new_pl->top, UINT_MAX, sizeof(new_pl->top));
+    R_ClearPlaneColumns(new_pl, start, stop);
 
     return new_pl;
 }
@@ -439,6 +474,15 @@ const visplane_t *R_CheckPlane (visplane_t *pl, const int start, const int stop)
     if (x > intrh)
     {
         // Can use existing plane; extend range
+        if (pl->minx > pl->maxx)
+        {
+            R_ClearPlaneColumns(pl, unionl, unionh);
+        }
+        else
+        {
+            R_ClearPlaneColumns(pl, unionl, pl->minx - 1);
+            R_ClearPlaneColumns(pl, pl->maxx + 1, unionh);
+        }
         pl->minx = unionl, pl->maxx = unionh;
         return pl;
     }
@@ -495,10 +539,11 @@ void R_DrawPlanes (void)
     int          i;
     int          x;
 
-    for (i = 0 ; i < MAXVISPLANES ; i++)
-    for (pl = visplanes[i] ; pl ; pl = pl->next, rendered_visplanes++)
-    if (pl->minx <= pl->maxx)
+    for (i = 0 ; i < numusedplanes ; i++, rendered_visplanes++)
+    if (usedplanes[i]->minx <= usedplanes[i]->maxx)
     {
+        pl = usedplanes[i];
+
         // Sky flat
         if (pl->picnum == skyflatnum)
         {
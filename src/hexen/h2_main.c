@@ -1255,6 +1255,9 @@ void H2_GameLoop(void)
 
         // Move positional sounds
         S_UpdateSounds(players[displayplayer].mo);
+
+        // [JN] Report a save written in the background once it is done.
+        SV_CheckSaveWrite();
     }
 }
 
@@ -860,6 +860,8 @@ void SV_LoadGame(int slot);
 void SV_MapTeleport(int map, int position);
 void SV_LoadMap(void);
 void SV_ClearSaveSlot(int slot);
+void SV_FinishSaveWrite(void);
+void SV_CheckSaveWrite(void);
 void SV_InitBaseSlot(void);
 void SV_UpdateRebornSlot(void);
 void SV_ClearRebornSlot(void);
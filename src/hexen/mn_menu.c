@@ -2156,6 +2156,9 @@ void MN_LoadSlotText(void)
     char description[HXS_DESCRIPTION_LENGTH];
     int slot;
 
+    // [JN] Make sure a just saved game is on disk before reading it.
+    SV_FinishSaveWrite();
+
     for (slot = 0; slot < 7; slot++)
     {
         if (ReadDescriptionForSlot(slot, description))
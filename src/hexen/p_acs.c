@@ -20,6 +20,7 @@
 // HEADER FILES ------------------------------------------------------------
 
 #include "h2def.h"
+#include "m_argv.h"
 #include "m_misc.h"
 #include "m_random.h"
 #include "s_sound.h"
@@ -43,10 +44,10 @@
 #define TEXTURE_TOP 0
 #define TEXTURE_MIDDLE 1
 #define TEXTURE_BOTTOM 2
-#define S_DROP ACScript->stackPtr--
-#define S_POP ACScript->stack[--ACScript->stackPtr]
-#define S_PUSH(x) ACScript->stack[ACScript->stackPtr++] = x
-#define CMD_EQ 19 //0 args
+#define S_DROP sp--
+#define S_POP stack[--sp]
+#define S_TOP stack[sp - 1]
+#define S_PUSH(x) stack[sp++] = (x)
 
 // TYPES -------------------------------------------------------------------
 
@@ -57,6 +58,142 @@ typedef PACKED_STRUCT (
     int code;
 }) acsHeader_t;
 
+// P-Code commands. Keep the internal ones in sync with rd_rushexen.c.
+enum
+{
+    CMD_NOP,
+    CMD_TERMINATE,
+    CMD_SUSPEND,
+    CMD_PUSHNUMBER,
+    CMD_LSPEC1,
+    CMD_LSPEC2,
+    CMD_LSPEC3,
+    CMD_LSPEC4,
+    CMD_LSPEC5,
+    CMD_LSPEC1DIRECT,
+    CMD_LSPEC2DIRECT,
+    CMD_LSPEC3DIRECT,
+    CMD_LSPEC4DIRECT,
+    CMD_LSPEC5DIRECT,
+    CMD_ADD,
+    CMD_SUBTRACT,
+    CMD_MULTIPLY,
+    CMD_DIVIDE,
+    CMD_MODULUS,
+    CMD_EQ,
+    CMD_NE,
+    CMD_LT,
+    CMD_GT,
+    CMD_LE,
+    CMD_GE,
+    CMD_ASSIGNSCRIPTVAR,
+    CMD_ASSIGNMAPVAR,
+    CMD_ASSIGNWORLDVAR,
+    CMD_PUSHSCRIPTVAR,
+    CMD_PUSHMAPVAR,
+    CMD_PUSHWORLDVAR,
+    CMD_ADDSCRIPTVAR,
+    CMD_ADDMAPVAR,
+    CMD_ADDWORLDVAR,
+    CMD_SUBSCRIPTVAR,
+    CMD_SUBMAPVAR,
+    CMD_SUBWORLDVAR,
+    CMD_MULSCRIPTVAR,
+    CMD_MULMAPVAR,
+    CMD_MULWORLDVAR,
+    CMD_DIVSCRIPTVAR,
+    CMD_DIVMAPVAR,
+    CMD_DIVWORLDVAR,
+    CMD_MODSCRIPTVAR,
+    CMD_MODMAPVAR,
+    CMD_MODWORLDVAR,
+    CMD_INCSCRIPTVAR,
+    CMD_INCMAPVAR,
+    CMD_INCWORLDVAR,
+    CMD_DECSCRIPTVAR,
+    CMD_DECMAPVAR,
+    CMD_DECWORLDVAR,
+    CMD_GOTO,
+    CMD_IFGOTO,
+    CMD_DROP,
+    CMD_DELAY,
+    CMD_DELAYDIRECT,
+    CMD_RANDOM,
+    CMD_RANDOMDIRECT,
+    CMD_THINGCOUNT,
+    CMD_THINGCOUNTDIRECT,
+    CMD_TAGWAIT,
+    CMD_TAGWAITDIRECT,
+    CMD_POLYWAIT,
+    CMD_POLYWAITDIRECT,
+    CMD_CHANGEFLOOR,
+    CMD_CHANGEFLOORDIRECT,
+    CMD_CHANGECEILING,
+    CMD_CHANGECEILINGDIRECT,
+    CMD_RESTART,
+    CMD_ANDLOGICAL,
+    CMD_ORLOGICAL,
+    CMD_ANDBITWISE,
+    CMD_ORBITWISE,
+    CMD_EORBITWISE,
+    CMD_NEGATELOGICAL,
+    CMD_LSHIFT,
+    CMD_RSHIFT,
+    CMD_UNARYMINUS,
+    CMD_IFNOTGOTO,
+    CMD_LINESIDE,
+    CMD_SCRIPTWAIT,
+    CMD_SCRIPTWAITDIRECT,
+    CMD_CLEARLINESPECIAL,
+    CMD_CASEGOTO,
+    CMD_BEGINPRINT,
+    CMD_ENDPRINT,
+    CMD_PRINTSTRING,
+    CMD_PRINTNUMBER,
+    CMD_PRINTCHARACTER,
+    CMD_PLAYERCOUNT,
+    CMD_GAMETYPE,
+    CMD_GAMESKILL,
+    CMD_TIMER,
+    CMD_SECTORSOUND,
+    CMD_AMBIENTSOUND,
+    CMD_SOUNDSEQUENCE,
+    CMD_SETLINETEXTURE,
+    CMD_SETLINEBLOCKING,
+    CMD_SETLINESPECIAL,
+    CMD_THINGSOUND,
+    CMD_ENDPRINTBOLD,
+    //Insert ACSE(zdoom) PCodes here and don't forget to update LAST_EXTERNAL_CMD in rushexen.h
+    //Internal PCodes
+    CMD_TABLE_DELAY_DIRECT,
+    CMD_PRINT_BOLD_ALWAYS_WITH_TABLE_DELAY_DIRECT,
+    CMD_PRINT_BOLD_RUSSIAN_DIRECT,
+    CMD_PRINT_NUMBER_OR_PRINT_STRING_DIRECT,
+    CMD_PRINT_STRING_DIRECT_OR_PRINT_NUMBER,
+    CMD_PRINT_ALWAYS_WITH_TABLE_DELAY_DIRECT,
+    CMD_PRINT_RUSSIAN_DIRECT,
+    CMD_PRINT_SCRIPTVAR_AND_STRING_ENGLISH_DIRECT,
+    CMD_PRINT_MAPVAR_AND_STRING_ENGLISH_DIRECT,
+    CMD_GT2EQ,
+    NUM_CMDS,
+
+    CMD_INVALID = NUM_CMDS      // Unknown command or truncated code
+};
+
+#define MAX_CMD_ARGS 6
+
+// [JN] P-Code decoded at level load: native endian, with operands read
+// and jump targets resolved to instruction pointers. Instructions are
+// stored in code order, so execution normally falls through to the next
+// element of the array.
+typedef struct acsInstr_s
+{
+    int cmd;
+    int offset;                 // Offset in the BEHAVIOR lump, for savegames
+    int args[MAX_CMD_ARGS];
+    struct acsInstr_s *jump;
+} acsInstr_t;
+
 // EXTERNAL FUNCTION PROTOTYPES --------------------------------------------
 
 // PUBLIC FUNCTION PROTOTYPES ----------------------------------------------
@@ -68,126 +205,19 @@ static void ScriptFinished(int number);
 static boolean TagBusy(int tag);
 static boolean AddToACSStore(int map, int number, byte * args);
 static int GetACSIndex(int number);
-static void Push(int value);
-static int Pop(void);
-static int Top(void);
-static void Drop(void);
-
-static int CmdNOP(void);
-static int CmdTerminate(void);
-static int CmdSuspend(void);
-static int CmdPushNumber(void);
-static int CmdLSpec1(void);
-static int CmdLSpec2(void);
-static int CmdLSpec3(void);
-static int CmdLSpec4(void);
-static int CmdLSpec5(void);
-static int CmdLSpec1Direct(void);
-static int CmdLSpec2Direct(void);
-static int CmdLSpec3Direct(void);
-static int CmdLSpec4Direct(void);
-static int CmdLSpec5Direct(void);
-static int CmdAdd(void);
-static int CmdSubtract(void);
-static int CmdMultiply(void);
-static int CmdDivide(void);
-static int CmdModulus(void);
-static int CmdEQ(void);
-static int CmdNE(void);
-static int CmdLT(void);
-static int CmdGT(void);
-static int CmdLE(void);
-static int CmdGE(void);
-static int CmdAssignScriptVar(void);
-static int CmdAssignMapVar(void);
-static int CmdAssignWorldVar(void);
-static int CmdPushScriptVar(void);
-static int CmdPushMapVar(void);
-static int CmdPushWorldVar(void);
-static int CmdAddScriptVar(void);
-static int CmdAddMapVar(void);
-static int CmdAddWorldVar(void);
-static int CmdSubScriptVar(void);
-static int CmdSubMapVar(void);
-static int CmdSubWorldVar(void);
-static int CmdMulScriptVar(void);
-static int CmdMulMapVar(void);
-static int CmdMulWorldVar(void);
-static int CmdDivScriptVar(void);
-static int CmdDivMapVar(void);
-static int CmdDivWorldVar(void);
-static int CmdModScriptVar(void);
-static int CmdModMapVar(void);
-static int CmdModWorldVar(void);
-static int CmdIncScriptVar(void);
-static int CmdIncMapVar(void);
-static int CmdIncWorldVar(void);
-static int CmdDecScriptVar(void);
-static int CmdDecMapVar(void);
-static int CmdDecWorldVar(void);
-static int CmdGoto(void);
-static int CmdIfGoto(void);
-static int CmdDrop(void);
-static int CmdDelay(void);
-static int CmdDelayDirect(void);
-static int CmdRandom(void);
-static int CmdRandomDirect(void);
-static int CmdThingCount(void);
-static int CmdThingCountDirect(void);
-static int CmdTagWait(void);
-static int CmdTagWaitDirect(void);
-static int CmdPolyWait(void);
-static int CmdPolyWaitDirect(void);
-static int CmdChangeFloor(void);
-static int CmdChangeFloorDirect(void);
-static int CmdChangeCeiling(void);
-static int CmdChangeCeilingDirect(void);
-static int CmdRestart(void);
-static int CmdAndLogical(void);
-static int CmdOrLogical(void);
-static int CmdAndBitwise(void);
-static int CmdOrBitwise(void);
-static int CmdEorBitwise(void);
-static int CmdNegateLogical(void);
-static int CmdLShift(void);
-static int CmdRShift(void);
-static int CmdUnaryMinus(void);
-static int CmdIfNotGoto(void);
-static int CmdLineSide(void);
-static int CmdScriptWait(void);
-static int CmdScriptWaitDirect(void);
-static int CmdClearLineSpecial(void);
-static int CmdCaseGoto(void);
-static int CmdBeginPrint(void);
-static int CmdEndPrint(void);
-static int CmdPrintString(void);
-static int CmdPrintNumber(void);
-static int CmdPrintCharacter(void);
-static int CmdPlayerCount(void);
-static int CmdGameType(void);
-static int CmdGameSkill(void);
-static int CmdTimer(void);
-static int CmdSectorSound(void);
-static int CmdAmbientSound(void);
-static int CmdSoundSequence(void);
-static int CmdSetLineTexture(void);
-static int CmdSetLineBlocking(void);
-static int CmdSetLineSpecial(void);
-static int CmdThingSound(void);
-static int CmdEndPrintBold(void);
-//Internal PCode handlers
-static int InternalCmdTableDelayDirect(void);
-static int InternalCmdPrintBoldAlwaysWithTableDelayDirect(void);
-static int InternalCmdPrintBoldRussianDirect(void);
-static int InternalCmdPrintNumberOrPrintStringDirect(void);
-static int InternalCmdPrintStringDirectOrPrintNumber(void);
-static int InternalCmdPrintAlwaysWithTableDelayDirect(void);
-static int InternalCmdPrintRussianDirect(void);
-static int InternalCmdPrintScriptvarAndStringEnglishDirect(void);
-static int InternalCmdPrintMapvarAndStringEnglishDirect(void);
-static int InternalCmdGT2EQ(void);
-
-static void ThingCount(int type, int tid);
+static const acsInstr_t *InstrFromAddress(const int *address);
+static void EndPrint(acs_t *script);
+static void EndPrintBold(void);
+static void PrintString(int index, boolean russian);
+static void PrintNumber(int value);
+static int ThingCount(int type, int tid);
+static void ChangeFlat(int tag, int flat, boolean ceiling);
+static void SectorSound(acs_t *script, int sound, int volume);
+static void ThingSound(int tid, int sound, int volume);
+static void SoundSequence(acs_t *script, int name);
+static void SetLineTexture(int lineTag, int side, int position, int texture);
+static void SetLineBlocking(int lineTag, boolean blocking);
+static void SetLineSpecial(int lineTag, const int *args);
 
 // EXTERNAL DATA DECLARATIONS ----------------------------------------------
 
@@ -204,129 +234,84 @@ acsstore_t ACSStore[MAX_ACS_STORE + 1]; // +1 for termination marker
 // PRIVATE DATA DEFINITIONS ------------------------------------------------
 
 static acs_t *ACScript;
-static int *PCodePtr;
 static byte SpecArgs[8];
 static int ACStringCount;
 static char **ACStrings;
 static char PrintBuffer[PRINT_BUFFER_SIZE];
 static acs_t *NewScript;
 
-static int (*PCodeCmds[]) (void) =
-{
-        CmdNOP,
-        CmdTerminate,
-        CmdSuspend,
-        CmdPushNumber,
-        CmdLSpec1,
-        CmdLSpec2,
-        CmdLSpec3,
-        CmdLSpec4,
-        CmdLSpec5,
-        CmdLSpec1Direct,
-        CmdLSpec2Direct,
-        CmdLSpec3Direct,
-        CmdLSpec4Direct,
-        CmdLSpec5Direct,
-        CmdAdd,
-        CmdSubtract,
-        CmdMultiply,
-        CmdDivide,
-        CmdModulus,
-        CmdEQ,
-        CmdNE,
-        CmdLT,
-        CmdGT,
-        CmdLE,
-        CmdGE,
-        CmdAssignScriptVar,
-        CmdAssignMapVar,
-        CmdAssignWorldVar,
-        CmdPushScriptVar,
-        CmdPushMapVar,
-        CmdPushWorldVar,
-        CmdAddScriptVar,
-        CmdAddMapVar,
-        CmdAddWorldVar,
-        CmdSubScriptVar,
-        CmdSubMapVar,
-        CmdSubWorldVar,
-        CmdMulScriptVar,
-        CmdMulMapVar,
-        CmdMulWorldVar,
-        CmdDivScriptVar,
-        CmdDivMapVar,
-        CmdDivWorldVar,
-        CmdModScriptVar,
-        CmdModMapVar,
-        CmdModWorldVar,
-        CmdIncScriptVar,
-        CmdIncMapVar,
-        CmdIncWorldVar,
-        CmdDecScriptVar,
-        CmdDecMapVar,
-        CmdDecWorldVar,
-        CmdGoto,
-        CmdIfGoto,
-        CmdDrop,
-        CmdDelay,
-        CmdDelayDirect,
-        CmdRandom,
-        CmdRandomDirect,
-        CmdThingCount,
-        CmdThingCountDirect,
-        CmdTagWait,
-        CmdTagWaitDirect,
-        CmdPolyWait,
-        CmdPolyWaitDirect,
-        CmdChangeFloor,
-        CmdChangeFloorDirect,
-        CmdChangeCeiling,
-        CmdChangeCeilingDirect,
-        CmdRestart,
-        CmdAndLogical,
-        CmdOrLogical,
-        CmdAndBitwise,
-        CmdOrBitwise,
-        CmdEorBitwise,
-        CmdNegateLogical,
-        CmdLShift,
-        CmdRShift,
-        CmdUnaryMinus,
-        CmdIfNotGoto,
-        CmdLineSide,
-        CmdScriptWait,
-        CmdScriptWaitDirect,
-        CmdClearLineSpecial,
-        CmdCaseGoto,
-        CmdBeginPrint,
-        CmdEndPrint,
-        CmdPrintString,
-        CmdPrintNumber,
-        CmdPrintCharacter,
-        CmdPlayerCount,
-        CmdGameType,
-        CmdGameSkill,
-        CmdTimer,
-        CmdSectorSound,
-        CmdAmbientSound,
-        CmdSoundSequence,
-        CmdSetLineTexture,
-        CmdSetLineBlocking,
-        CmdSetLineSpecial,
-        CmdThingSound,
-        CmdEndPrintBold,
-        //Insert ACSE(zdoom) PCodes here and don't forget to update LAST_EXTERNAL_CMD in rushexen.h
-    //Internal PCodes
-        InternalCmdTableDelayDirect,
-        InternalCmdPrintBoldAlwaysWithTableDelayDirect,
-        InternalCmdPrintBoldRussianDirect,
-        InternalCmdPrintNumberOrPrintStringDirect,
-        InternalCmdPrintStringDirectOrPrintNumber,
-        InternalCmdPrintAlwaysWithTableDelayDirect,
-        InternalCmdPrintRussianDirect,
-        InternalCmdPrintScriptvarAndStringEnglishDirect,
-        InternalCmdPrintMapvarAndStringEnglishDirect,
-        InternalCmdGT2EQ,
+static acsInstr_t *ACSCode;     // Decoded P-Code
+static int *ACSCodeIndex;       // Instruction index of every lump word, or -1
+static int ACSCodeWords;        // Length of the BEHAVIOR lump in words
+static boolean ACSProfile;
+static boolean ACSProfilePending;   // Counts of ACSInfo not printed yet
+static int ACSProfileMap;
+
+// Target of jumps outside of the P-Code
+static acsInstr_t ACSBadJump = { CMD_INVALID, -1 };
+
+// Number of operands of each command, the rest have none
+static const byte CmdArgCount[NUM_CMDS] =
+{
+    [CMD_PUSHNUMBER] = 1,
+    [CMD_LSPEC1] = 1,
+    [CMD_LSPEC2] = 1,
+    [CMD_LSPEC3] = 1,
+    [CMD_LSPEC4] = 1,
+    [CMD_LSPEC5] = 1,
+    [CMD_LSPEC1DIRECT] = 2,
+    [CMD_LSPEC2DIRECT] = 3,
+    [CMD_LSPEC3DIRECT] = 4,
+    [CMD_LSPEC4DIRECT] = 5,
+    [CMD_LSPEC5DIRECT] = 6,
+    [CMD_ASSIGNSCRIPTVAR] = 1,
+    [CMD_ASSIGNMAPVAR] = 1,
+    [CMD_ASSIGNWORLDVAR] = 1,
+    [CMD_PUSHSCRIPTVAR] = 1,
+    [CMD_PUSHMAPVAR] = 1,
+    [CMD_PUSHWORLDVAR] = 1,
+    [CMD_ADDSCRIPTVAR] = 1,
+    [CMD_ADDMAPVAR] = 1,
+    [CMD_ADDWORLDVAR] = 1,
+    [CMD_SUBSCRIPTVAR] = 1,
+    [CMD_SUBMAPVAR] = 1,
+    [CMD_SUBWORLDVAR] = 1,
+    [CMD_MULSCRIPTVAR] = 1,
+    [CMD_MULMAPVAR] = 1,
+    [CMD_MULWORLDVAR] = 1,
+    [CMD_DIVSCRIPTVAR] = 1,
+    [CMD_DIVMAPVAR] = 1,
+    [CMD_DIVWORLDVAR] = 1,
+    [CMD_MODSCRIPTVAR] = 1,
+    [CMD_MODMAPVAR] = 1,
+    [CMD_MODWORLDVAR] = 1,
+    [CMD_INCSCRIPTVAR] = 1,
+    [CMD_INCMAPVAR] = 1,
+    [CMD_INCWORLDVAR] = 1,
+    [CMD_DECSCRIPTVAR] = 1,
+    [CMD_DECMAPVAR] = 1,
+    [CMD_DECWORLDVAR] = 1,
+    [CMD_GOTO] = 1,
+    [CMD_IFGOTO] = 1,
+    [CMD_DELAYDIRECT] = 1,
+    [CMD_RANDOMDIRECT] = 2,
+    [CMD_THINGCOUNTDIRECT] = 2,
+    [CMD_TAGWAITDIRECT] = 1,
+    [CMD_POLYWAITDIRECT] = 1,
+    [CMD_CHANGEFLOORDIRECT] = 2,
+    [CMD_CHANGECEILINGDIRECT] = 2,
+    [CMD_IFNOTGOTO] = 1,
+    [CMD_SCRIPTWAITDIRECT] = 1,
+    [CMD_CASEGOTO] = 2,
+    [CMD_TABLE_DELAY_DIRECT] = 1,
+    [CMD_PRINT_BOLD_ALWAYS_WITH_TABLE_DELAY_DIRECT] = 2,
+    [CMD_PRINT_BOLD_RUSSIAN_DIRECT] = 1,
+    [CMD_PRINT_NUMBER_OR_PRINT_STRING_DIRECT] = 1,
+    [CMD_PRINT_STRING_DIRECT_OR_PRINT_NUMBER] = 1,
+    [CMD_PRINT_ALWAYS_WITH_TABLE_DELAY_DIRECT] = 2,
+    [CMD_PRINT_RUSSIAN_DIRECT] = 1,
+    [CMD_PRINT_SCRIPTVAR_AND_STRING_ENGLISH_DIRECT] = 2,
+    [CMD_PRINT_MAPVAR_AND_STRING_ENGLISH_DIRECT] = 2,
 };
 
 // CODE --------------------------------------------------------------------
@@ -346,6 +331,11 @@ void P_LoadACScripts(int lump)
 
     header = W_CacheLumpNum(lump, PU_LEVEL);
     ActionCodeBase = (byte *) header;
+    ACSCode = NULL;
+    ACSCodeIndex = NULL;
+    ACSCodeWords = W_LumpLength(lump) / 4;
+    ACSProfileMap = gamemap;
+
     buffer = (int *) ((byte *) header + LONG(header->infoOffset));
 
     ACScriptCount = LONG(*buffer); 
@@ -358,6 +348,7 @@ void P_LoadACScripts(int lump)
 
     ACSInfo = Z_Malloc(ACScriptCount * sizeof(acsInfo_t), PU_LEVEL, 0);
     memset(ACSInfo, 0, ACScriptCount * sizeof(acsInfo_t));
+    ACSProfilePending = ACSProfile;
     for (i = 0, info = ACSInfo; i < ACScriptCount; i++, info++)
     {
         info->number = LONG(*buffer);
@@ -439,6 +430,252 @@ static void StartOpenACS(int number, int infoIndex, int *address)
     P_AddThinker(&script->thinker);
 }
 
+//==========================================================================
+//
+// P_DecodeACScripts
+//
+// Translates the P-Code reachable from the scripts into the ACSCode array.
+// Must be called after the Russian injection table has been applied,
+// since it rewrites the P-Code.
+//
+//==========================================================================
+
+void P_DecodeACScripts(void)
+{
+    const int *code = (const int *) ActionCodeBase;
+    int *pending;
+    int numPending;
+    int numStarts;
+    int i, pos, next, cmd, target;
+    acsInstr_t *instr, *end;
+
+    if (ACScriptCount == 0)
+    {
+        return;
+    }
+
+    ACSCodeIndex = Z_Malloc(ACSCodeWords * sizeof(*ACSCodeIndex), PU_LEVEL,
+                            NULL);
+    for (i = 0; i < ACSCodeWords; i++)
+    {
+        ACSCodeIndex[i] = -1;
+    }
+
+    // Find the start of every instruction by following the code from
+    // each script entry point and every jump target. Jump targets
+    // can't outnumber the lump words.
+    pending = Z_Malloc((ACScriptCount + ACSCodeWords) * sizeof(*pending),
+                       PU_STATIC, NULL);
+    numPending = 0;
+    numStarts = 0;
+    for (i = 0; i < ACScriptCount; i++)
+    {
+        pending[numPending++] = (byte *) ACSInfo[i].address - ActionCodeBase;
+    }
+    while (numPending > 0)
+    {
+        pos = pending[--numPending];
+        if (pos < 0 || (pos & 3) != 0)
+        {
+            continue;
+        }
+        for (pos /= 4; pos < ACSCodeWords && ACSCodeIndex[pos] == -1; pos = next)
+        {
+            ACSCodeIndex[pos] = 0;
+            numStarts++;
+            cmd = LONG(code[pos]);
+            if (cmd < 0 || cmd >= NUM_CMDS)
+            {
+                break;
+            }
+            next = pos + 1 + CmdArgCount[cmd];
+            if (cmd == CMD_GOTO || cmd == CMD_IFGOTO || cmd == CMD_IFNOTGOTO
+             || cmd == CMD_CASEGOTO)
+            {
+                if (next <= ACSCodeWords)
+                {
+                    pending[numPending++] = LONG(code[next - 1]);
+                }
+            }
+            if (cmd == CMD_TERMINATE || cmd == CMD_GOTO || cmd == CMD_RESTART)
+            {
+                break;
+            }
+        }
+    }
+    Z_Free(pending);
+
+    // Every instruction may need an extra jump to the one it falls
+    // through to, if the next one in the array isn't the same.
+    ACSCode = Z_Malloc(2 * numStarts * sizeof(*ACSCode), PU_LEVEL, NULL);
+    instr = ACSCode;
+    for (pos = 0; pos < ACSCodeWords; pos++)
+    {
+        if (ACSCodeIndex[pos] == -1)
+        {
+            continue;
+        }
+        ACSCodeIndex[pos] = instr - ACSCode;
+        memset(instr, 0, sizeof(*instr));
+        instr->offset = pos * 4;
+        cmd = LONG(code[pos]);
+        next = pos + 1;
+        if (cmd >= 0 && cmd < NUM_CMDS && next + CmdArgCount[cmd] <= ACSCodeWords)
+        {
+            instr->cmd = cmd;
+            for (i = 0; i < CmdArgCount[cmd]; i++)
+            {
+                instr->args[i] = LONG(code[next++]);
+            }
+        }
+        else
+        {
+            instr->cmd = CMD_INVALID;
+            instr->args[0] = cmd;
+        }
+        instr++;
+
+        if (instr[-1].cmd == CMD_TERMINATE || instr[-1].cmd == CMD_GOTO
+         || instr[-1].cmd == CMD_RESTART || instr[-1].cmd == CMD_INVALID)
+        {
+            continue;
+        }
+        for (i = pos + 1; i < next && ACSCodeIndex[i] == -1; i++);
+        if (i == next && next < ACSCodeWords)
+        {                       // Falls through to the next instruction
+            continue;
+        }
+        // The next instruction starts inside the operands of this one,
+        // so jump to where it would continue. Past the end of the lump
+        // there is nothing to continue with.
+        memset(instr, 0, sizeof(*instr));
+        instr->offset = next * 4;
+        instr->cmd = next < ACSCodeWords ? CMD_GOTO : CMD_INVALID;
+        instr->args[0] = next * 4;
+        instr++;
+    }
+
+    // Resolve jump targets
+    for (end = instr, instr = ACSCode; instr < end; instr++)
+    {
+        switch (instr->cmd)
+        {
+            case CMD_GOTO:
+            case CMD_IFGOTO:
+            case CMD_IFNOTGOTO:
+                target = instr->args[0];
+                break;
+            case CMD_CASEGOTO:
+                target = instr->args[1];
+                break;
+            default:
+                continue;
+        }
+        if (target >= 0 && (target & 3) == 0 && target / 4 < ACSCodeWords
+         && ACSCodeIndex[target / 4] != -1)
+        {
+            instr->jump = &ACSCode[ACSCodeIndex[target / 4]];
+        }
+        else
+        {
+            instr->jump = &ACSBadJump;
+        }
+    }
+}
+
+//==========================================================================
+//
+// InstrFromAddress
+//
+// Returns the decoded instruction for a P-Code address.
+//
+//==========================================================================
+
+static const acsInstr_t *InstrFromAddress(const int *address)
+{
+    const int offset = (const byte *) address - ActionCodeBase;
+
+    if (ACSCodeIndex == NULL || offset < 0 || (offset & 3) != 0
+     || offset / 4 >= ACSCodeWords || ACSCodeIndex[offset / 4] == -1)
+    {
+        I_Error(english_language ?
+                "ACS: invalid P-Code address %d" :
+                "ACS: некорректный адрес P-кода %d",
+                offset);
+    }
+    return &ACSCode[ACSCodeIndex[offset / 4]];
+}
+
+//==========================================================================
+//
+// P_InitACSProfile
+//
+//==========================================================================
+
+void P_InitACSProfile(void)
+{
+    //!
+    // Count the P-Code instructions executed by each ACS script and
+    // print them when the level is finished or the game quits.
+    //
+
+    ACSProfile = M_ParmExists("-acsprofile");
+
+    if (ACSProfile)
+    {
+        I_AtExit(P_ACSPrintProfile, true);
+    }
+}
+
+//==========================================================================
+//
+// P_ACSPrintProfile
+//
+// Prints the number of instructions executed by each script of the
+// current level, if -acsprofile is used. Only once for a level, as
+// it is called again at exit.
+//
+//==========================================================================
+
+static int CompareACSInstructions(const void *a, const void *b)
+{
+    const acsInfo_t *info1 = &ACSInfo[*(const int *) a];
+    const acsInfo_t *info2 = &ACSInfo[*(const int *) b];
+
+    if (info1->instructions != info2->instructions)
+    {
+        return info1->instructions < info2->instructions ? 1 : -1;
+    }
+    return info1->number - info2->number;
+}
+
+void P_ACSPrintProfile(void)
+{
+    int *order;
+    int i;
+
+    if (!ACSProfilePending || ACScriptCount == 0)
+    {
+        return;
+    }
+    ACSProfilePending = false;
+
+    order = Z_Malloc(ACScriptCount * sizeof(*order), PU_STATIC, NULL);
+    for (i = 0; i < ACScriptCount; i++)
+    {
+        order[i] = i;
+    }
+    qsort(order, ACScriptCount, sizeof(*order), CompareACSInstructions);
+
+    printf("ACS profile, map %d:\n", ACSProfileMap);
+    for (i = 0; i < ACScriptCount; i++)
+    {
+        printf("  script %4d: %10u instructions\n",
+               ACSInfo[order[i]].number, ACSInfo[order[i]].instructions);
+    }
+    Z_Free(order);
+}
+
 //==========================================================================
 //
 // P_CheckACSStore
@@ -678,8 +915,14 @@ void P_ACSInitNewGame(void)
 void T_InterpretACS(thinker_t *thinker)
 {
     acs_t *script = (acs_t *) thinker;
-    int cmd;
+    acsInstr_t *instr;
+    const int *args;
+    int *stack;
+    int sp;
     int action;
+    int value;
+    int operand2;
+    unsigned int count;
 
     if (ACSInfo[script->infoIndex].state == ASTE_TERMINATING)
     {
@@ -698,23 +941,641 @@ void T_InterpretACS(thinker_t *thinker)
         return;
     }
     ACScript = script;
-    PCodePtr = ACScript->ip;
+    instr = InstrFromAddress(script->ip);
+    stack = script->stack;
+    sp = script->stackPtr;
+    action = SCRIPT_CONTINUE;
+    count = 0;
 
     do
     {
-        cmd = LONG(*PCodePtr);
-        ++PCodePtr;
+        args = instr->args;
+        count++;
 
-        action = PCodeCmds[cmd] ();
+        switch (instr++->cmd)
+        {
+            case CMD_NOP:
+                break;
+
+            case CMD_TERMINATE:
+                action = SCRIPT_TERMINATE;
+                break;
+
+            case CMD_SUSPEND:
+                ACSInfo[script->infoIndex].state = ASTE_SUSPENDED;
+                action = SCRIPT_STOP;
+                break;
+
+            case CMD_PUSHNUMBER:
+                S_PUSH(args[0]);
+                break;
+
+            case CMD_LSPEC5:
+                SpecArgs[4] = S_POP;
+                // fallthrough
+            case CMD_LSPEC4:
+                SpecArgs[3] = S_POP;
+                // fallthrough
+            case CMD_LSPEC3:
+                SpecArgs[2] = S_POP;
+                // fallthrough
+            case CMD_LSPEC2:
+                SpecArgs[1] = S_POP;
+                // fallthrough
+            case CMD_LSPEC1:
+                SpecArgs[0] = S_POP;
+                P_ExecuteLineSpecial(args[0], SpecArgs, script->line,
+                                     script->side, script->activator);
+                break;
+
+            case CMD_LSPEC5DIRECT:
+                SpecArgs[4] = args[5];
+                // fallthrough
+            case CMD_LSPEC4DIRECT:
+                SpecArgs[3] = args[4];
+                // fallthrough
+            case CMD_LSPEC3DIRECT:
+                SpecArgs[2] = args[3];
+                // fallthrough
+            case CMD_LSPEC2DIRECT:
+                SpecArgs[1] = args[2];
+                // fallthrough
+            case CMD_LSPEC1DIRECT:
+                SpecArgs[0] = args[1];
+                P_ExecuteLineSpecial(args[0], SpecArgs, script->line,
+                                     script->side, script->activator);
+                break;
+
+            case CMD_ADD:
+                operand2 = S_POP;
+                S_TOP = S_TOP + operand2;
+                break;
+
+            case CMD_SUBTRACT:
+                operand2 = S_POP;
+                S_TOP = S_TOP - operand2;
+                break;
+
+            case CMD_MULTIPLY:
+                operand2 = S_POP;
+                S_TOP = S_TOP * operand2;
+                break;
+
+            case CMD_DIVIDE:
+                operand2 = S_POP;
+                S_TOP = S_TOP / operand2;
+                break;
+
+            case CMD_MODULUS:
+                operand2 = S_POP;
+                S_TOP = S_TOP % operand2;
+                break;
+
+            case CMD_EQ:
+                operand2 = S_POP;
+                S_TOP = S_TOP == operand2;
+                break;
+
+            case CMD_NE:
+                operand2 = S_POP;
+                S_TOP = S_TOP != operand2;
+                break;
+
+            case CMD_LT:
+                operand2 = S_POP;
+                S_TOP = S_TOP < operand2;
+                break;
+
+            case CMD_GT:
+                operand2 = S_POP;
+                S_TOP = S_TOP > operand2;
+                break;
+
+            case CMD_GT2EQ:
+                operand2 = S_POP;
+                if (S_POP > operand2)
+                {
+                    instr[-1].cmd = CMD_EQ;
+                }
+                S_PUSH(0);
+                break;
+
+            case CMD_LE:
+                operand2 = S_POP;
+                S_TOP = S_TOP <= operand2;
+                break;
+
+            case CMD_GE:
+                operand2 = S_POP;
+                S_TOP = S_TOP >= operand2;
+                break;
+
+            case CMD_ASSIGNSCRIPTVAR:
+                script->vars[args[0]] = S_POP;
+                break;
+
+            case CMD_ASSIGNMAPVAR:
+                MapVars[args[0]] = S_POP;
+                break;
+
+            case CMD_ASSIGNWORLDVAR:
+                WorldVars[args[0]] = S_POP;
+                break;
+
+            case CMD_PUSHSCRIPTVAR:
+                S_PUSH(script->vars[args[0]]);
+                break;
+
+            case CMD_PUSHMAPVAR:
+                S_PUSH(MapVars[args[0]]);
+                break;
+
+            case CMD_PUSHWORLDVAR:
+                S_PUSH(WorldVars[args[0]]);
+                break;
+
+            case CMD_ADDSCRIPTVAR:
+                script->vars[args[0]] += S_POP;
+                break;
+
+            case CMD_ADDMAPVAR:
+                MapVars[args[0]] += S_POP;
+                break;
+
+            case CMD_ADDWORLDVAR:
+                WorldVars[args[0]] += S_POP;
+                break;
+
+            case CMD_SUBSCRIPTVAR:
+                script->vars[args[0]] -= S_POP;
+                break;
+
+            case CMD_SUBMAPVAR:
+                MapVars[args[0]] -= S_POP;
+                break;
+
+            case CMD_SUBWORLDVAR:
+                WorldVars[args[0]] -= S_POP;
+                break;
+
+            case CMD_MULSCRIPTVAR:
+                script->vars[args[0]] *= S_POP;
+                break;
+
+            case CMD_MULMAPVAR:
+                MapVars[args[0]] *= S_POP;
+                break;
+
+            case CMD_MULWORLDVAR:
+                WorldVars[args[0]] *= S_POP;
+                break;
+
+            case CMD_DIVSCRIPTVAR:
+                script->vars[args[0]] /= S_POP;
+                break;
+
+            case CMD_DIVMAPVAR:
+                MapVars[args[0]] /= S_POP;
+                break;
+
+            case CMD_DIVWORLDVAR:
+                WorldVars[args[0]] /= S_POP;
+                break;
+
+            case CMD_MODSCRIPTVAR:
+                script->vars[args[0]] %= S_POP;
+                break;
+
+            case CMD_MODMAPVAR:
+                MapVars[args[0]] %= S_POP;
+                break;
+
+            case CMD_MODWORLDVAR:
+                WorldVars[args[0]] %= S_POP;
+                break;
+
+            case CMD_INCSCRIPTVAR:
+                ++script->vars[args[0]];
+                break;
+
+            case CMD_INCMAPVAR:
+                ++MapVars[args[0]];
+                break;
+
+            case CMD_INCWORLDVAR:
+                ++WorldVars[args[0]];
+                break;
+
+            case CMD_DECSCRIPTVAR:
+                --script->vars[args[0]];
+                break;
+
+            case CMD_DECMAPVAR:
+                --MapVars[args[0]];
+                break;
+
+            case CMD_DECWORLDVAR:
+                --WorldVars[args[0]];
+                break;
+
+            case CMD_GOTO:
+                instr = instr[-1].jump;
+                break;
+
+            case CMD_IFGOTO:
+                if (S_POP != 0)
+                {
+                    instr = instr[-1].jump;
+                }
+                break;
+
+            case CMD_IFNOTGOTO:
+                if (S_POP == 0)
+                {
+                    instr = instr[-1].jump;
+                }
+                break;
+
+            case CMD_CASEGOTO:
+                if (S_TOP == args[0])
+                {
+                    instr = instr[-1].jump;
+                    S_DROP;
+                }
+                break;
+
+            case CMD_DROP:
+                S_DROP;
+                break;
+
+            case CMD_DELAY:
+                script->delayCount = S_POP;
+                action = SCRIPT_STOP;
+                break;
+
+            case CMD_DELAYDIRECT:
+                script->delayCount = args[0];
+                action = SCRIPT_STOP;
+                break;
+
+            case CMD_TABLE_DELAY_DIRECT:
+                script->delayCount = delayTable[args[0]][english_language ? 0 : 1];
+                action = SCRIPT_STOP;
+                break;
+
+            case CMD_RANDOM:
+                operand2 = S_POP;
+                value = S_POP;
+                S_PUSH(value + (P_Random() % (operand2 - value + 1)));
+                break;
+
+            case CMD_RANDOMDIRECT:
+                S_PUSH(args[0] + (P_Random() % (args[1] - args[0] + 1)));
+                break;
+
+            case CMD_THINGCOUNT:
+                operand2 = S_POP;
+                value = S_POP;
+                if (value + operand2)
+                {
+                    S_PUSH(ThingCount(value, operand2));
+                }
+                break;
+
+            case CMD_THINGCOUNTDIRECT:
+                if (args[0] + args[1])
+                {
+                    S_PUSH(ThingCount(args[0], args[1]));
+                }
+                break;
+
+            case CMD_TAGWAIT:
+                ACSInfo[script->infoIndex].waitValue = S_POP;
+                ACSInfo[script->infoIndex].state = ASTE_WAITINGFORTAG;
+                action = SCRIPT_STOP;
+                break;
+
+            case CMD_TAGWAITDIRECT:
+                ACSInfo[script->infoIndex].waitValue = args[0];
+                ACSInfo[script->infoIndex].state = ASTE_WAITINGFORTAG;
+                action = SCRIPT_STOP;
+                break;
+
+            case CMD_POLYWAIT:
+                ACSInfo[script->infoIndex].waitValue = S_POP;
+                ACSInfo[script->infoIndex].state = ASTE_WAITINGFORPOLY;
+                action = SCRIPT_STOP;
+                break;
+
+            case CMD_POLYWAITDIRECT:
+                ACSInfo[script->infoIndex].waitValue = args[0];
+                ACSInfo[script->infoIndex].state = ASTE_WAITINGFORPOLY;
+                action = SCRIPT_STOP;
+                break;
+
+            case CMD_CHANGEFLOOR:
+                value = R_FlatNumForName(ACStrings[S_POP]);
+                ChangeFlat(S_POP, value, false);
+                break;
+
+            case CMD_CHANGEFLOORDIRECT:
+                ChangeFlat(args[0], R_FlatNumForName(ACStrings[args[1]]), false);
+                break;
+
+            case CMD_CHANGECEILING:
+                value = R_FlatNumForName(ACStrings[S_POP]);
+                ChangeFlat(S_POP, value, true);
+                break;
+
+            case CMD_CHANGECEILINGDIRECT:
+                ChangeFlat(args[0], R_FlatNumForName(ACStrings[args[1]]), true);
+                break;
+
+            case CMD_RESTART:
+                instr = InstrFromAddress(ACSInfo[script->infoIndex].address);
+                break;
+
+            case CMD_ANDLOGICAL:
+                value = S_POP;
+                value = value && S_POP;
+                S_PUSH(value);
+                break;
+
+            case CMD_ORLOGICAL:
+                value = S_POP;
+                value = value || S_POP;
+                S_PUSH(value);
+                break;
+
+            case CMD_ANDBITWISE:
+                operand2 = S_POP;
+                S_TOP = S_TOP & operand2;
+                break;
+
+            case CMD_ORBITWISE:
+                operand2 = S_POP;
+                S_TOP = S_TOP | operand2;
+                break;
+
+            case CMD_EORBITWISE:
+                operand2 = S_POP;
+                S_TOP = S_TOP ^ operand2;
+                break;
+
+            case CMD_NEGATELOGICAL:
+                value = S_POP;
+                S_PUSH(!value);
+                break;
+
+            case CMD_LSHIFT:
+                operand2 = S_POP;
+                S_TOP = S_TOP << operand2;
+                break;
+
+            case CMD_RSHIFT:
+                operand2 = S_POP;
+                S_TOP = S_TOP >> operand2;
+                break;
+
+            case CMD_UNARYMINUS:
+                value = S_POP;
+                S_PUSH(-value);
+                break;
+
+            case CMD_LINESIDE:
+                S_PUSH(script->side);
+                break;
+
+            case CMD_SCRIPTWAIT:
+                ACSInfo[script->infoIndex].waitValue = S_POP;
+                ACSInfo[script->infoIndex].state = ASTE_WAITINGFORSCRIPT;
+                action = SCRIPT_STOP;
+                break;
+
+            case CMD_SCRIPTWAITDIRECT:
+                ACSInfo[script->infoIndex].waitValue = args[0];
+                ACSInfo[script->infoIndex].state = ASTE_WAITINGFORSCRIPT;
+                action = SCRIPT_STOP;
+                break;
+
+            case CMD_CLEARLINESPECIAL:
+                if (script->line)
+                {
+                    script->line->special = 0;
+                }
+                break;
+
+            case CMD_BEGINPRINT:
+                *PrintBuffer = 0;
+                break;
+
+            case CMD_ENDPRINT:
+                EndPrint(script);
+                break;
+
+            case CMD_ENDPRINTBOLD:
+                EndPrintBold();
+                break;
+
+            case CMD_PRINTSTRING:
+                PrintString(S_POP, true);
+                break;
+
+            case CMD_PRINT_BOLD_ALWAYS_WITH_TABLE_DELAY_DIRECT:
+                *PrintBuffer = 0;
+                PrintString(args[0], true);
+                EndPrintBold();
+                value = delayTable[args[1]][english_language ? 0 : 1];
+                if (value > 0)
+                {
+                    script->delayCount = value;
+                    action = SCRIPT_STOP;
+                }
+                break;
+
+            case CMD_PRINT_BOLD_RUSSIAN_DIRECT:
+                if (!english_language && rusACStrings)
+                {
+                    *PrintBuffer = 0;
+                    PrintString(args[0], true);
+                    for (value = 0; value < maxplayers; value++)
+                    {
+                        if (playeringame[value])
+                        {
+                            P_SetYellowMessage(&players[value], PrintBuffer, true);
+                        }
+                    }
+                }
+                break;
+
+            case CMD_PRINT_ALWAYS_WITH_TABLE_DELAY_DIRECT:
+                *PrintBuffer = 0;
+                PrintString(args[0], true);
+                EndPrint(script);
+                value = delayTable[args[1]][english_language ? 0 : 1];
+                if (value > 0)
+                {
+                    script->delayCount = value;
+                    action = SCRIPT_STOP;
+                }
+                break;
+
+            case CMD_PRINT_RUSSIAN_DIRECT:
+                if (!english_language && rusACStrings)
+                {
+                    player_t *player;
+
+                    *PrintBuffer = 0;
+                    PrintString(args[0], true);
+                    if (script->activator && script->activator->player)
+                    {
+                        player = script->activator->player;
+                    }
+                    else
+                    {
+                        player = &players[consoleplayer];
+                    }
+                    P_SetMessage(player, PrintBuffer, msg_quest, true);
+                }
+                break;
+
+            case CMD_PRINTNUMBER:
+                PrintNumber(S_POP);
+                break;
+
+            case CMD_PRINT_NUMBER_OR_PRINT_STRING_DIRECT:
+                if (english_language)
+                {
+                    PrintNumber(S_POP);
+                }
+                else if (rusACStrings)
+                {
+                    M_StringConcat(PrintBuffer, rusACStrings[args[0]],
+                                   sizeof(PrintBuffer));
+                }
+                break;
+
+            case CMD_PRINT_STRING_DIRECT_OR_PRINT_NUMBER:
+                if (english_language)
+                {
+                    PrintString(args[0], false);
+                }
+                else
+                {
+                    PrintNumber(S_POP);
+                }
+                break;
+
+            case CMD_PRINT_SCRIPTVAR_AND_STRING_ENGLISH_DIRECT:
+                if (english_language)
+                {
+                    PrintNumber(script->vars[args[0]]);
+                    PrintString(args[1], false);
+                }
+                break;
+
+            case CMD_PRINT_MAPVAR_AND_STRING_ENGLISH_DIRECT:
+                if (english_language)
+                {
+                    PrintNumber(MapVars[args[0]]);
+                    PrintString(args[1], false);
+                }
+                break;
+
+            case CMD_PRINTCHARACTER:
+                value = strlen(PrintBuffer);
+                PrintBuffer[value] = S_POP;
+                PrintBuffer[value + 1] = 0;
+                break;
+
+            case CMD_PLAYERCOUNT:
+                value = 0;
+                for (operand2 = 0; operand2 < maxplayers; operand2++)
+                {
+                    value += playeringame[operand2];
+                }
+                S_PUSH(value);
+                break;
+
+            case CMD_GAMETYPE:
+                if (netgame == false)
+                {
+                    S_PUSH(GAME_SINGLE_PLAYER);
+                }
+                else if (deathmatch)
+                {
+                    S_PUSH(GAME_NET_DEATHMATCH);
+                }
+                else
+                {
+                    S_PUSH(GAME_NET_COOPERATIVE);
+                }
+                break;
+
+            case CMD_GAMESKILL:
+                S_PUSH(gameskill);
+                break;
+
+            case CMD_TIMER:
+                S_PUSH(leveltime);
+                break;
+
+            case CMD_SECTORSOUND:
+                value = S_POP;
+                SectorSound(script, S_POP, value);
+                break;
+
+            case CMD_THINGSOUND:
+                value = S_POP;
+                operand2 = S_POP;
+                ThingSound(S_POP, operand2, value);
+                break;
+
+            case CMD_AMBIENTSOUND:
+                value = S_POP;
+                S_StartSoundAtVolume(NULL, S_GetSoundID(ACStrings[S_POP]), value);
+                break;
+
+            case CMD_SOUNDSEQUENCE:
+                SoundSequence(script, S_POP);
+                break;
+
+            case CMD_SETLINETEXTURE:
+                sp -= 4;
+                SetLineTexture(stack[sp], stack[sp + 1], stack[sp + 2],
+                               R_TextureNumForName(ACStrings[stack[sp + 3]]));
+                break;
+
+            case CMD_SETLINEBLOCKING:
+                sp -= 2;
+                SetLineBlocking(stack[sp], stack[sp + 1] != 0);
+                break;
+
+            case CMD_SETLINESPECIAL:
+                sp -= 7;
+                SetLineSpecial(stack[sp], &stack[sp + 1]);
+                break;
+
+            default:
+                I_Error(english_language ?
+                        "ACS: invalid P-Code in script %d" :
+                        "ACS: некорректный P-код в скрипте %d",
+                        script->number);
+        }
     } while (action == SCRIPT_CONTINUE);
 
-    ACScript->ip = PCodePtr;
+    script->stackPtr = sp;
+    ACSInfo[script->infoIndex].instructions += count;
 
     if (action == SCRIPT_TERMINATE)
     {
         ACSInfo[script->infoIndex].state = ASTE_INACTIVE;
-        ScriptFinished(ACScript->number);
-        P_RemoveThinker(&ACScript->thinker);
+        ScriptFinished(script->number);
+        P_RemoveThinker(&script->thinker);
+    }
+    else
+    {
+        script->ip = (int *) (ActionCodeBase + instr->offset);
     }
 }
 
@@ -852,622 +1713,70 @@ void CheckACSPresent(int number)
 
 //==========================================================================
 //
-// Push
-//
-//==========================================================================
-
-static void Push(int value)
-{
-    ACScript->stack[ACScript->stackPtr++] = value;
-}
-
-//==========================================================================
-//
-// Pop
-//
-//==========================================================================
-
-static int Pop(void)
-{
-    return ACScript->stack[--ACScript->stackPtr];
-}
-
-//==========================================================================
-//
-// Top
-//
-//==========================================================================
-
-static int Top(void)
-{
-    return ACScript->stack[ACScript->stackPtr - 1];
-}
-
-//==========================================================================
-//
-// Drop
-//
-//==========================================================================
-
-static void Drop(void)
-{
-    ACScript->stackPtr--;
-}
-
-//==========================================================================
-//
-// P-Code Commands
+// P-Code Command Helpers
 //
 //==========================================================================
 
-static int CmdNOP(void)
-{
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdTerminate(void)
-{
-    return SCRIPT_TERMINATE;
-}
-
-static int CmdSuspend(void)
+static void EndPrint(acs_t *script)
 {
-    ACSInfo[ACScript->infoIndex].state = ASTE_SUSPENDED;
-    return SCRIPT_STOP;
-}
-
-static int CmdPushNumber(void)
-{
-    Push(LONG(*PCodePtr));
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
+    player_t *player;
 
-static int CmdLSpec1(void)
-{
-    int special;
-
-    special = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[0] = Pop();
-    P_ExecuteLineSpecial(special, SpecArgs, ACScript->line,
-                         ACScript->side, ACScript->activator);
-    return SCRIPT_CONTINUE;
+    if (script->activator && script->activator->player)
+    {
+        player = script->activator->player;
+    }
+    else
+    {
+        player = &players[consoleplayer];
+    }
+    P_SetMessage(player, PrintBuffer, msg_quest, true);
+    if(!rusACStrings)
+        player->engOnlyMessage = true;
 }
 
-static int CmdLSpec2(void)
+static void EndPrintBold(void)
 {
-    int special;
-
-    special = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[1] = Pop();
-    SpecArgs[0] = Pop();
-    P_ExecuteLineSpecial(special, SpecArgs, ACScript->line,
-                         ACScript->side, ACScript->activator);
-    return SCRIPT_CONTINUE;
-}
+    int i;
 
-static int CmdLSpec3(void)
-{
-    int special;
-
-    special = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[2] = Pop();
-    SpecArgs[1] = Pop();
-    SpecArgs[0] = Pop();
-    P_ExecuteLineSpecial(special, SpecArgs, ACScript->line,
-                         ACScript->side, ACScript->activator);
-    return SCRIPT_CONTINUE;
+    for (i = 0; i < maxplayers; i++)
+    {
+        if (playeringame[i])
+        {
+            P_SetYellowMessage(&players[i], PrintBuffer, true);
+            if(!rusACStrings)
+                players[i].engOnlyMessage = true;
+        }
+    }
 }
 
-static int CmdLSpec4(void)
+static void PrintString(int index, boolean russian)
 {
-    int special;
-
-    special = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[3] = Pop();
-    SpecArgs[2] = Pop();
-    SpecArgs[1] = Pop();
-    SpecArgs[0] = Pop();
-    P_ExecuteLineSpecial(special, SpecArgs, ACScript->line,
-                         ACScript->side, ACScript->activator);
-    return SCRIPT_CONTINUE;
+    if (russian && !english_language && rusACStrings)
+    {
+        M_StringConcat(PrintBuffer, rusACStrings[index], sizeof(PrintBuffer));
+    }
+    else
+    {
+        M_StringConcat(PrintBuffer, ACStrings[index], sizeof(PrintBuffer));
+    }
 }
 
-static int CmdLSpec5(void)
+static void PrintNumber(int value)
 {
-    int special;
-
-    special = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[4] = Pop();
-    SpecArgs[3] = Pop();
-    SpecArgs[2] = Pop();
-    SpecArgs[1] = Pop();
-    SpecArgs[0] = Pop();
-    P_ExecuteLineSpecial(special, SpecArgs, ACScript->line,
-                         ACScript->side, ACScript->activator);
-    return SCRIPT_CONTINUE;
-}
+    char tempStr[16];
 
-static int CmdLSpec1Direct(void)
-{
-    int special;
-
-    special = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[0] = LONG(*PCodePtr);
-    ++PCodePtr;
-    P_ExecuteLineSpecial(special, SpecArgs, ACScript->line,
-                         ACScript->side, ACScript->activator);
-    return SCRIPT_CONTINUE;
+    M_snprintf(tempStr, sizeof(tempStr), "%d", value);
+    M_StringConcat(PrintBuffer, tempStr, sizeof(PrintBuffer));
 }
 
-static int CmdLSpec2Direct(void)
+static int ThingCount(int type, int tid)
 {
-    int special;
-
-    special = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[0] = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[1] = LONG(*PCodePtr);
-    ++PCodePtr;
-    P_ExecuteLineSpecial(special, SpecArgs, ACScript->line,
-                         ACScript->side, ACScript->activator);
-    return SCRIPT_CONTINUE;
-}
+    int count;
+    int searcher;
+    mobj_t *mobj;
+    mobjtype_t moType;
+    thinker_t *think;
 
-static int CmdLSpec3Direct(void)
-{
-    int special;
-
-    special = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[0] = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[1] = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[2] = LONG(*PCodePtr);
-    ++PCodePtr;
-    P_ExecuteLineSpecial(special, SpecArgs, ACScript->line,
-                         ACScript->side, ACScript->activator);
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdLSpec4Direct(void)
-{
-    int special;
-
-    special = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[0] = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[1] = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[2] = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[3] = LONG(*PCodePtr);
-    ++PCodePtr;
-    P_ExecuteLineSpecial(special, SpecArgs, ACScript->line,
-                         ACScript->side, ACScript->activator);
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdLSpec5Direct(void)
-{
-    int special;
-
-    special = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[0] = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[1] = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[2] = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[3] = LONG(*PCodePtr);
-    ++PCodePtr;
-    SpecArgs[4] = LONG(*PCodePtr);
-    ++PCodePtr;
-    P_ExecuteLineSpecial(special, SpecArgs, ACScript->line,
-                         ACScript->side, ACScript->activator);
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdAdd(void)
-{
-    Push(Pop() + Pop());
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdSubtract(void)
-{
-    int operand2;
-
-    operand2 = Pop();
-    Push(Pop() - operand2);
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdMultiply(void)
-{
-    Push(Pop() * Pop());
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdDivide(void)
-{
-    int operand2;
-
-    operand2 = Pop();
-    Push(Pop() / operand2);
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdModulus(void)
-{
-    int operand2;
-
-    operand2 = Pop();
-    Push(Pop() % operand2);
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdEQ(void)
-{
-    Push(Pop() == Pop());
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdNE(void)
-{
-    Push(Pop() != Pop());
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdLT(void)
-{
-    int operand2;
-
-    operand2 = Pop();
-    Push(Pop() < operand2);
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdGT(void)
-{
-    int operand2;
-
-    operand2 = Pop();
-    Push(Pop() > operand2);
-    return SCRIPT_CONTINUE;
-}
-
-static int InternalCmdGT2EQ(void)
-{
-    int operand2;
-
-    operand2 = Pop();
-    if (Pop() > operand2)
-    {
-        PCodePtr[-1] = LONG(CMD_EQ);
-    }
-    Push(0);
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdLE(void)
-{
-    int operand2;
-
-    operand2 = Pop();
-    Push(Pop() <= operand2);
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdGE(void)
-{
-    int operand2;
-
-    operand2 = Pop();
-    Push(Pop() >= operand2);
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdAssignScriptVar(void)
-{
-    ACScript->vars[LONG(*PCodePtr)] = Pop();
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdAssignMapVar(void)
-{
-    MapVars[LONG(*PCodePtr)] = Pop();
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdAssignWorldVar(void)
-{
-    WorldVars[LONG(*PCodePtr)] = Pop();
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdPushScriptVar(void)
-{
-    Push(ACScript->vars[LONG(*PCodePtr)]);
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdPushMapVar(void)
-{
-    Push(MapVars[LONG(*PCodePtr)]);
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdPushWorldVar(void)
-{
-    Push(WorldVars[LONG(*PCodePtr)]);
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdAddScriptVar(void)
-{
-    ACScript->vars[LONG(*PCodePtr)] += Pop();
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdAddMapVar(void)
-{
-    MapVars[LONG(*PCodePtr)] += Pop();
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdAddWorldVar(void)
-{
-    WorldVars[LONG(*PCodePtr)] += Pop();
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdSubScriptVar(void)
-{
-    ACScript->vars[LONG(*PCodePtr)] -= Pop();
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdSubMapVar(void)
-{
-    MapVars[LONG(*PCodePtr)] -= Pop();
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdSubWorldVar(void)
-{
-    WorldVars[LONG(*PCodePtr)] -= Pop();
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdMulScriptVar(void)
-{
-    ACScript->vars[LONG(*PCodePtr)] *= Pop();
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdMulMapVar(void)
-{
-    MapVars[LONG(*PCodePtr)] *= Pop();
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdMulWorldVar(void)
-{
-    WorldVars[LONG(*PCodePtr)] *= Pop();
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdDivScriptVar(void)
-{
-    ACScript->vars[LONG(*PCodePtr)] /= Pop();
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdDivMapVar(void)
-{
-    MapVars[LONG(*PCodePtr)] /= Pop();
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdDivWorldVar(void)
-{
-    WorldVars[LONG(*PCodePtr)] /= Pop();
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdModScriptVar(void)
-{
-    ACScript->vars[LONG(*PCodePtr)] %= Pop();
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdModMapVar(void)
-{
-    MapVars[LONG(*PCodePtr)] %= Pop();
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdModWorldVar(void)
-{
-    WorldVars[LONG(*PCodePtr)] %= Pop();
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdIncScriptVar(void)
-{
-    ++ACScript->vars[LONG(*PCodePtr)];
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdIncMapVar(void)
-{
-    ++MapVars[LONG(*PCodePtr)];
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdIncWorldVar(void)
-{
-    ++WorldVars[LONG(*PCodePtr)];
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdDecScriptVar(void)
-{
-    --ACScript->vars[LONG(*PCodePtr)];
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdDecMapVar(void)
-{
-    --MapVars[LONG(*PCodePtr)];
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdDecWorldVar(void)
-{
-    --WorldVars[LONG(*PCodePtr)];
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdGoto(void)
-{
-    PCodePtr = (int *) (ActionCodeBase + LONG(*PCodePtr));
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdIfGoto(void)
-{
-    if (Pop() != 0)
-    {
-        PCodePtr = (int *) (ActionCodeBase + LONG(*PCodePtr));
-    }
-    else
-    {
-        ++PCodePtr;
-    }
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdDrop(void)
-{
-    Drop();
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdDelay(void)
-{
-    ACScript->delayCount = Pop();
-    return SCRIPT_STOP;
-}
-
-static int CmdDelayDirect(void)
-{
-    ACScript->delayCount = LONG(*PCodePtr);
-    ++PCodePtr;
-    return SCRIPT_STOP;
-}
-
-static int InternalCmdTableDelayDirect(void)
-{
-    ACScript->delayCount = delayTable[LONG(*PCodePtr)][english_language ? 0 : 1];
-    ++PCodePtr;
-    return SCRIPT_STOP;
-}
-
-static int CmdRandom(void)
-{
-    int low;
-    int high;
-
-    high = Pop();
-    low = Pop();
-    Push(low + (P_Random() % (high - low + 1)));
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdRandomDirect(void)
-{
-    int low;
-    int high;
-
-    low = LONG(*PCodePtr);
-    ++PCodePtr;
-    high = LONG(*PCodePtr);
-    ++PCodePtr;
-    Push(low + (P_Random() % (high - low + 1)));
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdThingCount(void)
-{
-    int tid;
-
-    tid = Pop();
-    ThingCount(Pop(), tid);
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdThingCountDirect(void)
-{
-    int type;
-
-    type = LONG(*PCodePtr);
-    ++PCodePtr;
-    ThingCount(type, LONG(*PCodePtr));
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static void ThingCount(int type, int tid)
-{
-    int count;
-    int searcher;
-    mobj_t *mobj;
-    mobjtype_t moType;
-    thinker_t *think;
-
-    if (!(type + tid))
-    {                           // Nothing to count
-        return;
-    }
     moType = TranslateThingType[type];
     count = 0;
     searcher = -1;
@@ -1510,611 +1819,70 @@ static void ThingCount(int type, int tid)
             count++;
         }
     }
-    Push(count);
-}
-
-static int CmdTagWait(void)
-{
-    ACSInfo[ACScript->infoIndex].waitValue = Pop();
-    ACSInfo[ACScript->infoIndex].state = ASTE_WAITINGFORTAG;
-    return SCRIPT_STOP;
-}
-
-static int CmdTagWaitDirect(void)
-{
-    ACSInfo[ACScript->infoIndex].waitValue = LONG(*PCodePtr);
-    ++PCodePtr;
-    ACSInfo[ACScript->infoIndex].state = ASTE_WAITINGFORTAG;
-    return SCRIPT_STOP;
-}
-
-static int CmdPolyWait(void)
-{
-    ACSInfo[ACScript->infoIndex].waitValue = Pop();
-    ACSInfo[ACScript->infoIndex].state = ASTE_WAITINGFORPOLY;
-    return SCRIPT_STOP;
-}
-
-static int CmdPolyWaitDirect(void)
-{
-    ACSInfo[ACScript->infoIndex].waitValue = LONG(*PCodePtr);
-    ++PCodePtr;
-    ACSInfo[ACScript->infoIndex].state = ASTE_WAITINGFORPOLY;
-    return SCRIPT_STOP;
-}
-
-static int CmdChangeFloor(void)
-{
-    int tag;
-    int flat;
-    int sectorIndex;
-
-    flat = R_FlatNumForName(ACStrings[Pop()]);
-    tag = Pop();
-    sectorIndex = -1;
-    while ((sectorIndex = P_FindSectorFromTag(tag, sectorIndex)) >= 0)
-    {
-        sectors[sectorIndex].floorpic = flat;
-    }
-    return SCRIPT_CONTINUE;
+    return count;
 }
 
-static int CmdChangeFloorDirect(void)
+static void ChangeFlat(int tag, int flat, boolean ceiling)
 {
-    int tag;
-    int flat;
     int sectorIndex;
 
-    tag = LONG(*PCodePtr);
-    ++PCodePtr;
-    flat = R_FlatNumForName(ACStrings[LONG(*PCodePtr)]);
-    ++PCodePtr;
     sectorIndex = -1;
     while ((sectorIndex = P_FindSectorFromTag(tag, sectorIndex)) >= 0)
     {
-        sectors[sectorIndex].floorpic = flat;
-    }
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdChangeCeiling(void)
-{
-    int tag;
-    int flat;
-    int sectorIndex;
-
-    flat = R_FlatNumForName(ACStrings[Pop()]);
-    tag = Pop();
-    sectorIndex = -1;
-    while ((sectorIndex = P_FindSectorFromTag(tag, sectorIndex)) >= 0)
-    {
-        sectors[sectorIndex].ceilingpic = flat;
-    }
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdChangeCeilingDirect(void)
-{
-    int tag;
-    int flat;
-    int sectorIndex;
-
-    tag = LONG(*PCodePtr);
-    ++PCodePtr;
-    flat = R_FlatNumForName(ACStrings[LONG(*PCodePtr)]);
-    ++PCodePtr;
-    sectorIndex = -1;
-    while ((sectorIndex = P_FindSectorFromTag(tag, sectorIndex)) >= 0)
-    {
-        sectors[sectorIndex].ceilingpic = flat;
-    }
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdRestart(void)
-{
-    PCodePtr = ACSInfo[ACScript->infoIndex].address;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdAndLogical(void)
-{
-    Push(Pop() && Pop());
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdOrLogical(void)
-{
-    Push(Pop() || Pop());
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdAndBitwise(void)
-{
-    Push(Pop() & Pop());
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdOrBitwise(void)
-{
-    Push(Pop() | Pop());
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdEorBitwise(void)
-{
-    Push(Pop() ^ Pop());
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdNegateLogical(void)
-{
-    Push(!Pop());
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdLShift(void)
-{
-    int operand2;
-
-    operand2 = Pop();
-    Push(Pop() << operand2);
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdRShift(void)
-{
-    int operand2;
-
-    operand2 = Pop();
-    Push(Pop() >> operand2);
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdUnaryMinus(void)
-{
-    Push(-Pop());
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdIfNotGoto(void)
-{
-    if (Pop() != 0)
-    {
-        ++PCodePtr;
-    }
-    else
-    {
-        PCodePtr = (int *) (ActionCodeBase + LONG(*PCodePtr));
-    }
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdLineSide(void)
-{
-    Push(ACScript->side);
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdScriptWait(void)
-{
-    ACSInfo[ACScript->infoIndex].waitValue = Pop();
-    ACSInfo[ACScript->infoIndex].state = ASTE_WAITINGFORSCRIPT;
-    return SCRIPT_STOP;
-}
-
-static int CmdScriptWaitDirect(void)
-{
-    ACSInfo[ACScript->infoIndex].waitValue = LONG(*PCodePtr);
-    ++PCodePtr;
-    ACSInfo[ACScript->infoIndex].state = ASTE_WAITINGFORSCRIPT;
-    return SCRIPT_STOP;
-}
-
-static int CmdClearLineSpecial(void)
-{
-    if (ACScript->line)
-    {
-        ACScript->line->special = 0;
-    }
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdCaseGoto(void)
-{
-    int value;
-
-    value = LONG(*PCodePtr);
-    ++PCodePtr;
-
-    if (Top() == value)
-    {
-        PCodePtr = (int *) (ActionCodeBase + LONG(*PCodePtr));
-        Drop();
-    }
-    else
-    {
-        ++PCodePtr;
-    }
-
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdBeginPrint(void)
-{
-    *PrintBuffer = 0;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdEndPrint(void)
-{
-    player_t *player;
-
-    if (ACScript->activator && ACScript->activator->player)
-    {
-        player = ACScript->activator->player;
-    }
-    else
-    {
-        player = &players[consoleplayer];
-    }
-    P_SetMessage(player, PrintBuffer, msg_quest, true);
-    if(!rusACStrings)
-        player->engOnlyMessage = true;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdEndPrintBold(void)
-{
-    int i;
-
-    for (i = 0; i < maxplayers; i++)
-    {
-        if (playeringame[i])
-        {
-            P_SetYellowMessage(&players[i], PrintBuffer, true);
-            if(!rusACStrings)
-                players[i].engOnlyMessage = true;
-        }
-    }
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdPrintString(void)
-{
-    if (!english_language && rusACStrings)
-    {
-        M_StringConcat(PrintBuffer, rusACStrings[Pop()], sizeof(PrintBuffer));
-    }
-    else
-    {
-        M_StringConcat(PrintBuffer, ACStrings[Pop()], sizeof(PrintBuffer));
-    }
-    return SCRIPT_CONTINUE;
-}
-
-static int InternalCmdPrintBoldAlwaysWithTableDelayDirect(void)
-{
-    int i;
-
-    *PrintBuffer = 0;
-    if (!english_language && rusACStrings)
-    {
-        M_StringConcat(PrintBuffer, rusACStrings[LONG(*PCodePtr)], sizeof(PrintBuffer));
-    }
-    else
-    {
-        M_StringConcat(PrintBuffer, ACStrings[LONG(*PCodePtr)], sizeof(PrintBuffer));
-    }
-    ++PCodePtr;
-    for (i = 0; i < maxplayers; i++)
-    {
-        if (playeringame[i])
-        {
-            P_SetYellowMessage(&players[i], PrintBuffer, true);
-            if(!rusACStrings)
-                players[i].engOnlyMessage = true;
-        }
-    }
-    i = delayTable[LONG(*PCodePtr)][english_language ? 0 : 1];
-    ++PCodePtr;
-    if (i > 0)
-    {
-        ACScript->delayCount = i;
-        return SCRIPT_STOP;
-    }
-    else
-    {
-        return SCRIPT_CONTINUE;
-    }
-}
-
-static int InternalCmdPrintBoldRussianDirect(void)
-{
-    int i;
-
-    if (!english_language && rusACStrings)
-    {
-        *PrintBuffer = 0;
-        M_StringConcat(PrintBuffer, rusACStrings[LONG(*PCodePtr)], sizeof(PrintBuffer));
-        for (i = 0; i < maxplayers; i++)
-        {
-            if (playeringame[i])
-            {
-                P_SetYellowMessage(&players[i], PrintBuffer, true);
-            }
-        }
-    }
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int InternalCmdPrintAlwaysWithTableDelayDirect(void)
-{
-    player_t* player;
-    int i;
-
-    *PrintBuffer = 0;
-    if (!english_language && rusACStrings)
-    {
-        M_StringConcat(PrintBuffer, rusACStrings[LONG(*PCodePtr)], sizeof(PrintBuffer));
-    }
-    else
-    {
-        M_StringConcat(PrintBuffer, ACStrings[LONG(*PCodePtr)], sizeof(PrintBuffer));
-    }
-    ++PCodePtr;
-    if (ACScript->activator && ACScript->activator->player)
-    {
-        player = ACScript->activator->player;
-    }
-    else
-    {
-        player = &players[consoleplayer];
-    }
-    P_SetMessage(player, PrintBuffer, msg_quest, true);
-    if(!rusACStrings)
-        player->engOnlyMessage = true;
-    i = delayTable[LONG(*PCodePtr)][english_language ? 0 : 1];
-    ++PCodePtr;
-    if (i > 0)
-    {
-        ACScript->delayCount = i;
-        return SCRIPT_STOP;
-    }
-    else
-    {
-        return SCRIPT_CONTINUE;
-    }
-}
-
-static int InternalCmdPrintRussianDirect(void)
-{
-    player_t* player;
-
-    if (!english_language && rusACStrings)
-    {
-        *PrintBuffer = 0;
-        M_StringConcat(PrintBuffer, rusACStrings[LONG(*PCodePtr)], sizeof(PrintBuffer));
-        if (ACScript->activator && ACScript->activator->player)
+        if (ceiling)
         {
-            player = ACScript->activator->player;
+            sectors[sectorIndex].ceilingpic = flat;
         }
         else
         {
-            player = &players[consoleplayer];
-        }
-        P_SetMessage(player, PrintBuffer, msg_quest, true);
-    }
-    ++PCodePtr;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdPrintNumber(void)
-{
-    char tempStr[16];
-
-    M_snprintf(tempStr, sizeof(tempStr), "%d", Pop());
-    M_StringConcat(PrintBuffer, tempStr, sizeof(PrintBuffer));
-    return SCRIPT_CONTINUE;
-}
-
-static int InternalCmdPrintNumberOrPrintStringDirect(void)
-{
-    if (english_language)
-    {
-        ++PCodePtr;
-        return CmdPrintNumber();
-    }
-    else
-    {
-        if (rusACStrings)
-        {
-            M_StringConcat(PrintBuffer, rusACStrings[LONG(*PCodePtr)], sizeof(PrintBuffer));
+            sectors[sectorIndex].floorpic = flat;
         }
-        ++PCodePtr;
-        return SCRIPT_CONTINUE;
     }
 }
 
-static int InternalCmdPrintStringDirectOrPrintNumber(void)
+static void SectorSound(acs_t *script, int name, int volume)
 {
-    if (english_language)
-    {
-        M_StringConcat(PrintBuffer, ACStrings[LONG(*PCodePtr)], sizeof(PrintBuffer));
-        ++PCodePtr;
-        return SCRIPT_CONTINUE;
-    }
-    else
-    {
-        ++PCodePtr;
-        return CmdPrintNumber();
-    }
-}
-
-static int InternalCmdPrintScriptvarAndStringEnglishDirect(void)
-{
-    if (english_language)
-    {
-        char tempStr[16];
-
-        M_snprintf(tempStr, sizeof(tempStr), "%d", ACScript->vars[LONG(*PCodePtr)]);
-        ++PCodePtr;
-        M_StringConcat(PrintBuffer, tempStr, sizeof(PrintBuffer));
-        M_StringConcat(PrintBuffer, ACStrings[LONG(*PCodePtr)], sizeof(PrintBuffer));
-        ++PCodePtr;
-    }
-    else
-    {
-        PCodePtr += 2;
-    }
-    return SCRIPT_CONTINUE;
-}
-
-static int InternalCmdPrintMapvarAndStringEnglishDirect(void)
-{
-    if (english_language)
-    {
-        char tempStr[16];
-
-        M_snprintf(tempStr, sizeof(tempStr), "%d", MapVars[LONG(*PCodePtr)]);
-        ++PCodePtr;
-        M_StringConcat(PrintBuffer, tempStr, sizeof(PrintBuffer));
-        M_StringConcat(PrintBuffer, ACStrings[LONG(*PCodePtr)], sizeof(PrintBuffer));
-        ++PCodePtr;
-    }
-    else
-    {
-        PCodePtr += 2;
-    }
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdPrintCharacter(void)
-{
-    char *bufferEnd;
-
-    bufferEnd = PrintBuffer + strlen(PrintBuffer);
-    *bufferEnd++ = Pop();
-    *bufferEnd = 0;
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdPlayerCount(void)
-{
-    int i;
-    int count;
-
-    count = 0;
-    for (i = 0; i < maxplayers; i++)
-    {
-        count += playeringame[i];
-    }
-    Push(count);
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdGameType(void)
-{
-    int gametype;
-
-    if (netgame == false)
-    {
-        gametype = GAME_SINGLE_PLAYER;
-    }
-    else if (deathmatch)
-    {
-        gametype = GAME_NET_DEATHMATCH;
-    }
-    else
-    {
-        gametype = GAME_NET_COOPERATIVE;
-    }
-    Push(gametype);
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdGameSkill(void)
-{
-    Push(gameskill);
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdTimer(void)
-{
-    Push(leveltime);
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdSectorSound(void)
-{
-    int volume;
     mobj_t *mobj;
 
     mobj = NULL;
-    if (ACScript->line)
+    if (script->line)
     {
-        mobj = (mobj_t *) & ACScript->line->frontsector->soundorg;
+        mobj = (mobj_t *) & script->line->frontsector->soundorg;
     }
-    volume = Pop();
-    S_StartSoundAtVolume(mobj, S_GetSoundID(ACStrings[Pop()]), volume);
-    return SCRIPT_CONTINUE;
+    S_StartSoundAtVolume(mobj, S_GetSoundID(ACStrings[name]), volume);
 }
 
-static int CmdThingSound(void)
+static void ThingSound(int tid, int name, int volume)
 {
-    int tid;
     int sound;
-    int volume;
     mobj_t *mobj;
     int searcher;
 
-    volume = Pop();
-    sound = S_GetSoundID(ACStrings[Pop()]);
-    tid = Pop();
+    sound = S_GetSoundID(ACStrings[name]);
     searcher = -1;
     while ((mobj = P_FindMobjFromTID(tid, &searcher)) != NULL)
     {
         S_StartSoundAtVolume(mobj, sound, volume);
     }
-    return SCRIPT_CONTINUE;
-}
-
-static int CmdAmbientSound(void)
-{
-    int volume;
-
-    volume = Pop();
-    S_StartSoundAtVolume(NULL, S_GetSoundID(ACStrings[Pop()]), volume);
-    return SCRIPT_CONTINUE;
 }
 
-static int CmdSoundSequence(void)
+static void SoundSequence(acs_t *script, int name)
 {
     mobj_t *mobj;
 
     mobj = NULL;
-    if (ACScript->line)
+    if (script->line)
     {
-        mobj = (mobj_t *) & ACScript->line->frontsector->soundorg;
+        mobj = (mobj_t *) & script->line->frontsector->soundorg;
     }
-    SN_StartSequenceName(mobj, ACStrings[Pop()]);
-    return SCRIPT_CONTINUE;
+    SN_StartSequenceName(mobj, ACStrings[name]);
 }
 
-static int CmdSetLineTexture(void)
+static void SetLineTexture(int lineTag, int side, int position, int texture)
 {
     line_t *line;
-    int lineTag;
-    int side;
-    int position;
-    int texture;
     int searcher;
 
-    texture = R_TextureNumForName(ACStrings[Pop()]);
-    position = Pop();
-    side = Pop();
-    lineTag = Pop();
     searcher = -1;
     while ((line = P_FindLine(lineTag, &searcher)) != NULL)
     {
@@ -2131,49 +1899,35 @@ static int CmdSetLineTexture(void)
             sides[line->sidenum[side]].toptexture = texture;
         }
     }
-    return SCRIPT_CONTINUE;
 }
 
-static int CmdSetLineBlocking(void)
+static void SetLineBlocking(int lineTag, boolean blocking)
 {
     line_t *line;
-    int lineTag;
-    boolean blocking;
     int searcher;
 
-    blocking = Pop()? ML_BLOCKING : 0;
-    lineTag = Pop();
     searcher = -1;
     while ((line = P_FindLine(lineTag, &searcher)) != NULL)
     {
-        line->flags = (line->flags & ~ML_BLOCKING) | blocking;
+        line->flags = (line->flags & ~ML_BLOCKING)
+                    | (blocking ? ML_BLOCKING : 0);
     }
-    return SCRIPT_CONTINUE;
 }
 
-static int CmdSetLineSpecial(void)
+// args[] are the special and its five arguments
+static void SetLineSpecial(int lineTag, const int *args)
 {
     line_t *line;
-    int lineTag;
-    int special, arg1, arg2, arg3, arg4, arg5;
     int searcher;
 
-    arg5 = Pop();
-    arg4 = Pop();
-    arg3 = Pop();
-    arg2 = Pop();
-    arg1 = Pop();
-    special = Pop();
-    lineTag = Pop();
     searcher = -1;
     while ((line = P_FindLine(lineTag, &searcher)) != NULL)
     {
-        line->special = special;
-        line->arg1 = arg1;
-        line->arg2 = arg2;
-        line->arg3 = arg3;
-        line->arg4 = arg4;
-        line->arg5 = arg5;
+        line->special = args[0];
+        line->arg1 = args[1];
+        line->arg2 = args[2];
+        line->arg3 = args[3];
+        line->arg4 = args[4];
+        line->arg5 = args[5];
     }
-    return SCRIPT_CONTINUE;
 }
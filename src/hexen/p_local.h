@@ -86,6 +86,10 @@ void P_InitThinkers(void);
 void P_AddThinker(thinker_t * thinker);
 void P_RemoveThinker(thinker_t * thinker);
 
+// ***** P_PROF *****
+
+void P_InitProfile(void);
+
 // ***** P_PSPR *****
 
 #define USE_MANA1	1
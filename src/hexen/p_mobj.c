@@ -23,13 +23,26 @@
 #include "m_random.h"
 #include "i_system.h"
 #include "i_timer.h"
+#include "m_prof.h"
 #include "p_local.h"
 #include "s_sound.h"
 #include "sounds.h"
 
 // MACROS ------------------------------------------------------------------
 
-#define MAX_TID_COUNT 200
+// [JN] TID slots are hashed into buckets by TID. Each bucket is a chain of
+// slots linked in ascending slot order, so searches only visit slots that
+// can match, while search positions (slot indexes) and iteration order stay
+// exactly as in vanilla. MAX_TID_COUNT is no longer a limit, the slot
+// arrays grow as needed.
+//
+// In vanilla, the list ends at the first slot holding TID 0, which is what
+// a morphed monster without a TID takes. Any slots past it are out of reach
+// of all three functions until the next level. This is emulated for demos,
+// network games and -vanilla only: otherwise the whole list is searched.
+#define TID_HASH_SIZE 256  // must be a power of 2
+#define TID_VANILLA (!singleplayer || vanillaparm)
+#define TID_HASH(tid) ((unsigned int) (tid) & (TID_HASH_SIZE - 1))
 
 // TYPES -------------------------------------------------------------------
 
@@ -97,8 +110,15 @@ static fixed_t FloatBobOffsetsHalfed[64] = {
 
 // PRIVATE DATA DEFINITIONS ------------------------------------------------
 
-static int TIDList[MAX_TID_COUNT + 1];  // +1 for termination marker
-static mobj_t *TIDMobj[MAX_TID_COUNT];
+static int *TIDList;                // TID of each slot, -1 if empty
+static mobj_t **TIDMobj;
+static int *TIDNext;                // next slot in the same bucket, or -1
+static int *TIDPrev;                // previous slot in the same bucket, or -1
+static int TIDHead[TID_HASH_SIZE];  // lowest slot of each bucket, or -1
+static int TIDTail[TID_HASH_SIZE];  // highest slot of each bucket, or -1
+static int TIDCount;                // number of used slots (high-water mark)
+static int TIDMax;                  // number of allocated slots
+static int TIDFirstFree;            // no empty slots below this one
 
 // CODE --------------------------------------------------------------------
 
@@ -127,7 +147,8 @@ boolean P_SetMobjState(mobj_t * mobj, statenum_t state)
     mobj->frame = st->frame;
     if (st->action)
     {                           // Call action function
-        st->action(mobj, NULL, NULL);
+        M_PROFCALL(PROF_ACTION, st->action, mobj->type,
+                   st->action(mobj, NULL, NULL));
     }
     return (true);
 }
@@ -1991,6 +2012,168 @@ void P_SpawnMapThing(mapthing_t * mthing)
     }
 }
 
+//==========================================================================
+//
+// TIDLinkSlot
+//
+// Links a slot into its hash bucket, keeping the bucket sorted by slot.
+//
+//==========================================================================
+
+static void TIDLinkSlot(int slot)
+{
+    const unsigned int hash = TID_HASH(TIDList[slot]);
+    int prev, next;
+
+    if (TIDTail[hash] < slot)
+    {                           // Common case, append to the bucket
+        prev = TIDTail[hash];
+        next = -1;
+    }
+    else
+    {
+        for (next = TIDHead[hash]; next < slot; next = TIDNext[next]);
+        prev = TIDPrev[next];
+    }
+
+    TIDPrev[slot] = prev;
+    TIDNext[slot] = next;
+    if (prev == -1)
+    {
+        TIDHead[hash] = slot;
+    }
+    else
+    {
+        TIDNext[prev] = slot;
+    }
+    if (next == -1)
+    {
+        TIDTail[hash] = slot;
+    }
+    else
+    {
+        TIDPrev[next] = slot;
+    }
+}
+
+//==========================================================================
+//
+// TIDUnlinkSlot
+//
+//==========================================================================
+
+static void TIDUnlinkSlot(int slot)
+{
+    const unsigned int hash = TID_HASH(TIDList[slot]);
+
+    if (TIDPrev[slot] == -1)
+    {
+        TIDHead[hash] = TIDNext[slot];
+    }
+    else
+    {
+        TIDNext[TIDPrev[slot]] = TIDNext[slot];
+    }
+    if (TIDNext[slot] == -1)
+    {
+        TIDTail[hash] = TIDPrev[slot];
+    }
+    else
+    {
+        TIDPrev[TIDNext[slot]] = TIDPrev[slot];
+    }
+}
+
+//==========================================================================
+//
+// TIDAppendSlot
+//
+// Returns a new slot at the end of the list, growing it if needed.
+//
+//==========================================================================
+
+static int TIDAppendSlot(void)
+{
+    if (TIDCount == TIDMax)
+    {
+        TIDMax = TIDMax ? TIDMax * 2 : 256;
+        TIDList = I_Realloc(TIDList, TIDMax * sizeof(*TIDList));
+        TIDMobj = I_Realloc(TIDMobj, TIDMax * sizeof(*TIDMobj));
+        TIDNext = I_Realloc(TIDNext, TIDMax * sizeof(*TIDNext));
+        TIDPrev = I_Realloc(TIDPrev, TIDMax * sizeof(*TIDPrev));
+    }
+    return TIDCount++;
+}
+
+//==========================================================================
+//
+// TIDFreeSlot
+//
+//==========================================================================
+
+static void TIDFreeSlot(int slot)
+{
+    TIDUnlinkSlot(slot);
+    TIDList[slot] = -1;
+    TIDMobj[slot] = NULL;
+    if (slot < TIDFirstFree)
+    {
+        TIDFirstFree = slot;
+    }
+}
+
+//==========================================================================
+//
+// TIDInsertVanilla
+//
+// Inserts the way vanilla does: into the first empty slot before the
+// first TID 0, or else over that TID 0, which also overwrites the next
+// slot with the terminating 0.
+//
+//==========================================================================
+
+static void TIDInsertVanilla(mobj_t * mobj, int tid)
+{
+    int index;
+
+    for (index = 0; index < TIDCount && TIDList[index] != 0; index++)
+    {
+        if (TIDList[index] == -1)
+        {                       // Found empty slot
+            break;
+        }
+    }
+    if (index == TIDCount)
+    {                           // Append required
+        index = TIDAppendSlot();
+    }
+    else if (TIDList[index] == 0)
+    {                           // Take the terminator's place
+        TIDUnlinkSlot(index);
+        if (index + 1 < TIDCount)
+        {
+            if (TIDList[index + 1] != -1)
+            {
+                TIDUnlinkSlot(index + 1);
+            }
+            else if (index + 1 == TIDFirstFree)
+            {
+                TIDFirstFree = index + 2;
+            }
+            TIDList[index + 1] = 0;
+            TIDLinkSlot(index + 1);
+        }
+    }
+    if (index == TIDFirstFree)
+    {
+        TIDFirstFree = index + 1;
+    }
+    mobj->tid = tid;
+    TIDList[index] = tid;
+    TIDMobj[index] = mobj;
+    TIDLinkSlot(index);
+}
+
 //==========================================================================
 //
 // P_CreateTIDList
@@ -2003,7 +2186,13 @@ void P_CreateTIDList(void)
     mobj_t *mobj;
     thinker_t *t;
 
-    i = 0;
+    TIDCount = 0;
+    TIDFirstFree = 0;
+    for (i = 0; i < TID_HASH_SIZE; i++)
+    {
+        TIDHead[i] = TIDTail[i] = -1;
+    }
+
     for (t = thinkercap.next; t != &thinkercap; t = t->next)
     {                           // Search all current thinkers
         if (t->function != P_MobjThinker)
@@ -2013,19 +2202,13 @@ void P_CreateTIDList(void)
         mobj = (mobj_t *) t;
         if (mobj->tid != 0)
         {                       // Add to list
-            if (i == MAX_TID_COUNT)
-            {
-                I_Error(english_language ?
-                        "P_CreateTIDList: MAX_TID_COUNT (%d) exceeded." :
-                        "P_CreateTIDList: превышен лимит MAX_TID_COUNT (%d).",
-                        MAX_TID_COUNT);
-            }
+            i = TIDAppendSlot();
             TIDList[i] = mobj->tid;
-            TIDMobj[i++] = mobj;
+            TIDMobj[i] = mobj;
+            TIDLinkSlot(i);
         }
     }
-    // Add termination marker
-    TIDList[i] = 0;
+    TIDFirstFree = TIDCount;
 }
 
 //==========================================================================
@@ -2036,33 +2219,31 @@ void P_CreateTIDList(void)
 
 void P_InsertMobjIntoTIDList(mobj_t * mobj, int tid)
 {
-    int i;
     int index;
 
-    index = -1;
-    for (i = 0; TIDList[i] != 0; i++)
+    if (TID_VANILLA)
+    {
+        TIDInsertVanilla(mobj, tid);
+        return;
+    }
+
+    // Use the first empty slot, as vanilla does
+    for (index = TIDFirstFree; index < TIDCount; index++)
     {
-        if (TIDList[i] == -1)
+        if (TIDList[index] == -1)
         {                       // Found empty slot
-            index = i;
             break;
         }
     }
-    if (index == -1)
+    if (index == TIDCount)
     {                           // Append required
-        if (i == MAX_TID_COUNT)
-        {
-            I_Error(english_language ?
-                    "P_InsertMobjIntoTIDList: MAX_TID_COUNT (%d) exceeded." :
-                    "P_InsertMobjIntoTIDList: превышен лимит MAX_TID_COUNT (%d).",
-                    MAX_TID_COUNT);
-        }
-        index = i;
-        TIDList[index + 1] = 0;
+        index = TIDAppendSlot();
     }
+    TIDFirstFree = index + 1;
     mobj->tid = tid;
     TIDList[index] = tid;
     TIDMobj[index] = mobj;
+    TIDLinkSlot(index);
 }
 
 //==========================================================================
@@ -2075,14 +2256,26 @@ void P_RemoveMobjFromTIDList(mobj_t * mobj)
 {
     int i;
 
-    for (i = 0; TIDList[i] != 0; i++)
+    if (TID_VANILLA)
+    {                           // Only up to the first TID 0
+        for (i = 0; i < TIDCount && TIDList[i] != 0; i++)
+        {
+            if (TIDMobj[i] == mobj)
+            {
+                TIDFreeSlot(i);
+                break;
+            }
+        }
+        mobj->tid = 0;
+        return;
+    }
+
+    for (i = TIDHead[TID_HASH(mobj->tid)]; i != -1; i = TIDNext[i])
     {
         if (TIDMobj[i] == mobj)
         {
-            TIDList[i] = -1;
-            TIDMobj[i] = NULL;
-            mobj->tid = 0;
-            return;
+            TIDFreeSlot(i);
+            break;
         }
     }
     mobj->tid = 0;
@@ -2098,12 +2291,39 @@ mobj_t *P_FindMobjFromTID(int tid, int *searchPosition)
 {
     int i;
 
-    for (i = *searchPosition + 1; TIDList[i] != 0; i++)
+    if (TID_VANILLA)
+    {                           // Only up to the first TID 0
+        for (i = *searchPosition + 1; i < TIDCount && TIDList[i] != 0; i++)
+        {
+            if (TIDList[i] == tid)
+            {
+                *searchPosition = i;
+                return TIDMobj[i];
+            }
+        }
+        *searchPosition = -1;
+        return NULL;
+    }
+
+    if (tid != 0 && tid != -1)
     {
-        if (TIDList[i] == tid)
+        i = *searchPosition;
+        if (i >= 0 && i < TIDCount && TIDList[i] == tid)
+        {                       // Continue from the last found slot
+            i = TIDNext[i];
+        }
+        else
+        {                       // Find the first slot after the position
+            for (i = TIDHead[TID_HASH(tid)]; i != -1 && i <= *searchPosition;
+                 i = TIDNext[i]);
+        }
+        for (; i != -1; i = TIDNext[i])
         {
-            *searchPosition = i;
-            return TIDMobj[i];
+            if (TIDList[i] == tid)
+            {
+                *searchPosition = i;
+                return TIDMobj[i];
+            }
         }
     }
     *searchPosition = -1;
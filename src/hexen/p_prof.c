@@ -0,0 +1,271 @@
+//
+// Copyright(C) 2016-2023 Julian Nechaevsky
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// DESCRIPTION:
+//	Names of action functions and thinkers for profiling, see m_prof.c.
+//
+
+
+#include "h2def.h"
+#include "m_prof.h"
+#include "p_local.h"
+#include "p_spec.h"
+
+
+#define PROFNAME(f) { (proffunc_t) f, #f }
+
+static const profname_t profnames[] = {
+    // Thinkers.
+    PROFNAME(P_MobjThinker),
+    PROFNAME(P_BlasterMobjThinker),
+    PROFNAME(T_MoveFloor),
+    PROFNAME(T_MoveCeiling),
+    PROFNAME(T_VerticalDoor),
+    PROFNAME(T_PlatRaise),
+    PROFNAME(T_BuildPillar),
+    PROFNAME(T_FloorWaggle),
+    PROFNAME(T_Light),
+    PROFNAME(T_Phase),
+    PROFNAME(T_InterpretACS),
+    PROFNAME(T_RotatePoly),
+    PROFNAME(T_MovePoly),
+    PROFNAME(T_PolyDoor),
+
+    // Action functions.
+    PROFNAME(A_FreeTargMobj),
+    PROFNAME(A_FlameCheck),
+    PROFNAME(A_HideThing),
+    PROFNAME(A_RestoreSpecialThing1),
+    PROFNAME(A_RestoreSpecialThing2),
+    PROFNAME(A_RestoreArtifact),
+    PROFNAME(A_Summon),
+    PROFNAME(A_ThrustInitUp),
+    PROFNAME(A_ThrustInitDn),
+    PROFNAME(A_ThrustRaise),
+    PROFNAME(A_ThrustBlock),
+    PROFNAME(A_ThrustImpale),
+    PROFNAME(A_ThrustLower),
+    PROFNAME(A_TeloSpawnC),
+    PROFNAME(A_TeloSpawnB),
+    PROFNAME(A_TeloSpawnA),
+    PROFNAME(A_TeloSpawnD),
+    PROFNAME(A_CheckTeleRing),
+    PROFNAME(A_FogSpawn),
+    PROFNAME(A_FogMove),
+    PROFNAME(A_Quake),
+    PROFNAME(A_ContMobjSound),
+    PROFNAME(A_Scream),
+    PROFNAME(A_PoisonBagInit),
+    PROFNAME(A_PoisonBagDamage),
+    PROFNAME(A_PoisonBagCheck),
+    PROFNAME(A_CheckThrowBomb),
+    PROFNAME(A_NoGravity),
+    PROFNAME(A_PotteryExplode),
+    PROFNAME(A_PotteryChooseBit),
+    PROFNAME(A_PotteryCheck),
+    PROFNAME(A_CorpseBloodDrip),
+    PROFNAME(A_CorpseExplode),
+    PROFNAME(A_LeafSpawn),
+    PROFNAME(A_LeafThrust),
+    PROFNAME(A_LeafCheck),
+    PROFNAME(A_BridgeInit),
+    PROFNAME(A_BridgeOrbit),
+    PROFNAME(A_TreeDeath),
+    PROFNAME(A_PoisonShroom),
+    PROFNAME(A_Pain),
+    PROFNAME(A_SoAExplode),
+    PROFNAME(A_BellReset1),
+    PROFNAME(A_BellReset2),
+    PROFNAME(A_Light0),
+    PROFNAME(A_WeaponReady),
+    PROFNAME(A_Lower),
+    PROFNAME(A_Raise),
+    PROFNAME(A_FPunchAttack),
+    PROFNAME(A_ReFire),
+    PROFNAME(A_FAxeAttack),
+    PROFNAME(A_FHammerAttack),
+    PROFNAME(A_FHammerThrow),
+    PROFNAME(A_FSwordAttack),
+    PROFNAME(A_FSwordFlames),
+    PROFNAME(A_CMaceAttack),
+    PROFNAME(A_CStaffInitBlink),
+    PROFNAME(A_CStaffCheckBlink),
+    PROFNAME(A_CStaffCheck),
+    PROFNAME(A_CStaffAttack),
+    PROFNAME(A_CStaffMissileSlither),
+    PROFNAME(A_CFlameAttack),
+    PROFNAME(A_CFlameRotate),
+    PROFNAME(A_CFlamePuff),
+    PROFNAME(A_CFlameMissile),
+    PROFNAME(A_CHolyAttack),
+    PROFNAME(A_CHolyPalette),
+    PROFNAME(A_CHolySeek),
+    PROFNAME(A_CHolyCheckScream),
+    PROFNAME(A_CHolyTail),
+    PROFNAME(A_CHolySpawnPuff),
+    PROFNAME(A_CHolyAttack2),
+    PROFNAME(A_MWandAttack),
+    PROFNAME(A_LightningReady),
+    PROFNAME(A_MLightningAttack),
+    PROFNAME(A_LightningZap),
+    PROFNAME(A_LightningClip),
+    PROFNAME(A_LightningRemove),
+    PROFNAME(A_LastZap),
+    PROFNAME(A_ZapMimic),
+    PROFNAME(A_MStaffAttack),
+    PROFNAME(A_MStaffPalette),
+    PROFNAME(A_MStaffWeave),
+    PROFNAME(A_MStaffTrack),
+    PROFNAME(A_SnoutAttack),
+    PROFNAME(A_FireConePL1),
+    PROFNAME(A_ShedShard),
+    PROFNAME(A_AddPlayerCorpse),
+    PROFNAME(A_SkullPop),
+    PROFNAME(A_FreezeDeath),
+    PROFNAME(A_CheckBurnGone),
+    PROFNAME(A_CheckSkullFloor),
+    PROFNAME(A_CheckSkullDone),
+    PROFNAME(A_SpeedFade),
+    PROFNAME(A_IceSetTics),
+    PROFNAME(A_IceCheckHeadDone),
+    PROFNAME(A_PigPain),
+    PROFNAME(A_PigLook),
+    PROFNAME(A_PigChase),
+    PROFNAME(A_FaceTarget),
+    PROFNAME(A_PigAttack),
+    PROFNAME(A_QueueCorpse),
+    PROFNAME(A_Look),
+    PROFNAME(A_Chase),
+    PROFNAME(A_CentaurAttack),
+    PROFNAME(A_CentaurAttack2),
+    PROFNAME(A_SetReflective),
+    PROFNAME(A_CentaurDefend),
+    PROFNAME(A_UnSetReflective),
+    PROFNAME(A_CentaurDropStuff),
+    PROFNAME(A_CheckFloor),
+    PROFNAME(A_DemonAttack1),
+    PROFNAME(A_DemonAttack2),
+    PROFNAME(A_DemonDeath),
+    PROFNAME(A_Demon2Death),
+    PROFNAME(A_WraithRaiseInit),
+    PROFNAME(A_WraithRaise),
+    PROFNAME(A_WraithInit),
+    PROFNAME(A_WraithLook),
+    PROFNAME(A_WraithChase),
+    PROFNAME(A_WraithFX3),
+    PROFNAME(A_WraithMelee),
+    PROFNAME(A_WraithMissile),
+    PROFNAME(A_WraithFX2),
+    PROFNAME(A_MinotaurFade1),
+    PROFNAME(A_MinotaurFade2),
+    PROFNAME(A_MinotaurChase),
+    PROFNAME(A_MinotaurRoam),
+    PROFNAME(A_MinotaurAtk1),
+    PROFNAME(A_MinotaurDecide),
+    PROFNAME(A_MinotaurAtk2),
+    PROFNAME(A_MinotaurAtk3),
+    PROFNAME(A_MinotaurCharge),
+    PROFNAME(A_SmokePuffExit),
+    PROFNAME(A_MinotaurFade0),
+    PROFNAME(A_MntrFloorFire),
+    PROFNAME(A_SerpentChase),
+    PROFNAME(A_SerpentHumpDecide),
+    PROFNAME(A_SerpentUnHide),
+    PROFNAME(A_SerpentRaiseHump),
+    PROFNAME(A_SerpentLowerHump),
+    PROFNAME(A_SerpentHide),
+    PROFNAME(A_SerpentBirthScream),
+    PROFNAME(A_SetShootable),
+    PROFNAME(A_SerpentCheckForAttack),
+    PROFNAME(A_UnSetShootable),
+    PROFNAME(A_SerpentDiveSound),
+    PROFNAME(A_SerpentWalk),
+    PROFNAME(A_SerpentChooseAttack),
+    PROFNAME(A_SerpentMeleeAttack),
+    PROFNAME(A_SerpentMissileAttack),
+    PROFNAME(A_SerpentHeadPop),
+    PROFNAME(A_SerpentSpawnGibs),
+    PROFNAME(A_SerpentHeadCheck),
+    PROFNAME(A_FloatGib),
+    PROFNAME(A_DelayGib),
+    PROFNAME(A_SinkGib),
+    PROFNAME(A_BishopDecide),
+    PROFNAME(A_BishopDoBlur),
+    PROFNAME(A_BishopSpawnBlur),
+    PROFNAME(A_BishopChase),
+    PROFNAME(A_BishopAttack),
+    PROFNAME(A_BishopAttack2),
+    PROFNAME(A_BishopPainBlur),
+    PROFNAME(A_BishopPuff),
+    PROFNAME(A_SetAltShadow),
+    PROFNAME(A_BishopMissileWeave),
+    PROFNAME(A_BishopMissileSeek),
+    PROFNAME(A_DragonInitFlight),
+    PROFNAME(A_DragonFlap),
+    PROFNAME(A_DragonFlight),
+    PROFNAME(A_DragonAttack),
+    PROFNAME(A_DragonPain),
+    PROFNAME(A_DragonCheckCrash),
+    PROFNAME(A_DragonFX2),
+    PROFNAME(A_ESound),
+    PROFNAME(A_EttinAttack),
+    PROFNAME(A_DropMace),
+    PROFNAME(A_FiredRocks),
+    PROFNAME(A_UnSetInvulnerable),
+    PROFNAME(A_FiredChase),
+    PROFNAME(A_FiredAttack),
+    PROFNAME(A_FiredSplotch),
+    PROFNAME(A_SmBounce),
+    PROFNAME(A_IceGuyLook),
+    PROFNAME(A_IceGuyChase),
+    PROFNAME(A_IceGuyAttack),
+    PROFNAME(A_IceGuyDie),
+    PROFNAME(A_IceGuyMissilePuff),
+    PROFNAME(A_IceGuyMissileExplode),
+    PROFNAME(A_ClassBossHealth),
+    PROFNAME(A_FastChase),
+    PROFNAME(A_FighterAttack),
+    PROFNAME(A_ClericAttack),
+    PROFNAME(A_MageAttack),
+    PROFNAME(A_SorcBallPop),
+    PROFNAME(A_SorcFX2Split),
+    PROFNAME(A_SorcFX2Orbit),
+    PROFNAME(A_SorcererBishopEntry),
+    PROFNAME(A_SpawnBishop),
+    PROFNAME(A_SorcFX4Check),
+    PROFNAME(A_KoraxStep2),
+    PROFNAME(A_KoraxChase),
+    PROFNAME(A_KoraxStep),
+    PROFNAME(A_KoraxDecide),
+    PROFNAME(A_KoraxMissile),
+    PROFNAME(A_KoraxCommand),
+    PROFNAME(A_KoraxBonePop),
+    PROFNAME(A_KSpiritRoam),
+    PROFNAME(A_KBoltRaise),
+    PROFNAME(A_KBolt),
+    PROFNAME(A_BatSpawnInit),
+    PROFNAME(A_BatSpawn),
+    PROFNAME(A_BatMove),
+    { NULL, NULL }
+};
+
+//==========================================================================
+//
+// P_InitProfile
+//
+//==========================================================================
+
+void P_InitProfile (void)
+{
+    M_ProfInit(profnames);
+}
@@ -21,6 +21,7 @@
 
 #include "h2def.h"
 #include "m_random.h"
+#include "m_prof.h"
 #include "p_local.h"
 #include "s_sound.h"
 
@@ -246,7 +247,8 @@ void P_SetPsprite(player_t * player, int position, statenum_t stnum)
         }
         if (state->action)
         {                       // Call action routine.
-            state->action(NULL, player, psp);
+            M_PROFCALL(PROF_WEAPON, state->action, -1,
+                       state->action(NULL, player, psp));
             if (!psp->state)
             {
                 break;
@@ -26,6 +26,7 @@
 #include "i_system.h"
 #include "m_argv.h"
 #include "m_bbox.h"
+#include "m_prof.h"
 #include "m_misc.h"
 #include "i_swap.h"
 #include "s_sound.h"
@@ -1191,6 +1192,7 @@ void P_SetupLevel(int episode, int map, int playermask, skill_t skill)
     }
     players[consoleplayer].viewz = 1;   // will be set by player think
 
+    P_ACSPrintProfile();    // Before previous level scripts are freed
     Z_FreeTags(PU_LEVEL, PU_PURGELEVEL - 1);
 
     P_InitThinkers();
@@ -1200,6 +1202,9 @@ void P_SetupLevel(int episode, int map, int playermask, skill_t skill)
     M_snprintf(lumpname, sizeof(lumpname), "MAP%02d", map);
     lumpnum = W_GetNumForName(lumpname);
 
+    // [JN] Report the actions and thinkers of the previous level.
+    M_ProfLevel(lumpname);
+
     // [JN] Check if optinial map fixes can be applied.
     canmodify = (W_CheckMultipleLumps(lumpname) == 1
               && (!netgame && !vanillaparm && gamemode != shareware && singleplayer));
@@ -1239,6 +1244,8 @@ void P_SetupLevel(int episode, int map, int playermask, skill_t skill)
     P_LoadSegs(lumpnum + ML_SEGS);
     rejectmatrix = W_CacheLumpNum(lumpnum + ML_REJECT, PU_LEVEL);
     P_GroupLines();
+    // [JN] chain sectors by tag for specials
+    P_InitTagLists();
     // [crispy] remove slime trails
     P_RemoveSlimeTrails();
     // [crispy] fix long wall wobble
@@ -1266,6 +1273,7 @@ void P_SetupLevel(int episode, int map, int playermask, skill_t skill)
             }
         }
     }
+    P_DecodeACScripts();
     //
     // End of map lump processing
     //
@@ -1778,6 +1786,8 @@ void P_Init(void)
     P_InitTerrainTypes();
     P_InitLava();
     R_InitSprites(sprnames);
+    P_InitProfile();
+    P_InitACSProfile();
 }
 
 
@@ -329,6 +329,40 @@ int     P_FindSectorFromLineTag(line_t  *line,int start)
 }
 */
 
+//=========================================================================
+//
+// P_InitTagLists
+//
+// [JN] Chains sectors of every tag in ascending order, hashed by tag,
+// so P_FindSectorFromTag doesn't have to scan all of the sectors.
+// Must be called again whenever sector tags change.
+//
+//=========================================================================
+
+static int *sectortaghead;  // First sector of each hash bucket.
+static int *sectortagnext;  // Next sector of the same bucket.
+
+void P_InitTagLists(void)
+{
+    int i;
+
+    sectortaghead = I_Realloc(sectortaghead, numsectors * sizeof(*sectortaghead));
+    sectortagnext = I_Realloc(sectortagnext, numsectors * sizeof(*sectortagnext));
+
+    for (i = 0; i < numsectors; i++)
+    {
+        sectortaghead[i] = -1;
+    }
+
+    for (i = numsectors - 1; i >= 0; i--)
+    {
+        const int j = (unsigned) sectors[i].tag % numsectors;
+
+        sectortagnext[i] = sectortaghead[j];
+        sectortaghead[j] = i;
+    }
+}
+
 //=========================================================================
 //
 // P_FindSectorFromTag
@@ -339,14 +373,27 @@ int P_FindSectorFromTag(int tag, int start)
 {
     int i;
 
-    for (i = start + 1; i < numsectors; i++)
+    // [JN] Only sectors of the same tag are certainly in the same chain.
+    if (start >= 0 && sectors[start].tag != tag)
     {
-        if (sectors[i].tag == tag)
+        for (i = start + 1; i < numsectors; i++)
         {
-            return i;
+            if (sectors[i].tag == tag)
+            {
+                return i;
+            }
         }
+        return -1;
+    }
+
+    i = start < 0 ? sectortaghead[(unsigned) tag % numsectors]
+                  : sectortagnext[start];
+
+    while (i >= 0 && sectors[i].tag != tag)
+    {
+        i = sectortagnext[i];
     }
-    return -1;
+    return i;
 }
 
 //==================================================================
@@ -65,6 +65,7 @@ fixed_t P_FindLowestCeilingSurrounding(sector_t * sec);
 fixed_t P_FindHighestCeilingSurrounding(sector_t * sec);
 //int P_FindSectorFromLineTag(line_t  *line,int start);
 int P_FindSectorFromTag(int tag, int start);
+void P_InitTagLists(void);
 //int P_FindMinSurroundingLight(sector_t *sector,int max);
 sector_t *getNextSector(line_t * line, sector_t * sec);
 line_t *P_FindLine(int lineTag, int *searchPosition);
@@ -517,6 +518,7 @@ struct acsInfo_s
     int argCount;
     aste_t state;
     int waitValue;
+    unsigned int instructions;  // Executed P-Code instructions, for -acsprofile
 };
 
 struct acs_s
@@ -542,6 +544,9 @@ typedef struct
 } acsstore_t;
 
 void P_LoadACScripts(int lump);
+void P_DecodeACScripts(void);
+void P_InitACSProfile(void);
+void P_ACSPrintProfile(void);
 boolean P_StartACS(int number, int map, byte * args, mobj_t * activator,
                    line_t * line, int side);
 boolean P_StartLockedACS(line_t * line, byte * args, mobj_t * mo, int side);
@@ -52,6 +52,8 @@ switchlist_t *alphSwitchList = NULL;
 
 int switchlist[MAXSWITCHES * 2];
 int numswitches;
+static int *switchfirst;    // [JN] First entry of every texture, or -1.
+static int switchtextures;  // [JN] Size of switchfirst.
 button_t buttonlist[MAXBUTTONS];
 
 /*
@@ -92,6 +94,35 @@ void P_InitSwitchList(void)
         switchlist[index++] = R_TextureNumForName(alphSwitchList[i].name1);
         switchlist[index++] = R_TextureNumForName(alphSwitchList[i].name2);
     }
+
+    // [JN] Index the list by texture, so switches don't have to search it.
+    for (i = 0, switchtextures = 0; i < numswitches * 2; i++)
+    {
+        if (switchlist[i] >= switchtextures)
+        {
+            switchtextures = switchlist[i] + 1;
+        }
+    }
+
+    switchfirst = Z_Malloc((switchtextures + 1) * sizeof(*switchfirst), PU_STATIC, 0);
+    for (i = 0; i < switchtextures; i++)
+    {
+        switchfirst[i] = -1;
+    }
+    for (i = numswitches * 2 - 1; i >= 0; i--)
+    {
+        switchfirst[switchlist[i]] = i;
+    }
+}
+
+//==================================================================
+//
+//      [JN] First entry of a texture in the switch list, or -1.
+//
+//==================================================================
+static int P_SwitchFirst(int texture)
+{
+    return texture >= 0 && texture < switchtextures ? switchfirst[texture] : -1;
 }
 
 //==================================================================
@@ -131,13 +162,28 @@ void P_ChangeSwitchTexture(line_t * line, int useAgain)
     int texTop;
     int texMid;
     int texBot;
+    int firstMid, firstBot;
     int i;
 
     texTop = sides[line->sidenum[0]].toptexture;
     texMid = sides[line->sidenum[0]].midtexture;
     texBot = sides[line->sidenum[0]].bottomtexture;
 
-    for (i = 0; i < numswitches * 2; i++)
+    // [JN] The first entry of any of the three textures is the one
+    // the search through the whole list would stop at.
+    i = P_SwitchFirst(texTop);
+    firstMid = P_SwitchFirst(texMid);
+    firstBot = P_SwitchFirst(texBot);
+    if (firstMid >= 0 && (i < 0 || firstMid < i))
+    {
+        i = firstMid;
+    }
+    if (firstBot >= 0 && (i < 0 || firstBot < i))
+    {
+        i = firstBot;
+    }
+
+    if (i >= 0)
     {
         if (switchlist[i] == texTop)
         {
@@ -20,6 +20,7 @@
 // HEADER FILES ------------------------------------------------------------
 
 #include "h2def.h"
+#include "m_prof.h"
 #include "p_local.h"
 
 // MACROS ------------------------------------------------------------------
@@ -80,6 +81,23 @@ void P_Ticker(void)
     leveltime++;
 }
 
+//==========================================================================
+//
+// RunThinker
+//
+// [JN] Runs a single thinker, timed if profiling.
+//
+//==========================================================================
+
+static void RunThinker(thinker_t *thinker)
+{
+    M_PROFCALL(PROF_THINKER, thinker->function,
+               thinker->function == P_MobjThinker
+            || thinker->function == P_BlasterMobjThinker ?
+               ((mobj_t *) thinker)->type : -1,
+               thinker->function(thinker));
+}
+
 //==========================================================================
 //
 // RunThinkers
@@ -100,7 +118,7 @@ static void RunThinkers(void)
         {
             if (currentthinker->function)
                 if (currentthinker->function == P_MobjThinker)
-                    currentthinker->function (currentthinker);
+                    RunThinker(currentthinker);
 
             nextthinker = currentthinker->next;
             currentthinker = nextthinker;
@@ -124,14 +142,14 @@ static void RunThinkers(void)
             {
                 if (currentthinker->function)
                     if (currentthinker->function != P_MobjThinker)
-                        currentthinker->function (currentthinker);
+                        RunThinker(currentthinker);
 
                 nextthinker = currentthinker->next;
             }
             else
             {
                 if (currentthinker->function)
-                    currentthinker->function(currentthinker);
+                    RunThinker(currentthinker);
 
                 nextthinker = currentthinker->next;
             }
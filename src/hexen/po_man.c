@@ -29,9 +29,18 @@
 // MACROS ------------------------------------------------------------------
 
 #define PO_MAXPOLYSEGS 64
+#define PO_GATHERBLOCKS 8       // gather mobjs if blocks per seg are fewer
 
 // TYPES -------------------------------------------------------------------
 
+// A mobj that a moving polyobj may touch, with the block it is linked in
+typedef struct
+{
+    mobj_t *mobj;
+    int blockx;
+    int blocky;
+} polymobj_t;
+
 // EXTERNAL FUNCTION PROTOTYPES --------------------------------------------
 
 // PRIVATE FUNCTION PROTOTYPES ---------------------------------------------
@@ -44,8 +53,15 @@ static void RotatePt(int an, fixed_t * x, fixed_t * y, fixed_t startSpotX,
                      fixed_t startSpotY);
 static void UnLinkPolyobj(polyobj_t * po);
 static void LinkPolyobj(polyobj_t * po);
+static void GatherPolyMobjs(fixed_t *box, int numsegs);
 static boolean CheckMobjBlocking(seg_t * seg, polyobj_t * po);
+static boolean CheckBlockMobjs(seg_t * seg, polyobj_t * po, int left,
+                               int right, int bottom, int top, int x, int y,
+                               mobj_t * mobj);
+static boolean ThrustIfTouching(mobj_t * mobj, seg_t * seg, polyobj_t * po);
 static void InitBlockMap(void);
+static int PolySegHashKey(fixed_t x, fixed_t y);
+static void InitPolySegHash(void);
 static void IterFindPolySegs(int x, int y, seg_t ** segList);
 static void SpawnPolyobj(int index, int tag, boolean crush);
 static void TranslateToStartSpot(int tag, int originX, int originY);
@@ -64,6 +80,22 @@ static int PolySegCount;
 static fixed_t PolyStartX;
 static fixed_t PolyStartY;
 
+// Segs chained by start vertex, only while spawning polyobjs
+static int *PolySegHash;
+static int *PolySegNext;
+static int PolySegHashMask;
+
+// Mobjs near the polyobj being moved, in blockmap walk order
+static polymobj_t *PolyMobjs;
+static int PolyMobjCount;
+static int PolyMobjMax;
+static int *PolyMobjRows;       // First PolyMobjs index of each block row
+static int PolyMobjRowMax;
+static int PolyMobjBox[4];
+static fixed_t PolyBox[4];
+static boolean PolyMobjsUsed;   // False if the segs walk the blocks
+static boolean PolyMobjsStale;  // Gather again before the next seg
+
 // CODE --------------------------------------------------------------------
 
 // ===== Polyobj Event Code =====
@@ -797,6 +829,7 @@ boolean PO_MovePolyobj(int num, int x, int y)
     polyobj_t *po;
     vertex_t *prevPts;
     boolean blocked;
+    fixed_t box[4];
 
     if (!(po = GetPolyobj(num)))
     {
@@ -830,6 +863,11 @@ boolean PO_MovePolyobj(int num, int x, int y)
         (*prevPts).x += x;      // previous points are unique for each seg
         (*prevPts).y += y;
     }
+    box[BOXTOP] = po->vertexbox[BOXTOP] + y;
+    box[BOXBOTTOM] = po->vertexbox[BOXBOTTOM] + y;
+    box[BOXLEFT] = po->vertexbox[BOXLEFT] + x;
+    box[BOXRIGHT] = po->vertexbox[BOXRIGHT] + x;
+    GatherPolyMobjs(box, po->numsegs);
     segList = po->segs;
     for (count = po->numsegs; count; count--, segList++)
     {
@@ -1013,6 +1051,7 @@ boolean PO_RotatePolyobj(int num, angle_t angle)
     vertex_t *prevPts;
     polyobj_t *po;
     boolean blocked;
+    fixed_t box[4];
 
     if (!(po = GetPolyobj(num)))
     {
@@ -1028,6 +1067,13 @@ boolean PO_RotatePolyobj(int num, angle_t angle)
     po->rtheta = po->dtheta = 0; // [crispy]
     RotatePolyVertices(po, angle); // [crispy] prevPts get set here.
 
+    // The segs stay within radius from startSpot whatever the angle
+    box[BOXTOP] = po->startSpot.y + po->radius;
+    box[BOXBOTTOM] = po->startSpot.y - po->radius;
+    box[BOXLEFT] = po->startSpot.x - po->radius;
+    box[BOXRIGHT] = po->startSpot.x + po->radius;
+    GatherPolyMobjs(box, po->numsegs);
+
     segList = po->segs;
     blocked = false;
     validcount++;
@@ -1163,6 +1209,10 @@ static void LinkPolyobj(polyobj_t * po)
             bottomY = (*tempSeg)->v1->y;
         }
     }
+    po->vertexbox[BOXRIGHT] = rightX;
+    po->vertexbox[BOXLEFT] = leftX;
+    po->vertexbox[BOXTOP] = topY;
+    po->vertexbox[BOXBOTTOM] = bottomY;
     po->bbox[BOXRIGHT] = (rightX - bmaporgx) >> MAPBLOCKSHIFT;
     po->bbox[BOXLEFT] = (leftX - bmaporgx) >> MAPBLOCKSHIFT;
     po->bbox[BOXTOP] = (topY - bmaporgy) >> MAPBLOCKSHIFT;
@@ -1213,6 +1263,96 @@ static void LinkPolyobj(polyobj_t * po)
     }
 }
 
+//==========================================================================
+//
+// GatherPolyMobjs
+//
+// Collects the solid mobjs overlapping the bbox of a moved polyobj, so the
+// per-seg checks don't walk the same blocks over and over again. The box
+// must hold the seg bboxes both before and after the move, as rotation
+// updates them while checking; a seg out of it still walks the blocks.
+// Nothing else runs between the seg checks, so the list stays exact until
+// something is thrust, and is gathered again for the next seg then.
+//
+// Large polyobjs with few segs walk fewer blocks seg by seg, so these are
+// left alone.
+//
+//==========================================================================
+
+static void GatherPolyMobjs(fixed_t *box, int numsegs)
+{
+    mobj_t *mobj;
+    int x, y;
+    int rows;
+
+    if (box != PolyBox)
+    {
+        memcpy(PolyBox, box, sizeof(PolyBox));
+    }
+    PolyMobjsStale = false;
+
+    PolyMobjBox[BOXTOP] = (PolyBox[BOXTOP] - bmaporgy + MAXRADIUS)
+                          >> MAPBLOCKSHIFT;
+    PolyMobjBox[BOXBOTTOM] = (PolyBox[BOXBOTTOM] - bmaporgy - MAXRADIUS)
+                             >> MAPBLOCKSHIFT;
+    PolyMobjBox[BOXLEFT] = (PolyBox[BOXLEFT] - bmaporgx - MAXRADIUS)
+                           >> MAPBLOCKSHIFT;
+    PolyMobjBox[BOXRIGHT] = (PolyBox[BOXRIGHT] - bmaporgx + MAXRADIUS)
+                            >> MAPBLOCKSHIFT;
+
+    PolyMobjBox[BOXBOTTOM] = BETWEEN(0, bmapheight - 1, PolyMobjBox[BOXBOTTOM]);
+    PolyMobjBox[BOXTOP] = BETWEEN(0, bmapheight - 1, PolyMobjBox[BOXTOP]);
+    PolyMobjBox[BOXLEFT] = BETWEEN(0, bmapwidth - 1, PolyMobjBox[BOXLEFT]);
+    PolyMobjBox[BOXRIGHT] = BETWEEN(0, bmapwidth - 1, PolyMobjBox[BOXRIGHT]);
+
+    rows = PolyMobjBox[BOXTOP] - PolyMobjBox[BOXBOTTOM] + 2;
+    PolyMobjsUsed = (rows - 1) * (PolyMobjBox[BOXRIGHT] - PolyMobjBox[BOXLEFT]
+                                  + 1) <= numsegs * PO_GATHERBLOCKS;
+    if (!PolyMobjsUsed)
+    {
+        return;
+    }
+    if (rows > PolyMobjRowMax)
+    {
+        PolyMobjRowMax = rows;
+        PolyMobjRows = I_Realloc(PolyMobjRows, rows * sizeof(*PolyMobjRows));
+    }
+
+    PolyMobjCount = 0;
+
+    // Fill rows in the order CheckBlockMobjs walks the blocks
+    for (y = PolyMobjBox[BOXBOTTOM]; y <= PolyMobjBox[BOXTOP]; y++)
+    {
+        PolyMobjRows[y - PolyMobjBox[BOXBOTTOM]] = PolyMobjCount;
+        for (x = PolyMobjBox[BOXLEFT]; x <= PolyMobjBox[BOXRIGHT]; x++)
+        {
+            for (mobj = blocklinks[y * bmapwidth + x]; mobj;
+                 mobj = mobj->bnext)
+            {
+                if (!(mobj->flags & MF_SOLID || mobj->player)
+                 || mobj->x + mobj->radius <= PolyBox[BOXLEFT]
+                 || mobj->x - mobj->radius >= PolyBox[BOXRIGHT]
+                 || mobj->y + mobj->radius <= PolyBox[BOXBOTTOM]
+                 || mobj->y - mobj->radius >= PolyBox[BOXTOP])
+                {
+                    continue;
+                }
+                if (PolyMobjCount == PolyMobjMax)
+                {
+                    PolyMobjMax = PolyMobjMax ? PolyMobjMax * 2 : 64;
+                    PolyMobjs = I_Realloc(PolyMobjs,
+                                          PolyMobjMax * sizeof(*PolyMobjs));
+                }
+                PolyMobjs[PolyMobjCount].mobj = mobj;
+                PolyMobjs[PolyMobjCount].blockx = x;
+                PolyMobjs[PolyMobjCount].blocky = y;
+                PolyMobjCount++;
+            }
+        }
+    }
+    PolyMobjRows[rows - 1] = PolyMobjCount;
+}
+
 //==========================================================================
 //
 // CheckMobjBlocking
@@ -1221,22 +1361,37 @@ static void LinkPolyobj(polyobj_t * po)
 
 static boolean CheckMobjBlocking(seg_t * seg, polyobj_t * po)
 {
-    mobj_t *mobj;
-    int i, j;
+    int i;
+    int end;
     int left, right, top, bottom;
-    int tmbbox[4];
     line_t *ld;
-    boolean blocked;
+    polymobj_t *pm;
+    boolean gathered;
+
+    if (PolyMobjsStale)
+    {
+        GatherPolyMobjs(PolyBox, po->numsegs);
+    }
 
     ld = seg->linedef;
 
+    gathered = PolyMobjsUsed
+            && ld->bbox[BOXLEFT] >= PolyBox[BOXLEFT]
+            && ld->bbox[BOXRIGHT] <= PolyBox[BOXRIGHT]
+            && ld->bbox[BOXBOTTOM] >= PolyBox[BOXBOTTOM]
+            && ld->bbox[BOXTOP] <= PolyBox[BOXTOP];
+
+    if (gathered && PolyMobjCount == 0)
+    {
+        // Nothing near the polyobj
+        return false;
+    }
+
     top = (ld->bbox[BOXTOP] - bmaporgy + MAXRADIUS) >> MAPBLOCKSHIFT;
     bottom = (ld->bbox[BOXBOTTOM] - bmaporgy - MAXRADIUS) >> MAPBLOCKSHIFT;
     left = (ld->bbox[BOXLEFT] - bmaporgx - MAXRADIUS) >> MAPBLOCKSHIFT;
     right = (ld->bbox[BOXRIGHT] - bmaporgx + MAXRADIUS) >> MAPBLOCKSHIFT;
 
-    blocked = false;
-
     bottom = bottom < 0 ? 0 : bottom;
     bottom = bottom >= bmapheight ? bmapheight - 1 : bottom;
     top = top < 0 ? 0 : top;
@@ -1246,39 +1401,119 @@ static boolean CheckMobjBlocking(seg_t * seg, polyobj_t * po)
     right = right < 0 ? 0 : right;
     right = right >= bmapwidth ? bmapwidth - 1 : right;
 
-    for (j = bottom * bmapwidth; j <= top * bmapwidth; j += bmapwidth)
+    if (!gathered)
+    {
+        if (CheckBlockMobjs(seg, po, left, right, bottom, top, left, bottom,
+                            blocklinks[bottom * bmapwidth + left]))
+        {
+            PolyMobjsStale = PolyMobjsUsed;
+            return true;
+        }
+        return false;
+    }
+
+    i = PolyMobjRows[bottom - PolyMobjBox[BOXBOTTOM]];
+    end = PolyMobjRows[top + 1 - PolyMobjBox[BOXBOTTOM]];
+    for (pm = &PolyMobjs[i]; i < end; i++, pm++)
+    {
+        if (pm->blockx < left || pm->blockx > right)
+        {
+            continue;
+        }
+        if (ThrustIfTouching(pm->mobj, seg, po))
+        {
+            // The thrust may have changed anything, finish the seg
+            // walking the blocks from here.
+            CheckBlockMobjs(seg, po, left, right, bottom, top,
+                            pm->blockx, pm->blocky, pm->mobj->bnext);
+            PolyMobjsStale = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+//==========================================================================
+//
+// CheckBlockMobjs
+//
+// Checks the mobjs of the blocks from left,bottom to right,top, starting
+// at mobj linked in block x,y.
+//
+//==========================================================================
+
+static boolean CheckBlockMobjs(seg_t * seg, polyobj_t * po, int left,
+                               int right, int bottom, int top, int x, int y,
+                               mobj_t * mobj)
+{
+    boolean blocked;
+
+    blocked = false;
+
+    if (left > right || bottom > top)
     {
-        for (i = left; i <= right; i++)
+        return false;
+    }
+    for (;;)
+    {
+        for (; mobj; mobj = mobj->bnext)
         {
-            for (mobj = blocklinks[j + i]; mobj; mobj = mobj->bnext)
+            if (ThrustIfTouching(mobj, seg, po))
             {
-                if (mobj->flags & MF_SOLID || mobj->player)
-                {
-                    tmbbox[BOXTOP] = mobj->y + mobj->radius;
-                    tmbbox[BOXBOTTOM] = mobj->y - mobj->radius;
-                    tmbbox[BOXLEFT] = mobj->x - mobj->radius;
-                    tmbbox[BOXRIGHT] = mobj->x + mobj->radius;
-
-                    if (tmbbox[BOXRIGHT] <= ld->bbox[BOXLEFT]
-                        || tmbbox[BOXLEFT] >= ld->bbox[BOXRIGHT]
-                        || tmbbox[BOXTOP] <= ld->bbox[BOXBOTTOM]
-                        || tmbbox[BOXBOTTOM] >= ld->bbox[BOXTOP])
-                    {
-                        continue;
-                    }
-                    if (P_BoxOnLineSide(tmbbox, ld) != -1)
-                    {
-                        continue;
-                    }
-                    ThrustMobj(mobj, seg, po);
-                    blocked = true;
-                }
+                blocked = true;
             }
         }
+        if (++x > right)
+        {
+            x = left;
+            if (++y > top)
+            {
+                break;
+            }
+        }
+        mobj = blocklinks[y * bmapwidth + x];
     }
     return blocked;
 }
 
+//==========================================================================
+//
+// ThrustIfTouching
+//
+//==========================================================================
+
+static boolean ThrustIfTouching(mobj_t * mobj, seg_t * seg, polyobj_t * po)
+{
+    int tmbbox[4];
+    line_t *ld;
+
+    if (!(mobj->flags & MF_SOLID || mobj->player))
+    {
+        return false;
+    }
+
+    ld = seg->linedef;
+
+    tmbbox[BOXTOP] = mobj->y + mobj->radius;
+    tmbbox[BOXBOTTOM] = mobj->y - mobj->radius;
+    tmbbox[BOXLEFT] = mobj->x - mobj->radius;
+    tmbbox[BOXRIGHT] = mobj->x + mobj->radius;
+
+    if (tmbbox[BOXRIGHT] <= ld->bbox[BOXLEFT]
+        || tmbbox[BOXLEFT] >= ld->bbox[BOXRIGHT]
+        || tmbbox[BOXTOP] <= ld->bbox[BOXBOTTOM]
+        || tmbbox[BOXBOTTOM] >= ld->bbox[BOXTOP])
+    {
+        return false;
+    }
+    if (P_BoxOnLineSide(tmbbox, ld) != -1)
+    {
+        return false;
+    }
+    ThrustMobj(mobj, seg, po);
+    return true;
+}
+
 //==========================================================================
 //
 // InitBlockMap
@@ -1335,6 +1570,46 @@ static void InitBlockMap(void)
     }
 }
 
+//==========================================================================
+//
+// InitPolySegHash
+//
+// Chains the segs by start vertex for IterFindPolySegs, which used to
+// scan all segs of the level for each polyobj seg. Chains keep the seg
+// order, so the same seg is found first.
+//
+//==========================================================================
+
+static int PolySegHashKey(fixed_t x, fixed_t y)
+{
+    return ((x >> FRACBITS) * 31 + (y >> FRACBITS)) & PolySegHashMask;
+}
+
+static void InitPolySegHash(void)
+{
+    int i;
+    int key;
+    int size;
+
+    size = 64;
+    while (size < numsegs)
+    {
+        size <<= 1;
+    }
+    PolySegHashMask = size - 1;
+
+    PolySegHash = Z_Malloc(size * sizeof(int), PU_STATIC, 0);
+    PolySegNext = Z_Malloc(numsegs * sizeof(int), PU_STATIC, 0);
+    memset(PolySegHash, -1, size * sizeof(int));
+
+    for (i = numsegs - 1; i >= 0; i--)
+    {
+        key = PolySegHashKey(segs[i].v1->x, segs[i].v1->y);
+        PolySegNext[i] = PolySegHash[key];
+        PolySegHash[key] = i;
+    }
+}
+
 //==========================================================================
 //
 // IterFindPolySegs
@@ -1351,7 +1626,7 @@ static void IterFindPolySegs(int x, int y, seg_t ** segList)
     {
         return;
     }
-    for (i = 0; i < numsegs; i++)
+    for (i = PolySegHash[PolySegHashKey(x, y)]; i != -1; i = PolySegNext[i])
     {
         if (segs[i].v1->x == x && segs[i].v1->y == y)
         {
@@ -1592,6 +1867,9 @@ static void TranslateToStartSpot(int tag, int originX, int originY)
         // unique to each seg, not each linedef
         tempPt->x = (*tempSeg)->v1->x - po->startSpot.x;
         tempPt->y = (*tempSeg)->v1->y - po->startSpot.y;
+        // P_AproxDistance never falls short, FRACUNIT covers rounding
+        po->radius = MAX(po->radius,
+                         P_AproxDistance(tempPt->x, tempPt->y) + FRACUNIT);
     }
     avg.x /= po->numsegs;
     avg.y /= po->numsegs;
@@ -1627,6 +1905,7 @@ void PO_Init(int lump)
     numthings = W_LumpLength(lump) / sizeof(mapthing_t);
     mt = (mapthing_t *) data;
     polyIndex = 0;              // index polyobj number
+    InitPolySegHash();
     // Find the startSpot points, and spawn each polyobj
     for (i = 0; i < numthings; i++, mt++)
     {
@@ -1646,6 +1925,8 @@ void PO_Init(int lump)
             polyIndex++;
         }
     }
+    Z_Free(PolySegHash);
+    Z_Free(PolySegNext);
     mt = (mapthing_t *) data;
     for (i = 0; i < numthings; i++, mt++)
     {
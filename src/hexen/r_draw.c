@@ -60,95 +60,19 @@ boolean BorderTopRefresh;
 =
 = Source is the top of the column to scale
 =
+= [JN] Column drawers are generated from the template in r_drawcol.h.
+= Some widescreen assets (like CMCEB0) are placed outside of screen
+= bounds, so with RANGECHECK such columns are skipped (COLCLIP)
+= instead of I_Error calling.
+=
 ================================================================================
 */
 
-void R_DrawColumn (void)
-{
-    int      count = dc_yh - dc_yl;
-    byte    *dest;
-    fixed_t  frac, fracstep;
-
-	// Zero length, column does not exceed a pixel.
-    if (count < 0)
-	{
-		return;
-	}
-
-#ifdef RANGECHECK
-    if ((unsigned)dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        // [JN] Some widescreen assets (like CMCEB0) are notably
-        // wider and placed outside of screen bounds farther than
-        // this condition is checking, which may lead to unnecessary
-        // I_Error calling. If no action is taken, an overflow may
-        // happen as well as drawing column from opposite side of
-        // the screen. Thus, instead of I_Error just dont draw such column.
-        return;
-    }
-#endif
-
-    // Framebuffer destination address.
-    // Use ylookup LUT to avoid multiply with ScreenWidth.
-    // Use columnofs LUT for subwindows?
-
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-
-    // Determine scaling, which is the only mapping to be done.
-
-    fracstep = dc_iscale;
-    frac = dc_texturemid + (dc_yl-centery)*fracstep;
-
-    // Inner loop that does the actual texture mapping,
-    // e.g. a DDA-lile scaling. This is as fast as it gets.
-    // [JN] killough 2/1/98: more performance tuning
-    {
-        const byte *source = dc_source;
-        const byte *brightmap = dc_brightmap;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight - 1;
-
-        if (dc_texheight & heightmask)   // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-
-            if (frac < 0)
-                while ((frac += heightmask) < 0);
-            else
-                while (frac >= heightmask)
-                       frac -= heightmask;
-
-            do
-            {
-                // Re-map color indices from wall texture column
-                //  using a lighting/special effects LUT.
-                // [JN] heightmask is the Tutti-Frutti fix -- killough
-                // [crispy] brightmaps
-                const byte src = source[frac>>FRACBITS];
-
-                *dest = colormap[brightmap[src]][src];
-                dest += screenwidth;
-                if ((frac += fracstep) >= heightmask)
-                {
-                    frac -= heightmask;
-                }
-            } while (count--);
-        }
-        else  // texture height is a power of 2 -- killough
-        {
-            do
-            {
-                // [crispy] brightmaps
-                const byte src = source[(frac>>FRACBITS)&heightmask];
-
-                *dest = colormap[brightmap[src]][src];
-                dest += screenwidth; 
-                frac += fracstep;
-            } while (count--); 
-        }
-    }
-}
+#define COLFUNC   R_DrawColumn
+#define COLWRAP   1
+#define COLBRIGHT 1
+#define COLCLIP   1
+#include "r_drawcol.h"
 
 /*
 ================================================================================
@@ -160,92 +84,12 @@ void R_DrawColumn (void)
 ================================================================================
 */
 
-void R_DrawColumnLow (void)
-{
-    int      x = dc_x << 1; // Blocky mode, need to multiply by 2.
-    int      count = dc_yh - dc_yl;
-    byte     *dest1, *dest2, *dest3, *dest4;
-    fixed_t   frac, fracstep;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK
-    if ((unsigned)dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        // [JN] Some widescreen assets (like CMCEB0) are notably
-        // wider and placed outside of screen bounds farther than
-        // this condition is checking, which may lead to unnecessary
-        // I_Error calling. If no action is taken, an overflow may
-        // happen as well as drawing column from opposite side of
-        // the screen. Thus, instead of I_Error just dont draw such column.
-        return;
-    }
-#endif
-
-    dest1 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
-    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x+1]];
-    dest3 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x]];
-    dest4 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x+1]];
-    fracstep = dc_iscale; 
-    frac = dc_texturemid + (dc_yl-centery) * fracstep;
-
-    // Inner loop that does the actual texture mapping, e.g. a DDA-lile scaling.
-    {
-        const byte *source = dc_source;
-        const byte *brightmap = dc_brightmap;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight - 1;
-
-        if (dc_texheight & heightmask)  // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-
-            if (frac < 0)
-                while ((frac += heightmask) < 0);
-            else
-                while (frac >= heightmask)
-                       frac -= heightmask;
-
-            do
-            {
-                // [crispy] brightmaps
-                const byte src = source[frac>>FRACBITS];
-                *dest4 = *dest3 = *dest2 = *dest1 = colormap[brightmap[src]][src];
-
-                dest1 += screenwidth << hires;
-                dest2 += screenwidth << hires;
-                dest3 += screenwidth << hires;
-                dest4 += screenwidth << hires;
-
-                if ((frac += dc_iscale) >= heightmask)
-                {
-                    frac -= heightmask;
-                }
-            } while (count--);
-        }
-        else  // texture height is a power of 2 -- killough
-        {
-            do 
-            {
-                // [crispy] brightmaps
-                const byte src = source[(frac>>FRACBITS)&heightmask];
-                *dest4 = *dest3 = *dest2 = *dest1 = colormap[brightmap[src]][src];
-
-                dest1 += screenwidth << hires;
-                dest2 += screenwidth << hires;
-                dest3 += screenwidth << hires;
-                dest4 += screenwidth << hires;
-
-                frac += fracstep; 
-
-            } while (count--);
-        }
-    }
-}
+#define COLFUNC   R_DrawColumnLow
+#define COLLOW    1
+#define COLWRAP   1
+#define COLBRIGHT 1
+#define COLCLIP   1
+#include "r_drawcol.h"
 
 /*
 ================================================================================
@@ -257,68 +101,11 @@ void R_DrawColumnLow (void)
 ================================================================================
 */
 
-void R_DrawTLColumn (void)
-{
-    int      count = dc_yh - dc_yl;
-    byte    *dest;
-    fixed_t  frac, fracstep;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK
-    if ((unsigned)dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        return;
-    }
-#endif
-
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-    frac = dc_texturemid + (dc_yl-centery)*dc_iscale;
-
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-    fracstep = dc_iscale; 
-    frac = dc_texturemid + (dc_yl - centery) * fracstep;
-
-    {
-        const byte *source = dc_source;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight - 1;
-
-        if (dc_texheight & heightmask)  // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-
-            if (frac < 0)
-                while ((frac += heightmask) < 0);
-            else
-                while (frac >= heightmask)
-                       frac -= heightmask;
-
-            do
-            {
-                *dest = tinttable[(*dest << 8) + colormap[0][source[frac >> FRACBITS]]];
-                dest += screenwidth;
-                if ((frac += fracstep) >= heightmask)
-                {
-                    frac -= heightmask;
-                }
-            } while (count--);
-        }
-        else  // texture height is a power of 2 -- killough
-        {
-            do
-            {
-                *dest = tinttable[(*dest << 8) + colormap[0][source[(frac >> FRACBITS) & heightmask]]];
-                dest += screenwidth;
-                frac += fracstep;
-            } while (count--);
-        }
-    }
-}
+#define COLFUNC   R_DrawTLColumn
+#define COLWRAP   1
+#define COLBLEND  tinttable
+#define COLCLIP   1
+#include "r_drawcol.h"
 
 
 /*
@@ -331,89 +118,12 @@ void R_DrawTLColumn (void)
 ================================================================================
 */
 
-void R_DrawTLColumnLow (void)
-{
-    const int x = dc_x << 1;  // Blocky mode, need to multiply by 2.
-    int       count = dc_yh - dc_yl;
-    byte     *dest1, *dest2, *dest3, *dest4;
-    fixed_t   frac, fracstep;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK
-    if ((unsigned)x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        return;
-    }
-#endif
-
-    dest1 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
-    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x + 1]];
-    dest3 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x]];
-    dest4 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x + 1]];
-    fracstep = dc_iscale; 
-    frac  = dc_texturemid + (dc_yl-centery)*fracstep;
-
-    {
-        const byte *source = dc_source;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight - 1;
-
-        if (dc_texheight & heightmask)  // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-
-            if (frac < 0)
-                while ((frac += heightmask) < 0);
-            else
-                while (frac >= heightmask)
-                       frac -= heightmask;
-
-            do
-            {
-                const byte src = source[frac >> FRACBITS];
-
-                *dest1 = tinttable[(*dest1 << 8) + colormap[0][src]];
-                *dest2 = tinttable[(*dest2 << 8) + colormap[0][src]];
-                *dest3 = tinttable[(*dest3 << 8) + colormap[0][src]];
-                *dest4 = tinttable[(*dest4 << 8) + colormap[0][src]];
-                dest1 += screenwidth << hires;
-                dest2 += screenwidth << hires;
-                dest3 += screenwidth << hires;
-                dest4 += screenwidth << hires;
-    
-                if ((frac += fracstep) >= heightmask)
-                {
-                    frac -= heightmask;
-                }
-            } while (count--);
-        }
-        else  // texture height is a power of 2 -- killough
-        {
-            do 
-            {
-                const byte src = source[(frac >> FRACBITS) & heightmask];
-
-                *dest1 = tinttable[(*dest1 << 8) +colormap[0][src]];
-                *dest2 = tinttable[(*dest2 << 8) +colormap[0][src]];
-                *dest3 = tinttable[(*dest3 << 8) +colormap[0][src]];
-                *dest4 = tinttable[(*dest4 << 8) +colormap[0][src]];
-    
-                dest1 += screenwidth << hires;
-                dest2 += screenwidth << hires;
-                dest3 += screenwidth << hires;
-                dest4 += screenwidth << hires;
-    
-                frac += fracstep; 
-
-            } while (count--);
-        }
-    }
-}
+#define COLFUNC   R_DrawTLColumnLow
+#define COLLOW    1
+#define COLWRAP   1
+#define COLBLEND  tinttable
+#define COLCLIP   1
+#include "r_drawcol.h"
 
 /*
 ================================================================================
@@ -589,70 +299,12 @@ void R_DrawAltTLColumnLow(void)
 ================================================================================
 */
 
-void R_DrawExtraTLColumn(void)
-{
-    int      count = dc_yh - dc_yl;
-    byte    *dest;
-    fixed_t  frac, fracstep;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK
-    if ((unsigned)dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        return;
-    }
-#endif
-
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-    fracstep = dc_iscale; 
-    frac = dc_texturemid + (dc_yl - centery) * fracstep;
-
-    {
-        const byte *source = dc_source;
-        const byte *brightmap = dc_brightmap;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight - 1;
-
-        if (dc_texheight & heightmask)  // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-
-            if (frac < 0)
-                while ((frac += heightmask) < 0);
-            else
-                while (frac >= heightmask)
-                       frac -= heightmask;
-
-            do
-            {
-                const byte src = source[frac >> FRACBITS];
-
-                *dest = transtable80[(*dest << 8) + colormap[brightmap[src]][src]];
-                dest += screenwidth;
-                if ((frac += fracstep) >= heightmask)
-                {
-                    frac -= heightmask;
-                }
-            } while (count--);
-        }
-        else  // texture height is a power of 2 -- killough
-        {
-            do
-            {
-                const byte src = source[(frac >> FRACBITS) & heightmask];
-                
-                *dest = transtable80[(*dest << 8) + colormap[brightmap[src]][src]];
-                dest += screenwidth;
-                frac += fracstep;
-            } while (count--);
-        }
-    }
-}
+#define COLFUNC   R_DrawExtraTLColumn
+#define COLWRAP   1
+#define COLBRIGHT 1
+#define COLBLEND  transtable80
+#define COLCLIP   1
+#include "r_drawcol.h"
 
 /*
 ================================================================================
@@ -664,91 +316,13 @@ void R_DrawExtraTLColumn(void)
 ================================================================================
 */
 
-void R_DrawExtraTLColumnLow (void)
-{
-    const int x = dc_x << 1;  // Blocky mode, need to multiply by 2.
-    int       count = dc_yh - dc_yl;
-    byte     *dest1, *dest2, *dest3, *dest4;
-    fixed_t   frac, fracstep;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK
-    if ((unsigned)x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        return;
-    }
-#endif
-
-    dest1 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
-    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x + 1]];
-    dest3 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x]];
-    dest4 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x + 1]];
-    fracstep = dc_iscale; 
-    frac  = dc_texturemid + (dc_yl-centery)*fracstep;
-
-    {
-        const byte *source = dc_source;
-        const byte *brightmap = dc_brightmap;
-        const lighttable_t *const *colormap = dc_colormap;
-        int heightmask = dc_texheight - 1;
-
-        if (dc_texheight & heightmask) // not a power of 2 -- killough
-        {
-            heightmask++;
-            heightmask <<= FRACBITS;
-
-            if (frac < 0)
-                while ((frac += heightmask) < 0);
-            else
-                while (frac >= heightmask)
-                       frac -= heightmask;
-
-            do
-            {
-                const byte src = source[frac >> FRACBITS];
-
-                *dest1 = transtable80[(*dest1 << 8) + colormap[brightmap[src]][src]];
-                *dest2 = transtable80[(*dest2 << 8) + colormap[brightmap[src]][src]];
-                *dest4 = transtable80[(*dest4 << 8) + colormap[brightmap[src]][src]];
-                *dest3 = transtable80[(*dest3 << 8) + colormap[brightmap[src]][src]];
-
-                dest1 += screenwidth << hires;
-                dest2 += screenwidth << hires;
-                dest3 += screenwidth << hires;
-                dest4 += screenwidth << hires;
-
-                if ((frac += fracstep) >= heightmask)
-                {
-                    frac -= heightmask;
-                }
-            } while (count--);
-        }
-        else // texture height is a power of 2 -- killough
-        {
-            do 
-            {
-                const byte src = source[(frac>>FRACBITS)&heightmask];
-
-                *dest1 = transtable80[(*dest1 << 8) + colormap[brightmap[src]][src]];
-                *dest2 = transtable80[(*dest2 << 8) + colormap[brightmap[src]][src]];
-                *dest3 = transtable80[(*dest3 << 8) + colormap[brightmap[src]][src]];
-                *dest4 = transtable80[(*dest4 << 8) + colormap[brightmap[src]][src]];
-
-                dest1 += screenwidth << hires;
-                dest2 += screenwidth << hires;
-                dest3 += screenwidth << hires;
-                dest4 += screenwidth << hires;
-
-                frac += fracstep; 
-
-            } while (count--);
-        }
-    }
-}
+#define COLFUNC   R_DrawExtraTLColumnLow
+#define COLLOW    1
+#define COLWRAP   1
+#define COLBRIGHT 1
+#define COLBLEND  transtable80
+#define COLCLIP   1
+#include "r_drawcol.h"
 
 /*
 ================================================================================
@@ -758,34 +332,10 @@ void R_DrawExtraTLColumnLow (void)
 ================================================================================
 */
 
-void R_DrawTranslatedColumn (void)
-{
-    int      count = dc_yh - dc_yl;
-    byte    *dest;
-    fixed_t  frac;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK
-    if ((unsigned) dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        return;
-    }
-#endif
-
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-    frac = dc_texturemid + (dc_yl-centery)*dc_iscale; 
-
-    do
-    {
-        *dest = dc_colormap[0][dc_translation[dc_source[frac >> FRACBITS]]];
-        dest += screenwidth;
-        frac += dc_iscale;
-    } while (count--);
-}
+#define COLFUNC   R_DrawTranslatedColumn
+#define COLTRANS  1
+#define COLCLIP   1
+#include "r_drawcol.h"
 
 
 /*
@@ -798,43 +348,11 @@ void R_DrawTranslatedColumn (void)
 ================================================================================
 */
 
-void R_DrawTranslatedColumnLow (void) 
-{ 
-    int      x = dc_x << 1;  // low detail, need to scale by 2
-    int      count = dc_yh - dc_yl; 
-    byte    *dest, *dest2, *dest3, *dest4;
-    fixed_t  frac; 
-
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK 
-    if ((unsigned)x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        return;
-    }
-#endif 
-
-    dest  = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
-    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x+1]];
-    dest3 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x]];
-    dest4 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x+1]];
-    frac = dc_texturemid + (dc_yl-centery)*dc_iscale; 
-
-    do 
-    {
-        *dest4 = *dest3 = *dest2 = *dest = dc_colormap[0][dc_translation[dc_source[frac>>FRACBITS]]];
-
-        dest += screenwidth << hires;
-        dest2 += screenwidth << hires;
-        dest3 += screenwidth << hires;
-        dest4 += screenwidth << hires;
-
-        frac += dc_iscale; 
-    } while (count--); 
-}
+#define COLFUNC   R_DrawTranslatedColumnLow
+#define COLLOW    1
+#define COLTRANS  1
+#define COLCLIP   1
+#include "r_drawcol.h"
 
 //============================================================================
 //
@@ -842,39 +360,11 @@ void R_DrawTranslatedColumnLow (void)
 //
 //============================================================================
 
-void R_DrawTranslatedTLColumn(void)
-{
-    int count;
-    byte *dest;
-    fixed_t frac, fracstep;
-
-    count = dc_yh - dc_yl;
-    if (count < 0)
-        return;
-
-#ifdef RANGECHECK
-    if ((unsigned) dc_x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        return;
-    }
-#endif
-
-    dest = ylookup[dc_yl] + columnofs[flipviewwidth[dc_x]];
-
-    fracstep = dc_iscale;
-    frac = dc_texturemid + (dc_yl - centery) * fracstep;
-
-    do
-    {
-        *dest = tinttable[((*dest) << 8)
-                          +
-                          dc_colormap[0][dc_translation
-                                      [dc_source[frac >> FRACBITS]]]];
-        dest += screenwidth;
-        frac += fracstep;
-    }
-    while (count--);
-}
+#define COLFUNC   R_DrawTranslatedTLColumn
+#define COLTRANS  1
+#define COLBLEND  tinttable
+#define COLCLIP   1
+#include "r_drawcol.h"
 
 
 /*
@@ -887,80 +377,13 @@ void R_DrawTranslatedTLColumn(void)
 ================================================================================
 */
 
-void R_DrawTranslatedTLColumnLow(void)
-{
-    int      x = dc_x << 1; // Blocky mode, need to multiply by 2.
-    int      count = dc_yh - dc_yl;
-    int      heightmask = dc_texheight - 1;
-    byte    *dest, *dest2, *dest3, *dest4;
-    fixed_t  frac;
-
-    if (count < 0)
-    {
-        return;
-    }
-
-#ifdef RANGECHECK
-    if ((unsigned)x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
-    {
-        return;
-    }
-#endif
-
-    dest  = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
-    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x+1]];
-    dest3 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x]];
-    dest4 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x+1]];
-    frac = dc_texturemid + (dc_yl-centery)*dc_iscale;
-
-    if (dc_texheight & heightmask)  // not a power of 2 -- killough
-    {
-        heightmask++;
-        heightmask <<= FRACBITS;
-
-        if (frac < 0)
-            while ((frac += heightmask) < 0);
-        else
-            while (frac >= heightmask)
-                   frac -= heightmask;
-
-        do
-        {
-            *dest = tinttable[(*dest<<8)+dc_colormap[0][dc_translation[dc_source[frac>>FRACBITS]]]];
-            *dest2 = tinttable[(*dest2<<8)+dc_colormap[0][dc_translation[dc_source[frac>>FRACBITS]]]];
-            *dest3 = tinttable[(*dest3<<8)+dc_colormap[0][dc_translation[dc_source[frac>>FRACBITS]]]];
-            *dest4 = tinttable[(*dest4<<8)+dc_colormap[0][dc_translation[dc_source[frac>>FRACBITS]]]];
-
-            dest += screenwidth << hires;
-            dest2 += screenwidth << hires;
-            dest3 += screenwidth << hires;
-            dest4 += screenwidth << hires;
-
-            if ((frac += dc_iscale) >= heightmask)
-            {
-                frac -= heightmask;
-            }
-        } while (count--);
-    }
-    else  // texture height is a power of 2 -- killough
-    {
-        do 
-        {
-            *dest = tinttable[(*dest<<8)+dc_colormap[0][dc_translation[dc_source[(frac>>FRACBITS)&heightmask]]]];
-            *dest2 = tinttable[(*dest2<<8)+dc_colormap[0][dc_translation[dc_source[(frac>>FRACBITS)&heightmask]]]];
-            *dest3 = tinttable[(*dest3<<8)+dc_colormap[0][dc_translation[dc_source[(frac>>FRACBITS)&heightmask]]]];
-            *dest4 = tinttable[(*dest4<<8)+dc_colormap[0][dc_translation[dc_source[(frac>>FRACBITS)&heightmask]]]];
-
-            dest += screenwidth << hires;
-            dest2 += screenwidth << hires;
-            dest3 += screenwidth << hires;
-            dest4 += screenwidth << hires;
-
-            frac += dc_iscale; 
-
-        } while (count--);
-    }
-}
+#define COLFUNC   R_DrawTranslatedTLColumnLow
+#define COLLOW    1
+#define COLWRAP   1
+#define COLTRANS  1
+#define COLBLEND  tinttable
+#define COLCLIP   1
+#include "r_drawcol.h"
 
 /*
 ================================================================================
@@ -213,6 +213,8 @@ typedef struct
     fixed_t dx, dy;             // [crispy] total poly movement this tic
     angle_t rtheta;             // [crispy] remaining poly rotation this tic
     angle_t dtheta;             // [crispy] total poly rotation this tic
+    fixed_t radius;             // farthest vertex from startSpot, roughly
+    fixed_t vertexbox[4];       // vertex bbox when last linked
 } polyobj_t;
 
 typedef struct polyblock_s
@@ -70,6 +70,11 @@ static visplane_t  *freetail;                  // [JN] killough
 static visplane_t **freehead = &freetail;      // [JN] killough
 visplane_t         *floorplane, *ceilingplane;
 
+// [JN] Visplanes used in current frame, in order of creation,
+// so they can be drawn and freed without walking all hash slots.
+static visplane_t **usedplanes;
+static int          numusedplanes, maxusedplanes;
+
 // [JN] killough -- hash function for visplanes
 // Empirically verified to be fairly uniform:
 
@@ -163,6 +168,7 @@ void R_InitVisplanesRes (void)
 {
     freetail = NULL;
     freehead = &freetail;
+    numusedplanes = 0;
 
     for (int i = 0; i < MAXVISPLANES; i++)
     {
@@ -306,9 +312,15 @@ void R_ClearPlanes (void)
         ceilingclip[i] = -1;
     }
 
-    for (i = 0; i < MAXVISPLANES; i++)
-        for (*freehead = visplanes[i], visplanes[i] = NULL; *freehead; )
-            freehead = &(*freehead)->next;
+    // Move used visplanes to the free list and empty the hash slots.
+    for (i = 0; i < numusedplanes; i++)
+    {
+        *freehead = usedplanes[i];
+        freehead = &usedplanes[i]->next;
+    }
+    *freehead = NULL;
+    numusedplanes = 0;
+    memset(visplanes, 0, sizeof(visplanes));
 
     lastopening = openings;
 
@@ -341,9 +353,37 @@ static visplane_t *new_visplane(unsigned int hash)
     }
     check->next = visplanes[hash];
     visplanes[hash] = check;
+
+    if (numusedplanes == maxusedplanes)
+    {
+        maxusedplanes = maxusedplanes ? maxusedplanes * 2 : 128;
+        usedplanes = I_Realloc(usedplanes, maxusedplanes * sizeof(*usedplanes));
+    }
+    usedplanes[numusedplanes++] = check;
+
     return check;
 }
 
+/*
+================================================================================
+=
+= R_ClearPlaneColumns
+=
+= [JN] Marks columns start...stop of the plane as empty. Top values are
+= only kept valid within [minx, maxx], so instead of clearing the whole
+= array for every new plane, only the columns its range grows by are.
+=
+================================================================================
+*/
+
+static void R_ClearPlaneColumns (visplane_t *pl, const int start, const int stop)
+{
+    if (start <= stop)
+    {
+        memset(pl->top + start, 0xff, (stop - start + 1) * sizeof(*pl->top));
+    }
+}
+
 /*
 ================================================================================
 =
@@ -381,8 +421,6 @@ visplane_t *R_FindPlane(fixed_t height, int picnum, int lightlevel, int special)
     check->minx = screenwidth;
     check->maxx = -1;
 
-    memset(check->top, 0xff, sizeof(check->top));
-
     return (check);
 }
 
@@ -405,10 +443,7 @@ visplane_t *R_DupPlane (const visplane_t *pl, int start, int stop)
     new_pl->minx = start;
     new_pl->maxx = stop;
 
-    for (int i = 0; i != screenwidth; i++)
-    {
-        new_pl->top[i] = SHRT_MAX;
-    }
+    R_ClearPlaneColumns(new_pl, start, stop);
 
     return new_pl;
 }
@@ -449,10 +484,19 @@ visplane_t *R_CheckPlane (visplane_t *pl, int start, int stop)
         intrh = stop;
     }
 
-    for (x=intrl ; x <= intrh && pl->top[x] == SHRT_MAX; x++); // [crispy] hires / 32-bit integer math
+    for (x=intrl ; x <= intrh && pl->top[x] == UINT_MAX; x++); // [crispy] hires / 32-bit integer math
     if (x > intrh)
     {
         // Can use existing plane; extend range
+        if (pl->minx > pl->maxx)
+        {
+            R_ClearPlaneColumns(pl, unionl, unionh);
+        }
+        else
+        {
+            R_ClearPlaneColumns(pl, unionl, pl->minx - 1);
+            R_ClearPlaneColumns(pl, pl->maxx + 1, unionh);
+        }
         pl->minx = unionl, pl->maxx = unionh;
         return pl;
     }
@@ -522,10 +566,11 @@ void R_DrawPlanes(void)
     extern byte *ylookup[MAXHEIGHT];
     extern int columnofs[MAXWIDTH];
 
-    for (i = 0 ; i < MAXVISPLANES ; i++)
-    for (pl = visplanes[i] ; pl ; pl = pl->next, rendered_visplanes++)
-    if (pl->minx <= pl->maxx)
+    for (i = 0 ; i < numusedplanes ; i++, rendered_visplanes++)
+    if (usedplanes[i]->minx <= usedplanes[i]->maxx)
     {
+        pl = usedplanes[i];
+
         //
         // Sky flat
         //
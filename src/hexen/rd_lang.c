@@ -52,6 +52,7 @@ char* txt_noplayers;
 //
 
 char* txt_gamesaved;
+char* txt_gamesavefailed;
 char* txt_gameloaded;
 char* txt_alwaysrun_on;
 char* txt_alwaysrun_off;
@@ -177,6 +178,7 @@ void RD_DefineLanguageStrings (void)
         //
 
         txt_gamesaved     = TXT_GAMESAVED;
+        txt_gamesavefailed = TXT_GAMESAVEFAILED;
         txt_gameloaded    = TXT_GAMELOADED;
         txt_alwaysrun_on  = TXT_ALWAYSRUN_ON;
         txt_alwaysrun_off = TXT_ALWAYSRUN_OFF;
@@ -296,6 +298,7 @@ void RD_DefineLanguageStrings (void)
         //
 
         txt_gamesaved     = TXT_GAMESAVED_RUS;
+        txt_gamesavefailed = TXT_GAMESAVEFAILED_RUS;
         txt_gameloaded    = TXT_GAMELOADED_RUS;
         txt_alwaysrun_on  = TXT_ALWAYSRUN_ON_RUS;
         txt_alwaysrun_off = TXT_ALWAYSRUN_OFF_RUS;
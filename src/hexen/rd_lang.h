@@ -50,6 +50,7 @@ extern char *txt_noplayers;
 //
 
 extern char *txt_gamesaved;
+extern char *txt_gamesavefailed;
 extern char* txt_gameloaded;
 extern char *txt_alwaysrun_on;
 extern char *txt_alwaysrun_off;
@@ -181,6 +182,7 @@ extern char *txt_running_script;
 //
 
 #define TXT_GAMESAVED               "GAME SAVED"
+#define TXT_GAMESAVEFAILED          "GAME NOT SAVED"
 #define TXT_GAMELOADED              "GAME LOADED"
 #define TXT_ALWAYSRUN_ON            "ALWAYS RUN ON"
 #define TXT_ALWAYSRUN_OFF           "ALWAYS RUN OFF"
@@ -352,6 +354,7 @@ extern char *txt_running_script;
 //
 
 #define TXT_GAMESAVED_RUS       "BUHF CJ[HFYTYF"                 // ИГРА СОХРАНЕНА
+#define TXT_GAMESAVEFAILED_RUS  "JIB,RF CJ[HFYTYBZ"              // ОШИБКА СОХРАНЕНИЯ
 #define TXT_GAMELOADED_RUS      "BUHF PFUHE;TYF"                 // ИГРА ЗАГРУЖЕНА
 #define TXT_ALWAYSRUN_ON_RUS    "GJCNJZYYSQ ,TU DRK.XTY"         // ПОСТОЯННЫЙ БЕГ ВКЛЮЧЕН
 #define TXT_ALWAYSRUN_OFF_RUS   "GJCNJZYYSQ ,TU DSRK.XTY"        // ПОСТОЯННЫЙ БЕГ ВЫКЛЮЧЕН
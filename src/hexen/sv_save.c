@@ -19,8 +19,12 @@
 
 // HEADER FILES ------------------------------------------------------------
 
+#include "SDL.h"
+#include "miniz.h"
+
 #include "h2def.h"
 #include "rd_io.h"
+#include "m_argv.h"
 #include "i_system.h"
 #include "m_misc.h"
 #include "i_swap.h"
@@ -88,6 +92,36 @@ typedef struct
     sector_t *sector;
 } ssthinker_t;
 
+// [JN] One archive (game header or map) kept in memory. Buffers never
+// change once stored, so slots share them by reference count instead
+// of copying files around.
+typedef struct
+{
+    int refCount;
+    int size;                   // Uncompressed size
+    int packedSize;             // Compressed size, 0 if stored as is
+    byte *data;
+} saveBuffer_t;
+
+typedef struct
+{
+    saveBuffer_t *game;
+    saveBuffer_t *maps[MAX_MAPS + 1];
+} saveSlot_t;
+
+// Files handed over to the save writer thread. They are written to
+// temporary files first, which replace the slot only if all are written.
+typedef struct
+{
+    int count;
+    char *fileNames[MAX_MAPS + 2];
+    saveBuffer_t *buffers[MAX_MAPS + 2];
+    int staleCount;
+    char *staleNames[MAX_MAPS + 1];  // Map files of the slot to remove
+    int failed;                 // Index of the file not written, or -1
+    SDL_atomic_t done;          // Set by the thread when it is finished
+} saveJob_t;
+
 // EXTERNAL FUNCTION PROTOTYPES --------------------------------------------
 
 void P_SpawnPlayer(mapthing_t * mthing);
@@ -124,11 +158,17 @@ static void RestorePlatRaise(thinker_t *thinker);
 static void RestoreMoveCeiling(thinker_t *thinker);
 static void AssertSegment(gameArchiveSegment_t segType);
 static void CopySaveSlot(int sourceSlot, int destSlot);
-static void CopyFile(char *sourceName, char *destName);
-static boolean ExistingFile(char *name);
-static void SV_OpenRead(char *fileName);
-static void SV_OpenWrite(char *fileName);
-static void SV_Close(void);
+static saveSlot_t *MemorySlot(int slot);
+static void ClearMemorySlot(saveSlot_t *slot);
+static void ReadSaveSlot(int slot, saveSlot_t *dest);
+static void WriteSaveSlot(saveSlot_t *source, int slot);
+static saveBuffer_t *StoreSaveBuffer(const byte *data, int size);
+static void ReleaseSaveBuffer(saveBuffer_t **buffer);
+static void StoreMapBuffer(saveSlot_t *slot, int map, saveBuffer_t *buffer);
+static boolean UnpackSaveBuffer(const saveBuffer_t *buffer, byte *dest);
+static void SV_OpenRead(const saveBuffer_t *buffer);
+static void SV_OpenWrite(void);
+static saveBuffer_t *SV_CloseWrite(void);
 static void SV_Read(void *buffer, int size);
 static byte SV_ReadByte(void);
 static uint16_t SV_ReadWord(void);
@@ -157,7 +197,23 @@ static mobj_t **MobjList;
 static mobj_t ***TargetPlayerAddrs;
 static int TargetPlayerCount;
 static boolean SavingPlayers;
-static FILE *SavingFP;
+
+// [JN] Base and reborn slots live in memory only, numbered slots are
+// written to disk on explicit save.
+static saveSlot_t BaseSlot;
+static saveSlot_t RebornSlot;
+static int PackSaveBuffers = -1;
+
+// Archive being written, or unpacked copy of the one being read
+static byte *SaveBuffer;
+static int SaveBufferSize;
+static const byte *SaveReadData;
+static int SaveReadSize;
+static int SavePos;
+
+static SDL_Thread *SaveThread;
+static saveJob_t SaveJob;
+static boolean SaveAtExit;
 
 // CODE --------------------------------------------------------------------
 
@@ -1966,13 +2022,11 @@ static void StreamOut_floorWaggle_t(thinker_t *thinker)
 
 void SV_SaveGame(int slot, char *description)
 {
-    char fileName[RD_MAX_PATH];
     char versionText[HXS_VERSION_TEXT_LENGTH];
     unsigned int i;
 
-    // Open the output file
-    M_snprintf(fileName, sizeof(fileName), "%shexen-save-7.sav", SavePath);
-    SV_OpenWrite(fileName);
+    // Open the output buffer
+    SV_OpenWrite();
 
     // Write game save description
     SV_Write(description, HXS_DESCRIPTION_LENGTH);
@@ -2005,14 +2059,19 @@ void SV_SaveGame(int slot, char *description)
     // Place a termination marker
     SV_WriteLong(ASEG_END);
 
-    // Close the output file
-    SV_Close();
+    // Store the game header in the base slot
+    ReleaseSaveBuffer(&BaseSlot.game);
+    BaseSlot.game = SV_CloseWrite();
 
     // Save out the current map
     SV_SaveMap(true);           // true = save player info
 
-    // Clear all save files at destination slot
-    SV_ClearSaveSlot(slot);
+    // Clear all save files at destination slot. The files of a numbered
+    // slot are only replaced once the new ones are written.
+    if (MemorySlot(slot) != NULL)
+    {
+        SV_ClearSaveSlot(slot);
+    }
 
     // Copy base slot to destination slot
     CopySaveSlot(BASE_SLOT, slot);
@@ -2026,13 +2085,10 @@ void SV_SaveGame(int slot, char *description)
 
 void SV_SaveMap(boolean savePlayers)
 {
-    char fileName[RD_MAX_PATH];
-
     SavingPlayers = savePlayers;
 
-    // Open the output file
-    M_snprintf(fileName, sizeof(fileName), "%shexen-save-7%02d.sav", SavePath, gamemap);
-    SV_OpenWrite(fileName);
+    // Open the output buffer
+    SV_OpenWrite();
 
     // Place a header marker
     SV_WriteLong(ASEG_MAP_HEADER);
@@ -2055,8 +2111,8 @@ void SV_SaveMap(boolean savePlayers)
     // Place a termination marker
     SV_WriteLong(ASEG_END);
 
-    // Close the output file
-    SV_Close();
+    // Store the map in the base slot
+    StoreMapBuffer(&BaseSlot, gamemap, SV_CloseWrite());
 }
 
 //==========================================================================
@@ -2068,7 +2124,6 @@ void SV_SaveMap(boolean savePlayers)
 void SV_LoadGame(int slot)
 {
     int i;
-    char fileName[RD_MAX_PATH];
     char version_text[HXS_VERSION_TEXT_LENGTH];
     player_t playerBackup[MAXPLAYERS];
     mobj_t *mobj;
@@ -2080,14 +2135,19 @@ void SV_LoadGame(int slot)
         CopySaveSlot(slot, BASE_SLOT);
     }
 
-    // Create the name
-    M_snprintf(fileName, sizeof(fileName), "%shexen-save-7.sav", SavePath);
+    if (BaseSlot.game == NULL)
+    {
+        I_Error(english_language ?
+                "Could not load savegame %shexen-save-%d.sav" :
+                "Невозможно прочитать файл %shexen-save-%d.sav",
+                SavePath, slot);
+    }
 
-    // Load the file
-    SV_OpenRead(fileName);
+    // Load the game header
+    SV_OpenRead(BaseSlot.game);
 
     // Set the save pointer and skip the description field
-    fseek(SavingFP, HXS_DESCRIPTION_LENGTH, SEEK_CUR);
+    SavePos += HXS_DESCRIPTION_LENGTH;
 
     // Check the version text
 
@@ -2129,8 +2189,6 @@ void SV_LoadGame(int slot)
         playerBackup[i] = players[i];
     }
 
-    SV_Close();
-
     // Load the current map
     SV_LoadMap();
 
@@ -2196,7 +2254,6 @@ void SV_MapTeleport(int map, int position)
 {
     int i;
     int j;
-    char fileName[RD_MAX_PATH];
     player_t playerBackup[MAXPLAYERS];
     mobj_t *targetPlayerMobj;
     mobj_t *mobj;
@@ -2238,8 +2295,7 @@ void SV_MapTeleport(int map, int position)
     TargetPlayerAddrs = NULL;
 
     gamemap = map;
-    M_snprintf(fileName, sizeof(fileName), "%shexen-save-7%02d.sav", SavePath, gamemap);
-    if (!deathmatch && ExistingFile(fileName))
+    if (!deathmatch && BaseSlot.maps[gamemap] != NULL)
     {                           // Unarchive map
         SV_LoadMap();
     }
@@ -2386,10 +2442,7 @@ int SV_GetRebornSlot(void)
 
 boolean SV_RebornSlotAvailable(void)
 {
-    char fileName[RD_MAX_PATH];
-
-    M_snprintf(fileName, sizeof(fileName), "%shexen-save-%d.sav", SavePath, REBORN_SLOT);
-    return ExistingFile(fileName);
+    return RebornSlot.game != NULL;
 }
 
 //==========================================================================
@@ -2400,19 +2453,22 @@ boolean SV_RebornSlotAvailable(void)
 
 void SV_LoadMap(void)
 {
-    char fileName[RD_MAX_PATH];
-
     // Load a base level
     G_InitNew(gameskill, gameepisode, gamemap);
 
     // Remove all thinkers
     RemoveAllThinkers();
 
-    // Create the name
-    M_snprintf(fileName, sizeof(fileName), "%shexen-save-7%02d.sav", SavePath, gamemap);
+    if (BaseSlot.maps[gamemap] == NULL)
+    {
+        I_Error(english_language ?
+                "SV_LoadMap: map %d is not in the base slot" :
+                "SV_LoadMap: уровень %d отсутствует в базовом слоте",
+                gamemap);
+    }
 
-    // Load the file
-    SV_OpenRead(fileName);
+    // Load the map
+    SV_OpenRead(BaseSlot.maps[gamemap]);
 
     AssertSegment(ASEG_MAP_HEADER);
 
@@ -2432,9 +2488,8 @@ void SV_LoadMap(void)
 
     AssertSegment(ASEG_END);
 
-    // Free mobj list and save buffer
+    // Free mobj list
     Z_Free(MobjList);
-    SV_Close();
 }
 
 //==========================================================================
@@ -2603,6 +2658,9 @@ static void UnarchiveWorld(void)
             si->midtexture = SV_ReadWord();
         }
     }
+
+    // [JN] sector tags are restored too
+    P_InitTagLists();
 }
 
 //==========================================================================
@@ -3322,6 +3380,16 @@ void SV_ClearSaveSlot(int slot)
 {
     int i;
     char fileName[RD_MAX_PATH];
+    saveSlot_t *memSlot;
+
+    if ((memSlot = MemorySlot(slot)) != NULL)
+    {
+        ClearMemorySlot(memSlot);
+        return;
+    }
+
+    // Don't let a pending write recreate the files afterwards
+    SV_FinishSaveWrite();
 
     for (i = 0; i < MAX_MAPS + 1; i++)
     {
@@ -3339,148 +3407,473 @@ void SV_ClearSaveSlot(int slot)
     }
 }
 
+//==========================================================================
+//
+// FinishSaveWrite
+//
+// Waits until the save files handed to the writer thread are on disk.
+// A failure is reported to the player and in the console, the previous
+// save of the slot is left as it was.
+//
+//==========================================================================
+
+static void FinishSaveWrite(boolean atExit)
+{
+    int i;
+    int failed;
+    char fileName[RD_MAX_PATH];
+
+    if (SaveJob.count == 0)
+    {
+        return;
+    }
+    if (SaveThread != NULL)
+    {
+        SDL_WaitThread(SaveThread, NULL);
+        SaveThread = NULL;
+    }
+
+    failed = SaveJob.failed;
+    if (failed >= 0)
+    {
+        M_StringCopy(fileName, SaveJob.fileNames[failed], sizeof(fileName));
+    }
+    for (i = 0; i < SaveJob.count; i++)
+    {
+        free(SaveJob.fileNames[i]);
+        ReleaseSaveBuffer(&SaveJob.buffers[i]);
+    }
+    SaveJob.count = 0;
+    for (i = 0; i < SaveJob.staleCount; i++)
+    {
+        free(SaveJob.staleNames[i]);
+    }
+    SaveJob.staleCount = 0;
+
+    if (failed < 0)
+    {
+        return;
+    }
+    printf(english_language ?
+           "Couldn't write to file %s\n" :
+           "Невозможно записать файл %s\n",
+           fileName);
+    if (!atExit)
+    {
+        P_SetMessage(&players[consoleplayer], txt_gamesavefailed,
+                     msg_system, false);
+    }
+}
+
+//==========================================================================
+//
+// SV_FinishSaveWrite
+//
+//==========================================================================
+
+void SV_FinishSaveWrite(void)
+{
+    FinishSaveWrite(false);
+}
+
+static void FinishSaveWriteAtExit(void)
+{
+    FinishSaveWrite(true);
+}
+
+//==========================================================================
+//
+// SV_CheckSaveWrite
+//
+// Called every frame, finishes the save write as soon as it is done.
+//
+//==========================================================================
+
+void SV_CheckSaveWrite(void)
+{
+    if (SaveJob.count != 0 && SDL_AtomicGet(&SaveJob.done))
+    {
+        FinishSaveWrite(false);
+    }
+}
+
 //==========================================================================
 //
 // CopySaveSlot
 //
-// Copies all the save game files from one slot to another.
+// Copies all the save game files from one slot to another. Memory slots
+// only share the buffers, disk slots are read at once and written by
+// the save writer thread.
 //
 //==========================================================================
 
 static void CopySaveSlot(int sourceSlot, int destSlot)
 {
+    saveSlot_t *source;
+    saveSlot_t *dest;
+    saveSlot_t temp;
     int i;
-    char sourceName[RD_MAX_PATH];
-    char destName[RD_MAX_PATH];
 
-    for (i = 0; i < MAX_MAPS; i++)
+    source = MemorySlot(sourceSlot);
+    dest = MemorySlot(destSlot);
+
+    if (source == NULL)
     {
-        M_snprintf(sourceName, sizeof(sourceName),
-                   "%shexen-save-%d%02d.sav", SavePath, sourceSlot, i);
-        if (ExistingFile(sourceName))
+        memset(&temp, 0, sizeof(temp));
+        ReadSaveSlot(sourceSlot, &temp);
+        source = &temp;
+    }
+
+    if (dest != NULL)
+    {
+        if (source->game != NULL)
+        {
+            source->game->refCount++;
+            ReleaseSaveBuffer(&dest->game);
+            dest->game = source->game;
+        }
+        for (i = 0; i < MAX_MAPS + 1; i++)
         {
-            M_snprintf(destName, sizeof(destName),
-                       "%shexen-save-%d%02d.sav", SavePath, destSlot, i);
-            CopyFile(sourceName, destName);
+            if (source->maps[i] != NULL)
+            {
+                source->maps[i]->refCount++;
+                StoreMapBuffer(dest, i, source->maps[i]);
+            }
         }
     }
-    M_snprintf(sourceName, sizeof(sourceName),
-               "%shexen-save-%d.sav", SavePath, sourceSlot);
-    if (ExistingFile(sourceName))
+    else
     {
-        M_snprintf(destName, sizeof(destName),
-                   "%shexen-save-%d.sav", SavePath, destSlot);
-        CopyFile(sourceName, destName);
+        WriteSaveSlot(source, destSlot);
+    }
+
+    if (source == &temp)
+    {
+        ClearMemorySlot(&temp);
     }
 }
 
 //==========================================================================
 //
-// CopyFile
+// MemorySlot
+//
+// Returns the in-memory slot for a slot number, or NULL if the slot is
+// kept on disk.
 //
-// This function was rewritten to copy files with minimal strain on zone
-// allocation and allow for big maps that technically work in vanilla to
-// save without error.
 //==========================================================================
 
-static void CopyFile(char *source_name, char *dest_name)
+static saveSlot_t *MemorySlot(int slot)
 {
-    const int BUFFER_CHUNK_SIZE = 0x10000;
+    switch (slot)
+    {
+        case BASE_SLOT:
+            return &BaseSlot;
+        case REBORN_SLOT:
+            return &RebornSlot;
+        default:
+            return NULL;
+    }
+}
 
-    byte *buffer;
-    int /*file_length,*/ file_remaining;
-    FILE *read_handle, *write_handle;
-    int buf_count, read_count, write_count;
+static void ClearMemorySlot(saveSlot_t *slot)
+{
+    int i;
 
-    read_handle = fopen(source_name, "rb");
-    if (read_handle == NULL)
+    ReleaseSaveBuffer(&slot->game);
+    for (i = 0; i < MAX_MAPS + 1; i++)
     {
-        I_Error (english_language ?
-                 "Could not load savegame %s" :
-                 "Невозможно прочитать файл %s",
-                 source_name);
+        ReleaseSaveBuffer(&slot->maps[i]);
     }
-    /*file_length = */file_remaining = M_FileLength(read_handle);
+}
 
-    // Vanilla savegame emulation.
-    //
-    // CopyFile() typically calls M_ReadFile() which stores the entire file
-    // in memory: Chocolate Hexen should force an allocation error here
-    // whenever it's appropriate.
+//==========================================================================
+//
+// ReadSaveSlot
+//
+// Loads the save game files of a disk slot into memory.
+//
+//==========================================================================
+
+static saveBuffer_t *ReadSaveFile(char *fileName)
+{
+    FILE *fp;
+    int length;
 
-    // [JN] Лимит сохранения отключен
-    /*
-    if (vanilla_savegame_limit)
+    fp = fopen(fileName, "rb");
+    if (fp == NULL)
     {
-        buffer = Z_Malloc(file_length, PU_STATIC, NULL);
-        Z_Free(buffer);
+        return NULL;
     }
-    */
 
-    write_handle = fopen(dest_name, "wb");
-    if (write_handle == NULL)
+    length = M_FileLength(fp);
+    if (length > SaveBufferSize)
+    {
+        SaveBufferSize = length;
+        SaveBuffer = I_Realloc(SaveBuffer, SaveBufferSize);
+    }
+    if (fread(SaveBuffer, 1, length, fp) != (size_t) length)
     {
         I_Error (english_language ?
                  "Couldn't read file %s" :
                  "Невозможно прочитать файл %s",
-                 dest_name);
+                 fileName);
     }
+    fclose(fp);
+
+    return StoreSaveBuffer(SaveBuffer, length);
+}
+
+static void ReadSaveSlot(int slot, saveSlot_t *dest)
+{
+    int i;
+    char fileName[RD_MAX_PATH];
 
-    buffer = Z_Malloc (BUFFER_CHUNK_SIZE, PU_STATIC, NULL);
+    // The files may still be in the writer's hands
+    SV_FinishSaveWrite();
 
-    do
+    for (i = 0; i < MAX_MAPS + 1; i++)
     {
-        buf_count = BUFFER_CHUNK_SIZE;
-        if( file_remaining < BUFFER_CHUNK_SIZE)
+        M_snprintf(fileName, sizeof(fileName),
+                   "%shexen-save-%d%02d.sav", SavePath, slot, i);
+        StoreMapBuffer(dest, i, ReadSaveFile(fileName));
+    }
+    M_snprintf(fileName, sizeof(fileName),
+               "%shexen-save-%d.sav", SavePath, slot);
+    ReleaseSaveBuffer(&dest->game);
+    dest->game = ReadSaveFile(fileName);
+}
+
+//==========================================================================
+//
+// WriteSaveSlot
+//
+// Hands the contents of a memory slot over to the save writer thread.
+// The job holds its own references, so the slot may change meanwhile.
+//
+//==========================================================================
+
+static int SaveWriterThread(void *unused)
+{
+    int i;
+    FILE *fp;
+    byte *unpacked;
+    const byte *data;
+    boolean ok;
+    saveBuffer_t *buffer;
+    char tempName[RD_MAX_PATH];
+
+    for (i = 0; i < SaveJob.count; i++)
+    {
+        M_snprintf(tempName, sizeof(tempName), "%s.tmp", SaveJob.fileNames[i]);
+        buffer = SaveJob.buffers[i];
+        unpacked = NULL;
+        data = buffer->data;
+
+        if (buffer->packedSize)
         {
-            buf_count = file_remaining;
+            unpacked = malloc(buffer->size);
+            if (unpacked == NULL || !UnpackSaveBuffer(buffer, unpacked))
+            {
+                free(unpacked);
+                SaveJob.failed = i;
+                break;
+            }
+            data = unpacked;
         }
 
-        read_count = fread(buffer, 1, buf_count, read_handle);
-        if (read_count < buf_count)
+        fp = fopen(tempName, "wb");
+        ok = fp != NULL
+          && fwrite(data, 1, buffer->size, fp) == (size_t) buffer->size;
+        if (fp != NULL && fclose(fp) != 0)
         {
-            I_Error (english_language ?
-                     "Couldn't read file %s" :
-                     "Невозможно прочитать файл %s",
-                     source_name);
+            ok = false;
         }
+        free(unpacked);
 
-        write_count = fwrite(buffer, 1, buf_count, write_handle);
-        if (write_count < buf_count)
+        if (!ok)
         {
-            I_Error (english_language ?
-                     "Couldn't write to file %s" :
-                     "Невозможно записать файл %s",
-                     dest_name);
+            SaveJob.failed = i;
+            break;
         }
+    }
 
-        file_remaining -= buf_count;
-    } while (file_remaining > 0);
+    if (SaveJob.failed >= 0)
+    {
+        // Leave the previous save alone
+        for (i = 0; i <= SaveJob.failed; i++)
+        {
+            M_snprintf(tempName, sizeof(tempName), "%s.tmp", SaveJob.fileNames[i]);
+            remove(tempName);
+        }
+    }
+    else
+    {
+        // The description file comes last, after the maps of the old
+        // save which are not in the new one are gone
+        for (i = 0; i < SaveJob.count; i++)
+        {
+            if (i == SaveJob.count - 1 && SaveJob.failed < 0)
+            {
+                int j;
+
+                for (j = 0; j < SaveJob.staleCount; j++)
+                {
+                    remove(SaveJob.staleNames[j]);
+                }
+            }
+            M_snprintf(tempName, sizeof(tempName), "%s.tmp", SaveJob.fileNames[i]);
+            if (SaveJob.failed >= 0)
+            {
+                remove(tempName);
+                continue;
+            }
+            remove(SaveJob.fileNames[i]);
+            if (rename(tempName, SaveJob.fileNames[i]) != 0)
+            {
+                remove(tempName);
+                SaveJob.failed = i;
+            }
+        }
+    }
 
-    Z_Free(buffer);
-    fclose(read_handle);
-    fclose(write_handle);
+    SDL_AtomicSet(&SaveJob.done, 1);
+    return 0;
+}
+
+static void WriteSaveSlot(saveSlot_t *source, int slot)
+{
+    int i;
+    char fileName[RD_MAX_PATH];
+
+    SV_FinishSaveWrite();
+
+    SaveJob.failed = -1;
+    SDL_AtomicSet(&SaveJob.done, 0);
+    for (i = 0; i < MAX_MAPS + 1; i++)
+    {
+        M_snprintf(fileName, sizeof(fileName),
+                   "%shexen-save-%d%02d.sav", SavePath, slot, i);
+        if (source->maps[i] != NULL)
+        {
+            SaveJob.fileNames[SaveJob.count] = M_StringDuplicate(fileName);
+            SaveJob.buffers[SaveJob.count] = source->maps[i];
+            source->maps[i]->refCount++;
+            SaveJob.count++;
+        }
+        else if (M_FileExists(fileName))
+        {
+            SaveJob.staleNames[SaveJob.staleCount++] = M_StringDuplicate(fileName);
+        }
+    }
+
+    // Written last, so the menu never sees a description without maps
+    if (source->game != NULL)
+    {
+        M_snprintf(fileName, sizeof(fileName),
+                   "%shexen-save-%d.sav", SavePath, slot);
+        SaveJob.fileNames[SaveJob.count] = M_StringDuplicate(fileName);
+        SaveJob.buffers[SaveJob.count] = source->game;
+        source->game->refCount++;
+        SaveJob.count++;
+    }
+
+    if (SaveJob.count == 0)
+    {
+        for (i = 0; i < SaveJob.staleCount; i++)
+        {
+            free(SaveJob.staleNames[i]);
+        }
+        SaveJob.staleCount = 0;
+        return;
+    }
+
+    if (!SaveAtExit)
+    {
+        I_AtExit(FinishSaveWriteAtExit, true);
+        SaveAtExit = true;
+    }
+
+    SaveThread = SDL_CreateThread(SaveWriterThread, "Save writer thread", NULL);
+    if (SaveThread == NULL)
+    {
+        // No thread, write the files right now. They are finished on
+        // the next frame, as any other write.
+        SaveWriterThread(NULL);
+    }
 }
 
 //==========================================================================
 //
-// ExistingFile
+// StoreSaveBuffer
+//
+// Makes a stored copy of an archive, compressed with -hubcompress.
 //
 //==========================================================================
 
-static boolean ExistingFile(char *name)
+static saveBuffer_t *StoreSaveBuffer(const byte *data, int size)
 {
-    FILE *fp;
+    saveBuffer_t *buffer;
+    mz_ulong packedSize;
 
-    if ((fp = fopen(name, "rb")) != NULL)
+    if (PackSaveBuffers < 0)
     {
-        fclose(fp);
-        return true;
+        //!
+        // Keep visited hub maps compressed in memory. Uses less memory
+        // at the cost of some time on every map change.
+        //
+
+        PackSaveBuffers = M_ParmExists("-hubcompress");
     }
-    else
+
+    buffer = I_Realloc(NULL, sizeof(*buffer));
+    buffer->refCount = 1;
+    buffer->size = size;
+    buffer->packedSize = 0;
+
+    if (PackSaveBuffers)
+    {
+        packedSize = mz_compressBound(size);
+        buffer->data = I_Realloc(NULL, packedSize);
+        if (mz_compress2(buffer->data, &packedSize, data, size,
+                         MZ_BEST_SPEED) == MZ_OK && packedSize < size)
+        {
+            buffer->packedSize = packedSize;
+            buffer->data = I_Realloc(buffer->data, packedSize);
+            return buffer;
+        }
+        free(buffer->data);
+    }
+
+    buffer->data = I_Realloc(NULL, size);
+    memcpy(buffer->data, data, size);
+    return buffer;
+}
+
+static void ReleaseSaveBuffer(saveBuffer_t **buffer)
+{
+    if (*buffer != NULL && --(*buffer)->refCount == 0)
     {
-        return false;
+        free((*buffer)->data);
+        free(*buffer);
     }
+    *buffer = NULL;
+}
+
+static void StoreMapBuffer(saveSlot_t *slot, int map, saveBuffer_t *buffer)
+{
+    if (buffer != NULL)
+    {
+        ReleaseSaveBuffer(&slot->maps[map]);
+        slot->maps[map] = buffer;
+    }
+}
+
+static boolean UnpackSaveBuffer(const saveBuffer_t *buffer, byte *dest)
+{
+    mz_ulong size = buffer->size;
+
+    return mz_uncompress(dest, &size, buffer->data,
+                         buffer->packedSize) == MZ_OK
+        && size == buffer->size;
 }
 
 //==========================================================================
@@ -3489,28 +3882,47 @@ static boolean ExistingFile(char *name)
 //
 //==========================================================================
 
-static void SV_OpenRead(char *fileName)
+static void SV_OpenRead(const saveBuffer_t *buffer)
 {
-    SavingFP = fopen(fileName, "rb");
+    SavePos = 0;
+    SaveReadSize = buffer->size;
+
+    if (buffer->packedSize == 0)
+    {
+        SaveReadData = buffer->data;
+        return;
+    }
+
+    if (buffer->size > SaveBufferSize)
+    {
+        SaveBufferSize = buffer->size;
+        SaveBuffer = I_Realloc(SaveBuffer, SaveBufferSize);
+    }
+    if (!UnpackSaveBuffer(buffer, SaveBuffer))
+    {
+        I_Error(english_language ?
+                "Corrupt save game: failed to unpack the map" :
+                "Поврежденный файл сохранения: не удалось распаковать уровень");
+    }
+    SaveReadData = SaveBuffer;
 }
 
-static void SV_OpenWrite(char *fileName)
+static void SV_OpenWrite(void)
 {
-    SavingFP = fopen(fileName, "wb");
+    SavePos = 0;
 }
 
 //==========================================================================
 //
-// SV_Close
+// SV_CloseWrite
+//
+// Returns the written archive as a new buffer.
 //
 //==========================================================================
 
-static void SV_Close(void)
+static saveBuffer_t *SV_CloseWrite(void)
 {
-    if (SavingFP)
-    {
-        fclose(SavingFP);
-    }
+    return StoreSaveBuffer(SaveBuffer, SavePos);
 }
 
 //==========================================================================
@@ -3521,14 +3933,17 @@ static void SV_Close(void)
 
 static void SV_Read(void *buffer, int size)
 {
-    int retval = fread(buffer, 1, size, SavingFP);
-    if (retval != size)
+    int retval = SaveReadSize - SavePos;
+
+    if (retval < size)
     {
         I_Error(english_language ?
                 "Incomplete read in SV_Read: Expected %d, got %d bytes" :
                 "Ошибка чтения в SV_Read: ожидаемо '%d', получено '%d' байт",
-                size, retval);
+                size, retval < 0 ? 0 : retval);
     }
+    memcpy(buffer, SaveReadData + SavePos, size);
+    SavePos += size;
 }
 
 static byte SV_ReadByte(void)
@@ -3572,24 +3987,31 @@ static void *SV_ReadPtr(void)
 
 static void SV_Write(void *buffer, int size)
 {
-    fwrite(buffer, size, 1, SavingFP);
+    if (SavePos + size > SaveBufferSize)
+    {
+        SaveBufferSize = SaveBufferSize * 2 > SavePos + size ?
+                         SaveBufferSize * 2 : SavePos + size;
+        SaveBuffer = I_Realloc(SaveBuffer, SaveBufferSize);
+    }
+    memcpy(SaveBuffer + SavePos, buffer, size);
+    SavePos += size;
 }
 
 static void SV_WriteByte(byte val)
 {
-    fwrite(&val, sizeof(byte), 1, SavingFP);
+    SV_Write(&val, sizeof(byte));
 }
 
 static void SV_WriteWord(unsigned short val)
 {
     val = SHORT(val);
-    fwrite(&val, sizeof(unsigned short), 1, SavingFP);
+    SV_Write(&val, sizeof(unsigned short));
 }
 
 static void SV_WriteLong(unsigned int val)
 {
     val = LONG(val);
-    fwrite(&val, sizeof(int), 1, SavingFP);
+    SV_Write(&val, sizeof(int));
 }
 
 static void SV_WriteLongLong(int64_t val)
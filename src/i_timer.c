@@ -78,6 +78,18 @@ uint64_t I_GetTimeUS(void)
     return ((counter - basecounter) * 1000000ull) / basefreq;
 }
 
+// [JN] Raw high resolution counter, for profiling
+
+uint64_t I_GetPerfCounter (void)
+{
+    return SDL_GetPerformanceCounter();
+}
+
+uint64_t I_GetPerfFrequency (void)
+{
+    return basefreq;
+}
+
 // Sleep for a specified number of ms
 
 void I_Sleep(int ms)
@@ -36,6 +36,10 @@ int I_GetTimeMS (void);
 // returns current time in us
 uint64_t I_GetTimeUS(void); // [crispy]
 
+// [JN] Raw high resolution counter, and its ticks per second.
+uint64_t I_GetPerfCounter (void);
+uint64_t I_GetPerfFrequency (void);
+
 // Pause for a specified number of ms
 void I_Sleep(int ms);
 
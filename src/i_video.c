@@ -46,6 +46,7 @@
 #include "m_misc.h"
 #include "tables.h"
 #include "v_diskicon.h"
+#include "v_trans.h"
 #include "v_video.h"
 #include "w_wad.h"
 #include "z_zone.h"
@@ -69,19 +70,15 @@ static const char *window_title = "";
 // load the RGBA buffer to and that we render into another texture (4) which
 // is upscaled by an integer factor UPSCALE using "nearest" scaling and which
 // in turn is finally rendered to screen using "linear" scaling.
+// [JN] Normally (1) is expanded right into the locked texture (3),
+// and (2) is used only if that can't be done or with -oldblit.
+// Only rows changed since the last presented frame are copied.
 
 static SDL_Surface *screenbuffer = NULL;
 static SDL_Surface *argbbuffer = NULL;
 static SDL_Texture *texture = NULL;
 static SDL_Texture *texture_upscaled = NULL;
 
-static SDL_Rect blit_rect = {
-    0,
-    0,
-    MAXWIDTH,
-    MAXHEIGHT
-};
-
 static uint32_t pixel_format;
 
 // palette
@@ -89,6 +86,48 @@ static uint32_t pixel_format;
 static SDL_Color palette[256];
 static boolean palette_to_set;
 
+// [JN] Palette in the pixel format of the texture. The paletted screen
+// buffer is expanded through it straight into the locked texture,
+// skipping the intermediate RGBA surface.
+
+static uint32_t palette_lut[256];
+static SDL_PixelFormat *palette_lut_format = NULL;
+
+// [JN] Blit options: the old SDL_BlitSurface path, amount of threads
+// to expand the rows and the average blit time printed at exit.
+
+#define MAXBLITTHREADS 8
+
+typedef struct
+{
+    SDL_Thread *thread;
+    SDL_sem    *start, *done;
+    int         y1, y2;
+} blitworker_t;
+
+static boolean      oldblit;
+static boolean      blitstats;
+static int          numblitworkers;
+static blitworker_t blitworkers[MAXBLITTHREADS];
+static boolean      blitworkers_quit;
+static const byte  *blit_source;
+static byte        *blit_dest;      // row blit_top of the locked texture
+static int          blit_pitch;
+static int          blit_top;
+static uint64_t     blit_time;
+static int          blit_frames;
+static int          blit_skipped;
+
+// [JN] Damage tracking: the screen buffer of the last presented frame.
+// Only rows changed since then are copied to the texture, and frames
+// without any changes are not presented at all.
+
+static boolean      nodamage;
+static boolean      damage_full = true;
+static byte        *damage_prev = NULL;
+static size_t       damage_prev_size;
+static int          damage_state[4];
+
 // display has been set up?
 
 static boolean initialized = false;
@@ -868,11 +907,347 @@ void I_DrawBlackBorders (void)
     SDL_RenderFillRect(renderer, &rectangle_right);
 }
 
+// -----------------------------------------------------------------------------
+// I_UpdatePaletteLUT
+// [JN] Maps the palette to the pixel format of the texture. The format
+// is allocated again if the texture has changed its pixel format since.
+// -----------------------------------------------------------------------------
+
+static void I_UpdatePaletteLUT (void)
+{
+    int i;
+
+    if (palette_lut_format != NULL && palette_lut_format->format != pixel_format)
+    {
+        SDL_FreeFormat(palette_lut_format);
+        palette_lut_format = NULL;
+    }
+
+    if (palette_lut_format == NULL)
+    {
+        palette_lut_format = SDL_AllocFormat(pixel_format);
+
+        if (palette_lut_format == NULL)
+        {
+            return;
+        }
+    }
+
+    for (i = 0 ; i < 256 ; i++)
+    {
+        palette_lut[i] = SDL_MapRGB(palette_lut_format,
+                                    palette[i].r, palette[i].g, palette[i].b);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// I_FindDamage
+// [JN] Finds the range of rows y1 to y2-1 changed since the last presented
+// frame, and remembers them for the next one. Comparing the screen itself
+// catches everything drawn into it, no matter by whom. Returns false if
+// nothing has changed.
+// -----------------------------------------------------------------------------
+
+static boolean I_FindDamage (int *y1, int *y2)
+{
+    const byte *const screen = screenbuffer->pixels;
+    const size_t size = (size_t) screenwidth * SCREENHEIGHT;
+    int top, bottom;
+
+    if (nodamage)
+    {
+        *y1 = 0;
+        *y2 = SCREENHEIGHT;
+        return true;
+    }
+
+    if (damage_prev_size != size)
+    {
+        damage_prev = I_Realloc(damage_prev, size);
+        damage_prev_size = size;
+        damage_full = true;
+    }
+
+    // Whatever is drawn around the texture must be updated as well.
+    if (damage_state[0] != screenblocks || damage_state[1] != aspect_ratio
+    ||  damage_state[2] != smoothing    || damage_state[3] != vga_porch_flash)
+    {
+        damage_state[0] = screenblocks;
+        damage_state[1] = aspect_ratio;
+        damage_state[2] = smoothing;
+        damage_state[3] = vga_porch_flash;
+        damage_full = true;
+    }
+
+    if (damage_full)
+    {
+        top = 0;
+        bottom = SCREENHEIGHT;
+        damage_full = false;
+    }
+    else
+    {
+        for (top = 0 ; top < SCREENHEIGHT ; top++)
+        {
+            if (memcmp(damage_prev + top * screenwidth,
+                       screen + top * screenwidth, screenwidth))
+            {
+                break;
+            }
+        }
+
+        if (top == SCREENHEIGHT)
+        {
+            return false;
+        }
+
+        for (bottom = SCREENHEIGHT ; bottom > top + 1 ; bottom--)
+        {
+            if (memcmp(damage_prev + (bottom - 1) * screenwidth,
+                       screen + (bottom - 1) * screenwidth, screenwidth))
+            {
+                break;
+            }
+        }
+    }
+
+    memcpy(damage_prev + top * screenwidth, screen + top * screenwidth,
+           (size_t) (bottom - top) * screenwidth);
+
+    *y1 = top;
+    *y2 = bottom;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// I_ExpandRows
+// [JN] Expands the rows y1 to y2-1 of the paletted screen buffer
+// into 32-bit pixels of the destination, starting from row blit_top.
+// -----------------------------------------------------------------------------
+
+static void I_ExpandRows (const byte *source, byte *dest, const int pitch,
+                          const int y1, const int y2)
+{
+    const uint32_t *const lut = palette_lut;
+    int y;
+
+    for (y = y1 ; y < y2 ; y++)
+    {
+        const byte *src = source + y * screenwidth;
+        uint32_t   *dst = (uint32_t *) (dest + (y - blit_top) * pitch);
+        int         x = screenwidth;
+
+        // Unrolled, so the table lookups of eight pixels may overlap.
+        for ( ; x >= 8 ; x -= 8, src += 8, dst += 8)
+        {
+            dst[0] = lut[src[0]];
+            dst[1] = lut[src[1]];
+            dst[2] = lut[src[2]];
+            dst[3] = lut[src[3]];
+            dst[4] = lut[src[4]];
+            dst[5] = lut[src[5]];
+            dst[6] = lut[src[6]];
+            dst[7] = lut[src[7]];
+        }
+        while (x--)
+        {
+            *dst++ = lut[*src++];
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// I_BlitWorker
+// [JN] Thread expanding its part of rows every frame.
+// -----------------------------------------------------------------------------
+
+static int SDLCALL I_BlitWorker (void *data)
+{
+    blitworker_t *const worker = data;
+
+    while (1)
+    {
+        SDL_SemWait(worker->start);
+
+        if (blitworkers_quit)
+        {
+            break;
+        }
+
+        I_ExpandRows(blit_source, blit_dest, blit_pitch, worker->y1, worker->y2);
+        SDL_SemPost(worker->done);
+    }
+
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+// I_StartBlitWorkers, I_StopBlitWorkers
+// -----------------------------------------------------------------------------
+
+static void I_StartBlitWorkers (const int count)
+{
+    int i;
+
+    blitworkers_quit = false;
+
+    for (i = 0 ; i < count ; i++)
+    {
+        blitworker_t *const worker = &blitworkers[numblitworkers];
+
+        worker->start = SDL_CreateSemaphore(0);
+        worker->done = SDL_CreateSemaphore(0);
+        worker->thread = worker->start && worker->done ?
+                         SDL_CreateThread(I_BlitWorker, "Blit thread", worker) : NULL;
+
+        if (worker->thread == NULL)
+        {
+            // No thread, expand the rest of rows by ourselves.
+            if (worker->start)
+            {
+                SDL_DestroySemaphore(worker->start);
+            }
+            if (worker->done)
+            {
+                SDL_DestroySemaphore(worker->done);
+            }
+            break;
+        }
+
+        numblitworkers++;
+    }
+}
+
+static void I_StopBlitWorkers (void)
+{
+    int i;
+
+    blitworkers_quit = true;
+
+    for (i = 0 ; i < numblitworkers ; i++)
+    {
+        SDL_SemPost(blitworkers[i].start);
+        SDL_WaitThread(blitworkers[i].thread, NULL);
+        SDL_DestroySemaphore(blitworkers[i].start);
+        SDL_DestroySemaphore(blitworkers[i].done);
+    }
+
+    numblitworkers = 0;
+}
+
+// -----------------------------------------------------------------------------
+// I_BlitToTexture
+// [JN] Writes the rows y1 to y2-1 of the paletted screen buffer directly
+// into the locked streaming texture. Returns false if the texture can't
+// be used this way, so the SDL_BlitSurface path should be taken instead.
+// -----------------------------------------------------------------------------
+
+static boolean I_BlitToTexture (const int y1, const int y2)
+{
+    SDL_Rect rect;
+    void *pixels;
+    int   pitch;
+    int   i, y;
+
+    if (oldblit || palette_lut_format == NULL
+    ||  SDL_ISPIXELFORMAT_FOURCC(pixel_format)
+    ||  SDL_BYTESPERPIXEL(pixel_format) != 4)
+    {
+        return false;
+    }
+
+    rect.x = 0;
+    rect.y = y1;
+    rect.w = screenwidth;
+    rect.h = y2 - y1;
+
+    if (SDL_LockTexture(texture, &rect, &pixels, &pitch) != 0)
+    {
+        return false;
+    }
+
+    blit_source = screenbuffer->pixels;
+    blit_dest = pixels;
+    blit_pitch = pitch;
+    blit_top = y1;
+
+    // Split the rows evenly, the last part is ours.
+    for (i = 0, y = y1 ; i < numblitworkers ; i++)
+    {
+        blitworkers[i].y1 = y;
+        blitworkers[i].y2 = y = y1 + (y2 - y1) * (i + 1) / (numblitworkers + 1);
+        SDL_SemPost(blitworkers[i].start);
+    }
+
+    I_ExpandRows(blit_source, blit_dest, blit_pitch, y, y2);
+
+    for (i = 0 ; i < numblitworkers ; i++)
+    {
+        SDL_SemWait(blitworkers[i].done);
+    }
+
+    SDL_UnlockTexture(texture);
+
+    return true;
+}
+
 //
 // I_FinishUpdate
 //
+// -----------------------------------------------------------------------------
+// I_PresentWaits
+// [JN] True if presenting waits for the display, so presenting a frame
+// with no changes keeps the game paced.
+// -----------------------------------------------------------------------------
+
+static boolean I_PresentWaits (void)
+{
+    SDL_RendererInfo info;
+
+    return SDL_GetRendererInfo(renderer, &info) == 0
+        && (info.flags & SDL_RENDERER_PRESENTVSYNC) != 0;
+}
+
+// -----------------------------------------------------------------------------
+// I_WaitForRefresh
+// [JN] Sleeps until the display would show the next frame, so frames
+// without changes don't make the game spin. Never in -timedemo.
+// -----------------------------------------------------------------------------
+
+static uint64_t refresh_time;  // When the last frame was shown or skipped
+
+static void I_WaitForRefresh (void)
+{
+    SDL_DisplayMode mode;
+    uint64_t interval = 1000000ull / 60;
+    uint64_t elapsed;
+
+    if (singletics)
+    {
+        return;
+    }
+
+    if (SDL_GetWindowDisplayMode(screen, &mode) == 0 && mode.refresh_rate > 0)
+    {
+        interval = 1000000ull / mode.refresh_rate;
+    }
+
+    elapsed = I_GetTimeUS() - refresh_time;
+
+    if (elapsed < interval && interval - elapsed >= 1000)
+    {
+        I_Sleep((interval - elapsed) / 1000);
+    }
+
+    refresh_time = I_GetTimeUS();
+}
+
 void I_FinishUpdate (void)
 {
+    static int fpscount;
+    boolean damaged;
+    int damage_y1, damage_y2;
+
     if (!initialized)
         return;
 
@@ -921,12 +1296,9 @@ void I_FinishUpdate (void)
     if (show_fps)
 	{
 		static int lastmili;
-		static int fpscount;
 		int mili;
 		int i;
 
-		fpscount++;
-
 		i = SDL_GetTicks();
 		mili = i - lastmili;
 
@@ -953,57 +1325,110 @@ void I_FinishUpdate (void)
     if (palette_to_set)
     {
         SDL_SetPaletteColors(screenbuffer->format->palette, palette, 0, 256);
+        I_UpdatePaletteLUT();
         palette_to_set = false;
+        damage_full = true;
     }
-
-    if (vga_porch_flash && aspect_ratio <= 1)
+    else if (palette_lut_format == NULL || palette_lut_format->format != pixel_format)
     {
-        // "flash" the pillars/letterboxes with palette changes, emulating
-        // VGA "porch" behaviour (GitHub issue #832)
-        SDL_SetRenderDrawColor(renderer, palette[0].r, palette[0].g,
-            palette[0].b, SDL_ALPHA_OPAQUE);
+        // [JN] The LUT was packed for another pixel format.
+        I_UpdatePaletteLUT();
+        damage_full = true;
     }
 
-    // Blit from the paletted 8-bit screen buffer to the intermediate
-    // 32-bit RGBA buffer that we can load into the texture.
+    // [JN] Upload only the rows changed. Frames without any changes are
+    // presented only if presenting waits for vsync, otherwise the game
+    // sleeps until the next refresh instead.
 
-    SDL_BlitSurface(screenbuffer, &blit_rect, argbbuffer, &blit_rect);
+    damaged = I_FindDamage(&damage_y1, &damage_y2);
 
-    // Update the intermediate texture with the contents of the RGBA buffer.
+    if (damaged)
+    {
+        if (vga_porch_flash && aspect_ratio <= 1)
+        {
+            // "flash" the pillars/letterboxes with palette changes, emulating
+            // VGA "porch" behaviour (GitHub issue #832)
+            SDL_SetRenderDrawColor(renderer, palette[0].r, palette[0].g,
+                palette[0].b, SDL_ALPHA_OPAQUE);
+        }
 
-    SDL_UpdateTexture(texture, NULL, argbbuffer->pixels, argbbuffer->pitch);
+        {
+            const uint64_t blit_start = blitstats ? I_GetTimeUS() : 0;
 
-    // Make sure the pillarboxes are kept clear each frame.
+            // [JN] Expand the paletted 8-bit screen buffer right into the texture.
 
-    SDL_RenderClear(renderer);
+            if (!I_BlitToTexture(damage_y1, damage_y2))
+            {
+                SDL_Rect rect;
 
-    if (smoothing)
-    {
-    // Render this intermediate texture into the upscaled texture
-    // using "nearest" integer scaling.
+                rect.x = 0;
+                rect.y = damage_y1;
+                rect.w = screenwidth;
+                rect.h = damage_y2 - damage_y1;
+
+                // Blit from the paletted 8-bit screen buffer to the intermediate
+                // 32-bit RGBA buffer that we can load into the texture.
+
+                SDL_BlitSurface(screenbuffer, &rect, argbbuffer, &rect);
 
-    SDL_SetRenderTarget(renderer, texture_upscaled);
-    SDL_RenderCopy(renderer, texture, NULL, NULL);
+                // Update the intermediate texture with the contents of the RGBA buffer.
 
-    // Finally, render this upscaled texture to screen using linear scaling.
+                SDL_UpdateTexture(texture, &rect, (byte *) argbbuffer->pixels
+                                  + damage_y1 * argbbuffer->pitch, argbbuffer->pitch);
+            }
 
-    SDL_SetRenderTarget(renderer, NULL);
-    SDL_RenderCopy(renderer, texture_upscaled, NULL, NULL);
+            if (blitstats)
+            {
+                blit_time += I_GetTimeUS() - blit_start;
+                blit_frames++;
+            }
+        }
     }
-    else
+    else if (blitstats)
     {
-    SDL_SetRenderTarget(renderer, NULL);
-    SDL_RenderCopy(renderer, texture, NULL, NULL);
+        blit_skipped++;
     }
 
-    if (aspect_ratio >= 2 && screenblocks == 9)
+    if (damaged || I_PresentWaits())
     {
-        I_DrawBlackBorders();
-    }
+        // Make sure the pillarboxes are kept clear each frame.
 
-    // Draw!
+        SDL_RenderClear(renderer);
 
-    SDL_RenderPresent(renderer);
+        if (smoothing)
+        {
+        // Render this intermediate texture into the upscaled texture
+        // using "nearest" integer scaling.
+
+        SDL_SetRenderTarget(renderer, texture_upscaled);
+        SDL_RenderCopy(renderer, texture, NULL, NULL);
+
+        // Finally, render this upscaled texture to screen using linear scaling.
+
+        SDL_SetRenderTarget(renderer, NULL);
+        SDL_RenderCopy(renderer, texture_upscaled, NULL, NULL);
+        }
+        else
+        {
+        SDL_SetRenderTarget(renderer, NULL);
+        SDL_RenderCopy(renderer, texture, NULL, NULL);
+        }
+
+        if (aspect_ratio >= 2 && screenblocks == 9)
+        {
+            I_DrawBlackBorders();
+        }
+
+        // Draw!
+
+        SDL_RenderPresent(renderer);
+        refresh_time = I_GetTimeUS();
+        fpscount++;
+    }
+    else
+    {
+        I_WaitForRefresh();
+    }
 
     if (uncapped_fps && !singletics)
     {
@@ -1099,33 +1524,13 @@ void I_SetPalette (const byte *doompalette)
 }
 
 // Given an RGB value, find the closest matching palette index.
+// [JN] Only a few lookups per frame are made against a palette which
+// changes with every flash, so search it directly instead of building
+// the V_GetPaletteIndex lookup grid for it.
 
 const int I_GetPaletteIndex (const int r, const int g, const int b)
 {
-    int best, best_diff, diff;
-    int i;
-
-    best = 0; best_diff = INT_MAX;
-
-    for (i = 0; i < 256; ++i)
-    {
-        diff = (r - palette[i].r) * (r - palette[i].r)
-             + (g - palette[i].g) * (g - palette[i].g)
-             + (b - palette[i].b) * (b - palette[i].b);
-
-        if (diff < best_diff)
-        {
-            best = i;
-            best_diff = diff;
-        }
-
-        if (diff == 0)
-        {
-            break;
-        }
-    }
-
-    return best;
+    return V_NearestColor(&palette[0].r, sizeof(*palette), r, g, b);
 }
 
 // 
@@ -1199,6 +1604,46 @@ void I_GraphicsCheckCommandLine(void)
 
     nograbmouse_override = M_ParmExists("-nograbmouse");
 
+    //!
+    // @category video
+    //
+    // Copy the screen to the texture through an intermediate RGBA
+    // surface by SDL_BlitSurface, instead of writing it directly.
+    //
+
+    oldblit = M_ParmExists("-oldblit");
+
+    //!
+    // @category video
+    // @arg <n>
+    //
+    // Use n additional threads to copy the screen to the texture.
+    //
+
+    i = M_CheckParmWithArgs("-blitthreads", 1);
+
+    if (i > 0)
+    {
+        I_StartBlitWorkers(BETWEEN(0, MAXBLITTHREADS, atoi(myargv[i + 1])));
+    }
+
+    //!
+    // @category video
+    //
+    // Print the average time of copying the screen to the texture at exit.
+    //
+
+    blitstats = M_ParmExists("-blitstats");
+
+    //!
+    // @category video
+    //
+    // Copy and present the whole screen every frame,
+    // even if nothing has changed on it.
+    //
+
+    nodamage = M_ParmExists("-nodamage");
+
     // default to fullscreen mode, allow override with command line
     // nofullscreen because we love prboom
 
@@ -1803,6 +2248,9 @@ void I_ReInitGraphics (const int reinit)
 
 		// [crispy] force its re-creation
 		CreateUpscaledTexture(true);
+
+		// [JN] The new texture is empty, upload the whole screen.
+		damage_full = true;
 	}
 
 	// [crispy] re-set logical rendering resolution
@@ -1857,6 +2305,27 @@ void I_ShutdownGraphics(void)
 
         initialized = false;
     }
+
+    if (blitstats && blit_frames)
+    {
+        printf(english_language ?
+               "I_ShutdownGraphics: %d frames, %s blit, average %d us, %d unchanged frames skipped\n" :
+               "I_ShutdownGraphics: %d кадров, %s, в среднем %d мкс, пропущено неизменных кадров: %d\n",
+               blit_frames, oldblit ? "SDL_BlitSurface" : "LUT",
+               (int) (blit_time / blit_frames), blit_skipped);
+    }
+
+    I_StopBlitWorkers();
+
+    free(damage_prev);
+    damage_prev = NULL;
+    damage_prev_size = 0;
+
+    if (palette_lut_format != NULL)
+    {
+        SDL_FreeFormat(palette_lut_format);
+        palette_lut_format = NULL;
+    }
 }
 
 void I_RenderReadPixels(byte **data, int *w, int *h)
@@ -0,0 +1,318 @@
+//
+// Copyright(C) 2016-2023 Julian Nechaevsky
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// DESCRIPTION:
+//	Profiling of action functions and thinkers, shared by the games.
+//
+//	Calls are timed by M_PROFCALL and summed up per function and per
+//	mobj type. Times are inclusive: a thinker's time holds the time of
+//	the actions it has called. At the end of every level the sums are
+//	printed, sorted by total time, and optionally written to a CSV file
+//	to be sorted by any other column.
+//
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "i_system.h"
+#include "i_timer.h"
+#include "m_argv.h"
+#include "m_misc.h"
+#include "m_prof.h"
+#include "jn.h"
+
+
+#define PROF_TOPCOUNT 20  // Lines printed for every level.
+
+typedef struct
+{
+    proffunc_t func;
+    int        kind, type;
+    int        calls;
+    uint64_t   ticks;
+} profentry_t;
+
+boolean profiling;
+
+static const profname_t *profnames;
+static profentry_t      *profentries;  // Open addressing, by function and type.
+static int               numprofentries, maxprofentries;
+static char              proflevel[9];
+static FILE             *proffile;
+
+static const char *const profkinds[NUMPROFKINDS] = {
+    "action", "weapon", "thinker"
+};
+
+// -----------------------------------------------------------------------------
+// M_ProfSlot
+// Returns the entry of the function and type, or the empty one to put it in.
+// -----------------------------------------------------------------------------
+
+static profentry_t *M_ProfSlot (profentry_t *entries, const int max,
+                                const profkind_t kind, const proffunc_t func,
+                                const int type)
+{
+    unsigned int i = ((unsigned int) ((uintptr_t) func >> 2) * 31 + type * 7 + kind)
+                   & (max - 1);
+
+    while (entries[i].func
+    &&    (entries[i].func != func || entries[i].type != type || entries[i].kind != kind))
+    {
+        i = (i + 1) & (max - 1);
+    }
+
+    return &entries[i];
+}
+
+// -----------------------------------------------------------------------------
+// M_ProfStart, M_ProfStop
+// -----------------------------------------------------------------------------
+
+uint64_t M_ProfStart (void)
+{
+    return I_GetPerfCounter();
+}
+
+void M_ProfStop (const profkind_t kind, const proffunc_t func, const int type,
+                 const uint64_t start)
+{
+    const uint64_t ticks = I_GetPerfCounter() - start;
+    profentry_t *entry;
+
+    // Keep the table at most half full.
+    if (numprofentries * 2 >= maxprofentries)
+    {
+        const int max = maxprofentries ? maxprofentries * 2 : 256;
+        profentry_t *entries = calloc(max, sizeof(*entries));
+        int i;
+
+        if (entries == NULL)
+        {
+            I_Error(english_language ?
+                    "M_ProfStop: failed on allocation of %i bytes" :
+                    "M_ProfStop: ошибка выделения %i байт",
+                    max * (int) sizeof(*entries));
+        }
+
+        for (i = 0 ; i < maxprofentries ; i++)
+        {
+            if (profentries[i].func)
+            {
+                *M_ProfSlot(entries, max, profentries[i].kind,
+                            profentries[i].func, profentries[i].type) = profentries[i];
+            }
+        }
+
+        free(profentries);
+        profentries = entries;
+        maxprofentries = max;
+    }
+
+    entry = M_ProfSlot(profentries, maxprofentries, kind, func, type);
+
+    if (!entry->func)
+    {
+        entry->func = func;
+        entry->kind = kind;
+        entry->type = type;
+        numprofentries++;
+    }
+
+    entry->calls++;
+    entry->ticks += ticks;
+}
+
+// -----------------------------------------------------------------------------
+// M_ProfName
+// -----------------------------------------------------------------------------
+
+static const char *M_ProfName (const proffunc_t func)
+{
+    static char buf[32];
+    const profname_t *name;
+
+    for (name = profnames ; name && name->func ; name++)
+    {
+        if (name->func == func)
+        {
+            return name->name;
+        }
+    }
+
+    M_snprintf(buf, sizeof(buf), "%p", (void *) (uintptr_t) func);
+    return buf;
+}
+
+// -----------------------------------------------------------------------------
+// M_ProfCompare
+// By total time, most first.
+// -----------------------------------------------------------------------------
+
+static int M_ProfCompare (const void *a, const void *b)
+{
+    const profentry_t *const ea = a;
+    const profentry_t *const eb = b;
+
+    return ea->ticks < eb->ticks ? 1 : ea->ticks > eb->ticks ? -1 : 0;
+}
+
+// -----------------------------------------------------------------------------
+// M_ProfReport
+// Prints the sums of the level and clears them.
+// -----------------------------------------------------------------------------
+
+static void M_ProfReport (void)
+{
+    const double usec = 1000000.0 / I_GetPerfFrequency();
+    uint64_t total[NUMPROFKINDS] = { 0 };
+    int i, j;
+
+    if (!numprofentries)
+    {
+        return;
+    }
+
+    // Pack the entries and sort them.
+    for (i = 0, j = 0 ; i < maxprofentries ; i++)
+    {
+        if (profentries[i].func)
+        {
+            profentries[j++] = profentries[i];
+            total[profentries[i].kind] += profentries[i].ticks;
+        }
+    }
+
+    qsort(profentries, numprofentries, sizeof(*profentries), M_ProfCompare);
+
+    printf(english_language ?
+           "M_ProfReport: %s: actions %.1f ms, weapons %.1f ms, thinkers %.1f ms.\n" :
+           "M_ProfReport: %s: действия %.1f мс, оружие %.1f мс, мыслители %.1f мс.\n",
+           proflevel, total[PROF_ACTION] * usec / 1000,
+           total[PROF_WEAPON] * usec / 1000, total[PROF_THINKER] * usec / 1000);
+    printf("  %-8s %-24s %5s %10s %12s %10s\n",
+           "kind", "function", "type", "calls", "total us", "avg ns");
+
+    for (i = 0 ; i < numprofentries && i < PROF_TOPCOUNT ; i++)
+    {
+        const profentry_t *const entry = &profentries[i];
+
+        printf("  %-8s %-24s %5d %10d %12.0f %10.0f\n",
+               profkinds[entry->kind], M_ProfName(entry->func), entry->type,
+               entry->calls, entry->ticks * usec, entry->ticks * usec * 1000 / entry->calls);
+    }
+
+    if (proffile)
+    {
+        for (i = 0 ; i < numprofentries ; i++)
+        {
+            const profentry_t *const entry = &profentries[i];
+
+            fprintf(proffile, "%s,%s,%s,%d,%d,%.3f\n",
+                    proflevel, profkinds[entry->kind], M_ProfName(entry->func),
+                    entry->type, entry->calls, entry->ticks * usec);
+        }
+
+        fflush(proffile);
+    }
+
+    memset(profentries, 0, maxprofentries * sizeof(*profentries));
+    numprofentries = 0;
+}
+
+// -----------------------------------------------------------------------------
+// M_ProfLevel
+// Called by P_SetupLevel. Reports the previous level, if any.
+// -----------------------------------------------------------------------------
+
+void M_ProfLevel (const char *levelname)
+{
+    if (!profiling)
+    {
+        return;
+    }
+
+    M_ProfReport();
+    M_StringCopy(proflevel, levelname, sizeof(proflevel));
+}
+
+// -----------------------------------------------------------------------------
+// M_ProfQuit
+// -----------------------------------------------------------------------------
+
+static void M_ProfQuit (void)
+{
+    M_ProfReport();
+
+    if (proffile)
+    {
+        fclose(proffile);
+        proffile = NULL;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// M_ProfInit
+// Called by P_Init with the names of the game's functions.
+// -----------------------------------------------------------------------------
+
+void M_ProfInit (const profname_t *names)
+{
+    int p;
+
+    profnames = names;
+
+    //!
+    // @category game
+    //
+    // Time action functions and thinkers per function and mobj type,
+    // and print the functions taking the most time at the end of every
+    // level. Slows the game down a bit.
+    //
+
+    profiling = M_ParmExists("-profile");
+
+    //!
+    // @category game
+    // @arg <filename>
+    //
+    // Same as -profile, but also write the times of all functions
+    // to the specified CSV file, one line per function and mobj type
+    // of every level.
+    //
+
+    p = M_CheckParmWithArgs("-profilecsv", 1);
+
+    if (p > 0)
+    {
+        proffile = fopen(myargv[p + 1], "w");
+
+        if (!proffile)
+        {
+            printf(english_language ?
+                   "\n M_ProfInit: can't open %s for writing" :
+                   "\n M_ProfInit: невозможно открыть %s для записи", myargv[p + 1]);
+        }
+        else
+        {
+            fprintf(proffile, "level,kind,function,type,calls,total_us\n");
+            profiling = true;
+        }
+    }
+
+    if (profiling)
+    {
+        I_AtExit(M_ProfQuit, true);
+    }
+}
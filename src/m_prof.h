@@ -0,0 +1,68 @@
+//
+// Copyright(C) 2016-2023 Julian Nechaevsky
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// DESCRIPTION:
+//	Profiling of action functions and thinkers, shared by the games.
+//
+
+
+#pragma once
+
+#include <stdint.h>
+#include "doomtype.h"
+
+
+typedef void (*proffunc_t) (void);
+
+typedef enum
+{
+    PROF_ACTION,   // action function of a mobj state
+    PROF_WEAPON,   // action function of a player sprite state
+    PROF_THINKER,  // thinker function
+    NUMPROFKINDS
+} profkind_t;
+
+// Names of the functions of a game, ended by a NULL function.
+typedef struct
+{
+    proffunc_t  func;
+    const char *name;
+} profname_t;
+
+extern boolean profiling;
+
+void M_ProfInit (const profname_t *names);
+void M_ProfLevel (const char *levelname);
+uint64_t M_ProfStart (void);
+void M_ProfStop (const profkind_t kind, const proffunc_t func, const int type,
+                 const uint64_t start);
+
+// Makes the call, adding the time it took to the function and mobj type
+// (-1 for none) if profiling. The function and type are taken before the
+// call, as the call may remove the thinker or mobj.
+#define M_PROFCALL(kind, func, type, call)                                  \
+    do                                                                      \
+    {                                                                       \
+        if (profiling)                                                      \
+        {                                                                   \
+            const proffunc_t proffunc = (proffunc_t) (func);                \
+            const int        proftype = (type);                             \
+            const uint64_t   profstart = M_ProfStart();                     \
+            call;                                                           \
+            M_ProfStop((kind), proffunc, proftype, profstart);              \
+        }                                                                   \
+        else                                                                \
+        {                                                                   \
+            call;                                                           \
+        }                                                                   \
+    } while (0)
@@ -0,0 +1,280 @@
+//
+// Copyright(C) 1993-1996 Id Software, Inc.
+// Copyright(C) 2005-2014 Simon Howard
+// Copyright(C) 2016-2023 Julian Nechaevsky
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// DESCRIPTION:
+//	Column drawer template, shared by the games.
+//
+//	Every inclusion defines one column drawing function. The options
+//	below are known at compile time, so every combination gets its own
+//	inner loop without any branches. Define before including:
+//
+//	COLFUNC    - name of the function.
+//	COLLOW     - 1 for low detail mode, drawing 2x2 blocks.
+//	COLWRAP    - 1 to wrap the texture vertically (walls, killough's
+//	             Tutti-Frutti fix), 0 for sprite posts.
+//	COLBRIGHT  - 1 to choose the colormap by dc_brightmap.
+//	COLTRANS   - 1 to remap colors by dc_translation.
+//	COLBLEND   - optional translucency table to blend with the screen.
+//	COLCLIP    - 1 to skip columns out of screen bounds silently
+//	             instead of I_Error, if RANGECHECK is defined.
+//	COLFUZZ    - optional, makes a fuzz drawer instead, darkening
+//	             the screen by this colormap. Needs fuzzoffset[],
+//	             fuzzpos and FUZZTABLE in the including file, and
+//	             COLFUZZRESET - fuzzpos to start over from.
+//
+//	All of them are undefined at the end of the file.
+//	Used globals: dc_*, ylookup, columnofs, flipviewwidth,
+//	centery, viewheight, screenwidth and screenwidth_low.
+//
+
+#ifndef __R_DRAWCOL__
+#define __R_DRAWCOL__
+
+#define COLSTR2(x) #x
+#define COLSTR(x) COLSTR2(x)
+
+#endif
+
+#ifndef COLLOW
+#define COLLOW 0
+#endif
+#ifndef COLWRAP
+#define COLWRAP 0
+#endif
+#ifndef COLBRIGHT
+#define COLBRIGHT 0
+#endif
+#ifndef COLTRANS
+#define COLTRANS 0
+#endif
+#ifndef COLCLIP
+#define COLCLIP 0
+#endif
+
+// Write one screen pixel of color "c", blended if translucent.
+#ifdef COLBLEND
+#define COLPUT(d, c) (*(d) = COLBLEND[(*(d) << 8) + (c)])
+#else
+#define COLPUT(d, c) (*(d) = (c))
+#endif
+
+// Write one (or 2x2) pixels and step to the next row.
+#if COLLOW
+#ifdef COLBLEND
+#define COLDRAW(c)  { const byte cc = (c);                                   \
+                      COLPUT(dest1, cc); COLPUT(dest2, cc);                  \
+                      COLPUT(dest3, cc); COLPUT(dest4, cc);                  \
+                      dest1 += pitch; dest2 += pitch;                        \
+                      dest3 += pitch; dest4 += pitch; }
+#else
+#define COLDRAW(c)  { *dest4 = *dest3 = *dest2 = *dest1 = (c);              \
+                      dest1 += pitch; dest2 += pitch;                        \
+                      dest3 += pitch; dest4 += pitch; }
+#endif
+#else
+#define COLDRAW(c)  { COLPUT(dest1, (c)); dest1 += pitch; }
+#endif
+
+// Color of the texel "i" of the source column.
+#if COLTRANS
+#define COLSRC(i)   translation[source[(i)]]
+#else
+#define COLSRC(i)   source[(i)]
+#endif
+#if COLBRIGHT
+#define COLTEXEL(i) { const byte src = COLSRC(i);                            \
+                      COLDRAW(colormap[brightmap[src]][src]); }
+#else
+#define COLTEXEL(i) COLDRAW(colormap[0][COLSRC(i)])
+#endif
+
+void COLFUNC (void)
+{
+#if COLLOW
+    const int x = dc_x << 1;
+    const int pitch = screenwidth_low;
+    byte *dest1, *dest2, *dest3, *dest4;
+#else
+    const int x = dc_x;
+    const int pitch = screenwidth;
+    byte *dest1;
+#endif
+    int count;
+
+#ifdef COLFUZZ
+    const lighttable_t *const fuzzmap = COLFUZZ;
+    boolean cutoff = false;
+
+    // Adjust borders. Low...
+    if (!dc_yl)
+    {
+        dc_yl = 1;
+    }
+
+    // .. and high.
+    if (dc_yh == viewheight-1)
+    {
+        dc_yh = viewheight-2;
+        cutoff = true;
+    }
+#else
+    const byte *source = dc_source;
+#if COLTRANS
+    const byte *translation = dc_translation;
+#endif
+#if COLBRIGHT
+    const byte *brightmap = dc_brightmap;
+#endif
+    const lighttable_t *const *colormap = dc_colormap;
+    fixed_t frac, fracstep;
+#endif
+
+    count = dc_yh - dc_yl;
+
+    // Zero length, column does not exceed a pixel.
+    if (count < 0)
+    {
+        return;
+    }
+
+#ifdef RANGECHECK
+    if ((unsigned)x >= screenwidth || dc_yl < 0 || dc_yh >= SCREENHEIGHT)
+    {
+#if COLCLIP
+        return;
+#else
+        I_Error (english_language ?
+                 COLSTR(COLFUNC) ": %i to %i at %i" :
+                 COLSTR(COLFUNC) ": %i к %i у %i",
+                 dc_yl, dc_yh, dc_x);
+#endif
+    }
+#endif
+
+#if COLLOW
+    dest1 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x]];
+    dest2 = ylookup[(dc_yl << hires)] + columnofs[flipviewwidth[x+1]];
+    dest3 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x]];
+    dest4 = ylookup[(dc_yl << hires) + 1] + columnofs[flipviewwidth[x+1]];
+#else
+    dest1 = ylookup[dc_yl] + columnofs[flipviewwidth[x]];
+#endif
+
+#ifdef COLFUZZ
+
+    // Looks like an attempt at dithering, using the given colormap.
+    // Lookup framebuffer, and retrieve a pixel that is either
+    // one column left or right of the current one.
+    do
+    {
+#if COLLOW
+        *dest3 = *dest1 = fuzzmap[dest1[screenwidth*fuzzoffset[fuzzpos]]];
+        *dest4 = *dest2 = fuzzmap[dest2[screenwidth*fuzzoffset[fuzzpos]]];
+        dest3 += pitch;
+        dest4 += pitch;
+        dest2 += pitch;
+#else
+        *dest1 = fuzzmap[dest1[screenwidth*fuzzoffset[fuzzpos]]];
+#endif
+        dest1 += pitch;
+
+        // Clamp table lookup index.
+        if (++fuzzpos == FUZZTABLE)
+        {
+            fuzzpos = COLFUZZRESET;
+        }
+    } while (count--);
+
+    // [crispy] if the line at the bottom had to be cut off,
+    // draw one extra line using only pixels of that line and the one above
+    if (cutoff)
+    {
+        const int ofs = (screenwidth*fuzzoffset[fuzzpos]-screenwidth)/2;
+
+#if COLLOW
+        *dest3 = *dest1 = fuzzmap[dest1[ofs]];
+        *dest4 = *dest2 = fuzzmap[dest2[ofs]];
+#else
+        *dest1 = fuzzmap[dest1[ofs]];
+#endif
+    }
+
+#else
+
+    fracstep = dc_iscale;
+    frac = dc_texturemid + (dc_yl-centery)*fracstep;
+
+    // Inner loop that does the actual texture mapping, e.g. a DDA-lile scaling.
+    // This is as fast as it gets.
+#if COLWRAP
+    {
+        int heightmask = dc_texheight-1;
+
+        if (dc_texheight & heightmask)  // not a power of 2 -- killough
+        {
+            heightmask++;
+            heightmask <<= FRACBITS;
+
+            if (frac < 0)
+                while ((frac += heightmask) < 0);
+            else
+                while (frac >= heightmask)
+                    frac -= heightmask;
+
+            do
+            {
+                // [JN] heightmask is the Tutti-Frutti fix -- killough
+                COLTEXEL(frac>>FRACBITS);
+
+                if ((frac += fracstep) >= heightmask)
+                {
+                    frac -= heightmask;
+                }
+            } while (count--);
+        }
+        else  // texture height is a power of 2 -- killough
+        {
+            do
+            {
+                COLTEXEL((frac>>FRACBITS)&heightmask);
+                frac += fracstep;
+            } while (count--);
+        }
+    }
+#else
+    do
+    {
+        COLTEXEL(frac>>FRACBITS);
+        frac += fracstep;
+    } while (count--);
+#endif
+
+#endif
+}
+
+#undef COLTEXEL
+#undef COLSRC
+#undef COLDRAW
+#undef COLPUT
+
+#undef COLFUNC
+#undef COLLOW
+#undef COLWRAP
+#undef COLBRIGHT
+#undef COLTRANS
+#undef COLBLEND
+#undef COLCLIP
+#undef COLFUZZ
+#undef COLFUZZRESET
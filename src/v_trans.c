@@ -16,7 +16,15 @@
 
 
 #include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "d_name.h"
+#include "i_system.h"
+#include "m_config.h"
+#include "m_misc.h"
+#include "rd_io.h"
+#include "sha1.h"
 #include "v_trans.h"
 
 
@@ -729,16 +737,148 @@ static void rgb_to_hsv(vect *rgb, vect *hsv)
 }
 
  
+// -----------------------------------------------------------------------------
+// V_NearestColor
 // [crispy] copied over from i_video.c
-int V_GetPaletteIndex(byte *palette, int r, int g, int b)
+// [JN] Brute force search over all 256 colors, entries are "stride"
+// bytes apart. Of equally near colors, the lowest index is returned.
+// -----------------------------------------------------------------------------
+
+int V_NearestColor (const byte *palette, const int stride, const int r, const int g, const int b)
 {
     int best, best_diff, diff;
     int i;
 
     best = 0; best_diff = INT_MAX;
 
-    for (i = 0; i < 256; ++i)
+    for (i = 0; i < 256; ++i, palette += stride)
+    {
+        diff = (r - palette[0]) * (r - palette[0])
+             + (g - palette[1]) * (g - palette[1])
+             + (b - palette[2]) * (b - palette[2]);
+
+        if (diff < best_diff)
+        {
+            best = i;
+            best_diff = diff;
+        }
+
+        if (diff == 0)
+        {
+            break;
+        }
+    }
+
+    return best;
+}
+
+// -----------------------------------------------------------------------------
+// [JN] Nearest color lookup grid. The RGB cube is split into 16x16x16
+// cells, each holding the palette colors which may be the nearest one
+// to some point of the cell: those not farther from the cell than the
+// farthest point of the cell is from some other color. Candidates are
+// kept in palette order, so a lookup returns exactly what V_NearestColor
+// would, while checking 5-10 colors instead of 256.
+// -----------------------------------------------------------------------------
+
+#define PALGRID_BITS  4
+#define PALGRID_SIZE  (1 << PALGRID_BITS)
+#define PALGRID_SHIFT (8 - PALGRID_BITS)
+#define PALGRID_CELLS (PALGRID_SIZE * PALGRID_SIZE * PALGRID_SIZE)
+
+static byte  palgrid_palette[768]; // palette the grid was built for
+static int   palgrid_start[PALGRID_CELLS + 1];
+static byte *palgrid_colors;
+static int   palgrid_colors_max;
+static boolean palgrid_valid;
+
+// Squared distance from color component c to the range [lo, hi],
+// and the squared distance to the farther end of it.
+static int PalGridAxis (const int c, const int lo, const int hi, int *far)
+{
+    const int dlo = c - lo;
+    const int dhi = c - hi;
+    const int dist = c < lo ? lo - c : c > hi ? c - hi : 0;
+
+    *far = dlo * dlo > dhi * dhi ? dlo * dlo : dhi * dhi;
+    return dist * dist;
+}
+
+static void V_BuildPaletteGrid (const byte *palette)
+{
+    int mindist[256];
+    int cell, i, n = 0;
+
+    memcpy(palgrid_palette, palette, sizeof(palgrid_palette));
+
+    for (cell = 0 ; cell < PALGRID_CELLS ; cell++)
+    {
+        const int r0 = (cell >> (2 * PALGRID_BITS)) << PALGRID_SHIFT;
+        const int g0 = ((cell >> PALGRID_BITS) & (PALGRID_SIZE - 1)) << PALGRID_SHIFT;
+        const int b0 = (cell & (PALGRID_SIZE - 1)) << PALGRID_SHIFT;
+        const int span = (1 << PALGRID_SHIFT) - 1;
+        int bound = INT_MAX;
+
+        for (i = 0 ; i < 256 ; i++)
+        {
+            int fr, fg, fb;
+
+            mindist[i] = PalGridAxis(palette[3 * i + 0], r0, r0 + span, &fr)
+                    + PalGridAxis(palette[3 * i + 1], g0, g0 + span, &fg)
+                    + PalGridAxis(palette[3 * i + 2], b0, b0 + span, &fb);
+
+            if (fr + fg + fb < bound)
+            {
+                bound = fr + fg + fb;
+            }
+        }
+
+        if (n + 256 > palgrid_colors_max)
+        {
+            palgrid_colors_max = palgrid_colors_max ? palgrid_colors_max * 2 : 8192;
+            palgrid_colors = I_Realloc(palgrid_colors, palgrid_colors_max);
+        }
+
+        palgrid_start[cell] = n;
+
+        for (i = 0 ; i < 256 ; i++)
+        {
+            if (mindist[i] <= bound)
+            {
+                palgrid_colors[n++] = i;
+            }
+        }
+    }
+
+    palgrid_start[PALGRID_CELLS] = n;
+    palgrid_valid = true;
+}
+
+// -----------------------------------------------------------------------------
+// V_GetPaletteIndex
+// [JN] Finds the nearest palette color through the lookup grid,
+// which is rebuilt whenever a different palette is given.
+// -----------------------------------------------------------------------------
+
+int V_GetPaletteIndex (byte *palette, int r, int g, int b)
+{
+    int best, best_diff, diff;
+    int cell, i, k;
+
+    if (!palgrid_valid || memcmp(palette, palgrid_palette, sizeof(palgrid_palette)))
+    {
+        V_BuildPaletteGrid(palette);
+    }
+
+    cell = ((r >> PALGRID_SHIFT) << (2 * PALGRID_BITS))
+         | ((g >> PALGRID_SHIFT) << PALGRID_BITS)
+         |  (b >> PALGRID_SHIFT);
+
+    best = 0; best_diff = INT_MAX;
+
+    for (k = palgrid_start[cell] ; k < palgrid_start[cell + 1] ; k++)
     {
+        i = palgrid_colors[k];
         diff = (r - palette[3 * i + 0]) * (r - palette[3 * i + 0])
              + (g - palette[3 * i + 1]) * (g - palette[3 * i + 1])
              + (b - palette[3 * i + 2]) * (b - palette[3 * i + 2]);
@@ -758,6 +898,116 @@ int V_GetPaletteIndex(byte *palette, int r, int g, int b)
     return best;
 }
 
+// -----------------------------------------------------------------------------
+// V_LoadTransMaps, V_SaveTransMaps
+// [JN] Translucency tables generated for a modified PLAYPAL are kept
+// in the config directory, keyed by the SHA-1 of the palette, so they
+// are only generated once for each palette.
+// -----------------------------------------------------------------------------
+
+#define TRANSCACHE_NAME  "transmaps.dat"
+#define TRANSCACHE_MAGIC "INTRTRAN"
+
+static void V_TransMapsKey (const byte *playpal, const int numtables, byte *key)
+{
+    sha1_context_t context;
+
+    SHA1_Init(&context);
+    SHA1_Update(&context, (byte *) playpal, 768);
+    SHA1_UpdateInt32(&context, numtables);
+    SHA1_Final(key, &context);
+}
+
+boolean V_LoadTransMaps (const byte *playpal, byte **tables, const int numtables)
+{
+    char magic[sizeof(TRANSCACHE_MAGIC) - 1];
+    sha1_digest_t key, filekey;
+    char *filename;
+    FILE *handle;
+    boolean result = false;
+    int i;
+
+    filename = M_StringJoin(configdir, TRANSCACHE_NAME, NULL);
+    handle = fopen(filename, "rb");
+    free(filename);
+
+    if (handle == NULL)
+    {
+        return false;
+    }
+
+    V_TransMapsKey(playpal, numtables, key);
+
+    if (M_FileLength(handle) == sizeof(magic) + sizeof(key) + numtables * 256 * 256
+    &&  fread(magic, 1, sizeof(magic), handle) == sizeof(magic)
+    &&  fread(filekey, 1, sizeof(filekey), handle) == sizeof(filekey)
+    &&  !memcmp(magic, TRANSCACHE_MAGIC, sizeof(magic))
+    &&  !memcmp(filekey, key, sizeof(key)))
+    {
+        result = true;
+
+        for (i = 0 ; i < numtables ; i++)
+        {
+            if (fread(tables[i], 1, 256 * 256, handle) != 256 * 256)
+            {
+                result = false;
+                break;
+            }
+        }
+    }
+
+    fclose(handle);
+    return result;
+}
+
+void V_SaveTransMaps (const byte *playpal, byte **tables, const int numtables)
+{
+    sha1_digest_t key;
+    char *filename, *tempname;
+    FILE *handle;
+    boolean result;
+    int i;
+
+    // Write to a temporary file first, so a crash or a full disk
+    // never leaves a truncated cache in place of a good one.
+    filename = M_StringJoin(configdir, TRANSCACHE_NAME, NULL);
+    tempname = M_StringJoin(filename, ".tmp", NULL);
+    handle = fopen(tempname, "wb");
+
+    if (handle == NULL)
+    {
+        free(tempname);
+        free(filename);
+        return;
+    }
+
+    V_TransMapsKey(playpal, numtables, key);
+
+    result = fwrite(TRANSCACHE_MAGIC, 1, sizeof(TRANSCACHE_MAGIC) - 1, handle)
+                 == sizeof(TRANSCACHE_MAGIC) - 1
+          && fwrite(key, 1, sizeof(key), handle) == sizeof(key);
+
+    for (i = 0 ; i < numtables && result ; i++)
+    {
+        result = fwrite(tables[i], 1, 256 * 256, handle) == 256 * 256;
+    }
+
+    result &= fclose(handle) == 0;
+
+    if (result)
+    {
+        remove(filename);
+        rename(tempname, filename);
+    }
+    else
+    {
+        remove(tempname);
+    }
+
+    free(tempname);
+    free(filename);
+}
+
 byte V_Colorize (byte *playpal, Translation_CR_t cr, byte source, boolean keepgray109)
 {
     vect rgb, hsv;
@@ -113,5 +113,8 @@ extern char **crstr;
 
 #define cr_esc '~'
 
+int V_NearestColor (const byte *palette, const int stride, const int r, const int g, const int b);
 int V_GetPaletteIndex(byte *palette, int r, int g, int b);
+boolean V_LoadTransMaps (const byte *playpal, byte **tables, const int numtables);
+void V_SaveTransMaps (const byte *playpal, byte **tables, const int numtables);
 byte V_Colorize (byte *playpal, Translation_CR_t cr, byte source, boolean keepgray109);